@@ -0,0 +1,414 @@
+/*******************************************************************************
+* File Name: AdaptiveThreshold.c
+*
+* Version 1.0
+*
+* Description: This file contains the idle noise estimator and the adaptive
+*               finger threshold, noise threshold and hysteresis logic.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "AdaptiveThreshold.h"
+#include "Gesture.h"
+#include "Platform.h"
+#include "Log.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Largest deviation from the mean accepted in the variance, with
+ * ADAPT_NOISE_FRAC_BITS fractional bits. Keeps the square within 32 bits.
+ */
+#define ADAPT_MAX_DEVIATION				(1023 << ADAPT_NOISE_FRAC_BITS)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Widget index of each sensor. The five buttons are the first five sensors of 
+ * the component, followed by the eight segments of the radial slider.
+ */
+static const uint8 widgetOfSensor[CapSense_TOTAL_SENSOR_COUNT] =
+{
+	CapSense_LEFT__BTN, CapSense_RIGHT__BTN, CapSense_UP__BTN, CapSense_DOWN__BTN, CapSense_CENTRE__BTN,
+	CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS,
+	CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS
+};
+
+/* Running mean of (raw - baseline) with ADAPT_NOISE_FRAC_BITS fractional bits */
+static int32 noiseMean[CapSense_TOTAL_SENSOR_COUNT];
+
+/* Running variance of (raw - baseline) with 2*ADAPT_NOISE_FRAC_BITS fractional
+ * bits 
+ */
+static int32 noiseVariance[CapSense_TOTAL_SENSOR_COUNT];
+
+/* Noise (standard deviation) of each widget, worst sensor of the widget */
+static uint32 widgetNoise[ADAPT_WIDGET_COUNT];
+
+/* Thresholds calculated from the noise estimate */
+static uint8 fingerThreshold[ADAPT_WIDGET_COUNT];
+static uint8 noiseThreshold[ADAPT_WIDGET_COUNT];
+static uint8 hysteresis[ADAPT_WIDGET_COUNT];
+
+/* Thresholds of the CapSense component configuration */
+static uint8 configFingerThreshold[ADAPT_WIDGET_COUNT];
+static uint8 configNoiseThreshold[ADAPT_WIDGET_COUNT];
+static uint8 configHysteresis[ADAPT_WIDGET_COUNT];
+
+static uint32 idleSampleCount;
+static uint32 updateCounter;
+static bool isEstimateValid;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static uint32 AdaptiveThreshold_Sqrt(uint32 value);
+static uint32 AdaptiveThreshold_Limit(uint32 value, uint32 min, uint32 max);
+static void AdaptiveThreshold_Calculate(void);
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_Init
+********************************************************************************
+* Summary:
+*  Clears the noise estimate. The thresholds from the CapSense component
+*  configuration are restored if adapted thresholds were applied, and stay in
+*  use until ADAPT_MIN_IDLE_SAMPLES idle scans have been collected.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdaptiveThreshold_Init(void)
+{
+	uint32 i, widget;
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		noiseMean[i] = 0;
+		noiseVariance[i] = 0;
+	}
+	
+	/* The component holds its configured thresholds until an estimate is applied */
+	for(widget = 0; widget < ADAPT_WIDGET_COUNT; widget++)
+	{
+		if(isEstimateValid)
+		{
+			CapSense_fingerThreshold[widget] = configFingerThreshold[widget];
+			CapSense_noiseThreshold[widget] = configNoiseThreshold[widget];
+			CapSense_hysteresis[widget] = configHysteresis[widget];
+		}
+		else
+		{
+			configFingerThreshold[widget] = CapSense_fingerThreshold[widget];
+			configNoiseThreshold[widget] = CapSense_noiseThreshold[widget];
+			configHysteresis[widget] = CapSense_hysteresis[widget];
+		}
+	}
+	
+	idleSampleCount = 0;
+	updateCounter = 0;
+	isEstimateValid = false;
+}
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_Apply
+********************************************************************************
+* Summary:
+*  Writes the adapted thresholds to the CapSense component. Must be called 
+*  after CapSense_UpdateEnabledBaselines() and before 
+*  CapSense_CheckIsAnyWidgetActive(), so that the component's own threshold 
+*  calculation never takes effect once a valid estimate exists.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdaptiveThreshold_Apply(void)
+{
+	#if(ADAPTIVE_THRESHOLD_ENABLE)
+		uint32 widget;
+		
+		if(isEstimateValid)
+		{
+			for(widget = 0; widget < ADAPT_WIDGET_COUNT; widget++)
+			{
+				CapSense_fingerThreshold[widget] = fingerThreshold[widget];
+				CapSense_noiseThreshold[widget] = noiseThreshold[widget];
+				CapSense_hysteresis[widget] = hysteresis[widget];
+			}
+		}
+	#endif /* #if(ADAPTIVE_THRESHOLD_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_Update
+********************************************************************************
+* Summary:
+*  Updates the running mean and variance of every sensor with the result of the
+*  last scan, provided the scan is idle, and periodically recalculates the
+*  thresholds from the estimate.
+*
+* Parameters:
+*  isAnySensorActive - result of CapSense_CheckIsAnyWidgetActive() for the 
+*                      last scan.
+*
+* Return:
+*  None
+*
+* Theory:
+*  The samples are the raw count minus the baseline, not the signal of the 
+*  component, which is clipped to 0 at the noise threshold and would hide the
+*  noise the thresholds must rise above. A scan is idle when no sensor is on
+*  and every difference is below ADAPT_IDLE_LIMIT_PERCENT of the finger 
+*  threshold, so that a finger arriving before the debounce turns its sensor 
+*  on does not count as noise.
+*  The variance is tracked with an exponentially weighted moving average, which
+*  needs neither a sample buffer nor a divide:
+*   mean     += (x - mean) / 2^ADAPT_ALPHA_SHIFT
+*   variance += ((x - mean)^2 - variance) / 2^ADAPT_ALPHA_SHIFT
+*
+*******************************************************************************/
+void AdaptiveThreshold_Update(uint32 isAnySensorActive)
+{
+	#if(ADAPTIVE_THRESHOLD_ENABLE)
+		uint32 i, isIdle = (isAnySensorActive == 0);
+		int32 difference[CapSense_TOTAL_SENSOR_COUNT];
+		int32 sample, deviation;
+		
+		for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+		{
+			difference[i] = (int32)CapSense_sensorRaw[i] - (int32)CapSense_sensorBaseline[i];
+			
+			if((difference[i] * 100) >= ((int32)CapSense_fingerThreshold[widgetOfSensor[i]] * ADAPT_IDLE_LIMIT_PERCENT))
+			{
+				isIdle = 0;
+			}
+		}
+		
+		/* Only an idle pad tells the noise apart from a finger */
+		if(isIdle)
+		{
+			for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+			{
+				/* Multiplied rather than shifted, a left shift of a negative value is undefined */
+				sample = difference[i] * (1 << ADAPT_NOISE_FRAC_BITS);
+				
+				deviation = sample - noiseMean[i];
+				
+				/* Limit the deviation so that its square cannot overflow */
+				if(deviation > ADAPT_MAX_DEVIATION)
+				{
+					deviation = ADAPT_MAX_DEVIATION;
+				}
+				else if(deviation < -ADAPT_MAX_DEVIATION)
+				{
+					deviation = -ADAPT_MAX_DEVIATION;
+				}
+				
+				noiseMean[i] += deviation >> ADAPT_ALPHA_SHIFT;
+				noiseVariance[i] += ((deviation * deviation) - noiseVariance[i]) >> ADAPT_ALPHA_SHIFT;
+			}
+			
+			if(idleSampleCount < ADAPT_MIN_IDLE_SAMPLES)
+			{
+				idleSampleCount++;
+			}
+			else if(++updateCounter >= ADAPT_UPDATE_PERIOD)
+			{
+				updateCounter = 0;
+				AdaptiveThreshold_Calculate();
+				isEstimateValid = true;
+			}
+		}
+	#endif /* #if(ADAPTIVE_THRESHOLD_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_GetNoise
+********************************************************************************
+* Summary:
+*  Returns the noise estimate of a widget.
+*
+* Parameters:
+*  widget - CapSense widget index.
+*
+* Return:
+*  uint32 - standard deviation of the idle signal of the noisiest sensor of
+*           the widget, with ADAPT_NOISE_FRAC_BITS fractional bits. 0 until 
+*           the first estimate is available.
+*
+*******************************************************************************/
+uint32 AdaptiveThreshold_GetNoise(uint32 widget)
+{
+	return widgetNoise[widget];
+}
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_Calculate
+********************************************************************************
+* Summary:
+*  Calculates the finger threshold, noise threshold and hysteresis of each 
+*  widget from the noise of its noisiest sensor.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AdaptiveThreshold_Calculate(void)
+{
+	uint32 i, widget, noise;
+	
+	for(widget = 0; widget < ADAPT_WIDGET_COUNT; widget++)
+	{
+		widgetNoise[widget] = 0;
+	}
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		noise = AdaptiveThreshold_Sqrt((uint32)noiseVariance[i]);
+		
+		if(noise > widgetNoise[widgetOfSensor[i]])
+		{
+			widgetNoise[widgetOfSensor[i]] = noise;
+		}
+	}
+	
+	for(widget = 0; widget < ADAPT_WIDGET_COUNT; widget++)
+	{
+		/* Round the noise up to whole counts */
+		noise = (widgetNoise[widget] + ((1u << ADAPT_NOISE_FRAC_BITS) - 1u)) >> ADAPT_NOISE_FRAC_BITS;
+		
+		fingerThreshold[widget] = (uint8)AdaptiveThreshold_Limit(ADAPT_FINGER_TH_BASE + (ADAPT_FINGER_SIGMA_GAIN * noise),
+													ADAPT_FINGER_TH_MIN, ADAPT_FINGER_TH_MAX);
+		noiseThreshold[widget] = (uint8)AdaptiveThreshold_Limit(ADAPT_NOISE_SIGMA_GAIN * noise, 
+													ADAPT_NOISE_TH_MIN, ADAPT_NOISE_TH_MAX);
+		hysteresis[widget] = (uint8)AdaptiveThreshold_Limit(ADAPT_HYST_SIGMA_GAIN * noise, 
+													ADAPT_HYST_MIN, ADAPT_HYST_MAX);
+		
+		LOG_CAPSENSE_TRACE(TELEMETRY_EVENT_THRESHOLD, widget | ((uint32)fingerThreshold[widget] << 8));
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_Limit
+********************************************************************************
+* Summary:
+*  Limits a value to the given range.
+*
+* Parameters:
+*  value - value to limit.
+*  min - lower bound of the range.
+*  max - upper bound of the range.
+*
+* Return:
+*  uint32 - limited value
+*
+*******************************************************************************/
+static uint32 AdaptiveThreshold_Limit(uint32 value, uint32 min, uint32 max)
+{
+	if(value < min)
+	{
+		value = min;
+	}
+	else if(value > max)
+	{
+		value = max;
+	}
+	
+	return value;
+}
+
+
+/*******************************************************************************
+* Function Name: AdaptiveThreshold_Sqrt
+********************************************************************************
+* Summary:
+*  Integer square root (bit-by-bit method, no divides).
+*
+* Parameters:
+*  value - input value.
+*
+* Return:
+*  uint32 - floor(sqrt(value))
+*
+*******************************************************************************/
+static uint32 AdaptiveThreshold_Sqrt(uint32 value)
+{
+	uint32 root = 0;
+	uint32 bit = 1uL << 30;
+	
+	while(bit > value)
+	{
+		bit >>= 2;
+	}
+	
+	while(bit != 0)
+	{
+		if(value >= (root + bit))
+		{
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	
+	return root;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/*****************************************************************************
+* File Name		: AdaptiveThreshold.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  AdaptiveThreshold.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ADAPTIVE_THRESHOLD_H		/* Guard to prevent multiple inclusions */
+#define ADAPTIVE_THRESHOLD_H
+
+#include "cytypes.h"
+#include "main.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables run-time adaptation of the CapSense thresholds. When 
+ * disabled, the thresholds from the CapSense component configuration are used.
+ */
+#define ADAPTIVE_THRESHOLD_ENABLE			(ENABLED)
+
+/* Weight of a new idle sample in the running mean and variance, expressed as a
+ * right shift (4 => 1/16). 
+ */
+#define ADAPT_ALPHA_SHIFT					(4)
+
+/* Number of idle scans required before the estimate is trusted and the
+ * thresholds are modified for the first time.
+ */
+#define ADAPT_MIN_IDLE_SAMPLES				(64)
+
+/* Number of idle scans between two recalculations of the thresholds. */
+#define ADAPT_UPDATE_PERIOD					(32)
+
+/* A scan is idle, and sampled for the noise estimate, when no sensor is on 
+ * and the difference count of every sensor stays below this percentage of the
+ * finger threshold of its widget. Noise above the noise threshold is kept in 
+ * the estimate, a finger approaching the pad is not.
+ */
+#define ADAPT_IDLE_LIMIT_PERCENT			(50)
+
+/* The finger threshold is calculated as 
+ * ADAPT_FINGER_TH_BASE + ADAPT_FINGER_SIGMA_GAIN * noise, and limited to the
+ * ADAPT_FINGER_TH_MIN to ADAPT_FINGER_TH_MAX range. With the default values a
+ * noise of 5 counts gives the component default of 200.
+ */
+#define ADAPT_FINGER_TH_BASE				(160)
+#define ADAPT_FINGER_SIGMA_GAIN				(8)
+#define ADAPT_FINGER_TH_MIN					(160)
+#define ADAPT_FINGER_TH_MAX					(215)
+
+/* The noise threshold is calculated as ADAPT_NOISE_SIGMA_GAIN * noise */
+#define ADAPT_NOISE_SIGMA_GAIN				(4)
+#define ADAPT_NOISE_TH_MIN					(20)
+#define ADAPT_NOISE_TH_MAX					(80)
+
+#if(ADAPT_NOISE_TH_MAX >= ADAPT_FINGER_TH_MIN)
+	#error "The noise threshold must stay below the finger threshold"
+#endif
+
+/* The hysteresis is calculated as ADAPT_HYST_SIGMA_GAIN * noise */
+#define ADAPT_HYST_SIGMA_GAIN				(3)
+#define ADAPT_HYST_MIN						(10)
+#define ADAPT_HYST_MAX						(30)
+
+/* Largest signal of the component, the signals have 8 bits. A sensor turns on
+ * at the finger threshold plus the hysteresis, which must leave room below it
+ * for a finger on a noisy pad.
+ */
+#define ADAPT_SIGNAL_MAX					(255)
+
+#if((ADAPT_FINGER_TH_MAX + ADAPT_HYST_MAX) >= ADAPT_SIGNAL_MAX)
+	#error "A sensor turns on at the finger threshold plus the hysteresis, which must stay below the largest signal"
+#endif
+
+/* Number of widgets - the radial slider is the last widget of the component */
+#define ADAPT_WIDGET_COUNT					(CapSense_RADIALSLIDER0__RS + 1)
+
+/* Number of fractional bits used for the noise (standard deviation) values
+ * returned by AdaptiveThreshold_GetNoise().
+ */
+#define ADAPT_NOISE_FRAC_BITS				(4)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void AdaptiveThreshold_Init(void);
+void AdaptiveThreshold_Apply(void);
+void AdaptiveThreshold_Update(uint32 isAnySensorActive);
+uint32 AdaptiveThreshold_GetNoise(uint32 widget);
+
+
+#endif /* #ifndef ADAPTIVE_THRESHOLD_H */
+
+
+/* [] END OF FILE */
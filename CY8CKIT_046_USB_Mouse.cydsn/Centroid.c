@@ -0,0 +1,144 @@
+/*******************************************************************************
+* File Name: Centroid.c
+*
+* Version 1.0
+*
+* Description: This file contains the fixed-point centroid engine of the radial
+*               slider.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Centroid.h"
+#include "Gesture.h"
+#include "Platform.h"
+
+
+/*******************************************************************************
+* Function Name: Centroid_GetRadialPos
+********************************************************************************
+* Summary:
+*  Calculates the position of the finger on the radial slider from the 
+*  difference counts of its segments.
+*
+* Parameters:
+*  confidence - pointer to store the quality of the position (0 to 
+*               CONFIDENCE_MAX). Only written when the slider is touched.
+*
+* Return:
+*  uint32 - position in the range 0 to SLIDER_RESOLUTION, with 
+*           CENTROID_FRAC_BITS fractional bits. CENTROID_INVALID if no 
+*           segment reaches the finger threshold.
+*
+* Theory:
+*  The centroid is calculated over the strongest segment and its two 
+*  neighbours, which wrap around between the last and the first segment:
+*   position = max + (s[max+1] - s[max-1]) / (s[max-1] + s[max] + s[max+1])
+*  Segment n is centred at n * SLIDER_RESOLUTION / RADIAL_SLIDER_SEGMENTS, the
+*  same as in the CapSense component. The noise threshold is subtracted from
+*  every signal first. The confidence is the part of the total slider signal 
+*  which lies in the three segments - a single finger scores close to the
+*  maximum, two fingers or a wet pad score low.
+*
+*******************************************************************************/
+uint32 Centroid_GetRadialPos(uint32 *confidence)
+{
+	#if(CENTROID_ENGINE_ENABLE)
+		uint32 signal[RADIAL_SLIDER_SEGMENTS];
+		uint32 segment, maxSegment = 0, total = 0, local;
+		uint32 noiseThreshold = CapSense_noiseThreshold[CapSense_RADIALSLIDER0__RS];
+		int32 position;
+		
+		for(segment = 0; segment < RADIAL_SLIDER_SEGMENTS; segment++)
+		{
+			signal[segment] = (uint32)GetSignal(SLIDER_ID + segment);
+			
+			if(signal[segment] > signal[maxSegment])
+			{
+				maxSegment = segment;
+			}
+		}
+		
+		if(signal[maxSegment] < CapSense_fingerThreshold[CapSense_RADIALSLIDER0__RS])
+		{
+			return CENTROID_INVALID;
+		}
+		
+		for(segment = 0; segment < RADIAL_SLIDER_SEGMENTS; segment++)
+		{
+			signal[segment] = (signal[segment] > noiseThreshold) ? (signal[segment] - noiseThreshold) : 0;
+			total += signal[segment];
+		}
+		
+		/* Neighbours wrap around - RADIAL_SLIDER_SEGMENTS is a power of 2 */
+		local = signal[(maxSegment - 1u) & (RADIAL_SLIDER_SEGMENTS - 1u)] + signal[maxSegment] + 
+				signal[(maxSegment + 1u) & (RADIAL_SLIDER_SEGMENTS - 1u)];
+		
+		/* The strongest segment is at or above the finger threshold, which is above
+			the noise threshold, so local is never 0 */
+		CYASSERT(local != 0);
+		
+		/* Position in segments, with CENTROID_FRAC_BITS fractional bits. The 
+			difference is signed, so it is scaled with a multiplication. */
+		position = (int32)(maxSegment << CENTROID_FRAC_BITS) + 
+				   ((((int32)signal[(maxSegment + 1u) & (RADIAL_SLIDER_SEGMENTS - 1u)] - 
+				   	  (int32)signal[(maxSegment - 1u) & (RADIAL_SLIDER_SEGMENTS - 1u)]) * (1 << CENTROID_FRAC_BITS)) / (int32)local);
+		
+		if(position < 0)
+		{
+			position += (RADIAL_SLIDER_SEGMENTS << CENTROID_FRAC_BITS);
+		}
+		else if(position >= (RADIAL_SLIDER_SEGMENTS << CENTROID_FRAC_BITS))
+		{
+			position -= (RADIAL_SLIDER_SEGMENTS << CENTROID_FRAC_BITS);
+		}
+		
+		*confidence = (local * CONFIDENCE_MAX) / total;
+		
+		/* Scale from segments to slider resolution */
+		return ((uint32)position * SLIDER_RESOLUTION) / RADIAL_SLIDER_SEGMENTS;
+	#else
+		uint32 position = CapSense_GetRadialCentroidPos(CapSense_RADIALSLIDER0__RS);
+		
+		if(position == 0xFFFFu)
+		{
+			return CENTROID_INVALID;
+		}
+		
+		*confidence = CONFIDENCE_MAX;
+		
+		return position << CENTROID_FRAC_BITS;
+	#endif /* #if(CENTROID_ENGINE_ENABLE) */
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,315 @@
+/*******************************************************************************
+* File Name: FrequencyHop.c
+*
+* Version 1.0
+*
+* Description: This file contains the frequency hopping scan mode, which rotates
+*               the CapSense sense clock and combines the channels per sensor.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "FrequencyHop.h"
+
+
+#if(FREQUENCY_HOP_ENABLE)
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+static const uint8 dividerOffset[] = 
+{
+	FREQ_HOP_DIVIDER_OFFSET_0, 
+	FREQ_HOP_DIVIDER_OFFSET_1, 
+	FREQ_HOP_DIVIDER_OFFSET_2
+};
+
+/* Sense clock divider configured in the CapSense component */
+static uint32 baseDivider;
+
+/* Channel of the scan in progress */
+static uint32 channel;
+
+/* Baseline (4 fractional bits), latest difference count at the gain of the
+ * component baseline and noise (4 fractional bits) of each sensor on each 
+ * channel 
+ */
+static int32 channelBaseline[FREQ_HOP_CHANNELS][CapSense_TOTAL_SENSOR_COUNT];
+static int16 channelDiff[FREQ_HOP_CHANNELS][CapSense_TOTAL_SENSOR_COUNT];
+static uint16 channelNoise[FREQ_HOP_CHANNELS][CapSense_TOTAL_SENSOR_COUNT];
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static int32 FrequencyHop_Combine(uint32 sensor);
+
+#endif /* #if(FREQUENCY_HOP_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: FrequencyHop_Init
+********************************************************************************
+* Summary:
+*  Reads the sense clock divider configured in the CapSense component, scans 
+*  every channel once to initialize its baseline and starts the rotation with
+*  channel 0. Must be called after CapSense_InitializeAllBaselines(), with the
+*  interrupts enabled.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  The raw counts of a channel only compare with the baseline of the same 
+*  channel. Scanning every channel here, rather than initializing each channel
+*  on its first scan in the rotation, gives the first frames of the main loop
+*  the combination of all the channels, so that they do not report the raw 
+*  counts of one channel against the component baseline of another.
+*
+*******************************************************************************/
+void FrequencyHop_Init(void)
+{
+	#if(FREQUENCY_HOP_ENABLE)
+		uint32 i;
+		
+		baseDivider = (uint32)CapSense_SenseClk_GetDividerRegister() + 1u;
+		
+		for(channel = 0; channel < FREQ_HOP_CHANNELS; channel++)
+		{
+			CapSense_SenseClk_SetDividerValue(baseDivider + dividerOffset[channel]);
+			
+			CapSense_ScanEnabledWidgets();
+			while(CapSense_IsBusy() != 0)
+			{
+			}
+			
+			for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+			{
+				channelBaseline[channel][i] = (int32)CapSense_sensorRaw[i] << 4;
+				channelDiff[channel][i] = 0;
+				channelNoise[channel][i] = 0;
+			}
+		}
+		
+		channel = 0;
+		CapSense_SenseClk_SetDividerValue(baseDivider + dividerOffset[channel]);
+	#endif /* #if(FREQUENCY_HOP_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: FrequencyHop_ProcessScan
+********************************************************************************
+* Summary:
+*  Stores the result of the completed scan as the latest sample of its channel
+*  and replaces the raw counts with the combination of all the channels. Must
+*  be called after the scan completes and before 
+*  CapSense_UpdateEnabledBaselines().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  The raw count depends on the sense clock, so every channel keeps its own
+*  baseline. The difference count of a channel is scaled by the ratio of the
+*  component baseline to the channel baseline, which cancels the gain of the
+*  channel, so that the channels compare before they are combined. The
+*  combined difference is added to the component baseline, so that the 
+*  component processes it as if it was a normal scan. One channel is scanned
+*  per frame, which keeps the frame time of a single frequency scan.
+*
+*  The noise of a channel is only updated while the sensor was below the 
+*  noise threshold on the last frame (the component clears the signal below
+*  it), so that a finger moving on the sensor does not count as noise.
+*
+*  The price is latency: the difference count of a channel is only refreshed
+*  every FREQ_HOP_CHANNELS frames, so the combined value includes samples up
+*  to FREQ_HOP_CHANNELS - 1 frames old (2 frames with 3 channels). With 
+*  FREQ_HOP_COMBINE_MEDIAN a finger needs two of the three channels, and is 
+*  reported up to 1 frame later than with a single frequency scan. With 
+*  FREQ_HOP_COMBINE_CLEANEST the cleanest channel may be the oldest, and a 
+*  touch or release is reported up to FREQ_HOP_CHANNELS - 1 frames later.
+*
+*******************************************************************************/
+void FrequencyHop_ProcessScan(void)
+{
+	#if(FREQUENCY_HOP_ENABLE)
+		uint32 i;
+		int32 raw, baseline, diff, gain, scaled, noise;
+		
+		for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+		{
+			raw = (int32)CapSense_sensorRaw[i];
+			baseline = channelBaseline[channel][i] >> 4;
+			diff = raw - baseline;
+			
+			/* Difference count at the gain of the component baseline, rounded */
+			scaled = diff;
+			if(baseline > 0)
+			{
+				gain = (int32)(((uint32)CapSense_sensorBaseline[i] << FREQ_HOP_GAIN_FRAC_BITS) / (uint32)baseline);
+				scaled = ((diff * gain) + (1 << (FREQ_HOP_GAIN_FRAC_BITS - 1))) >> FREQ_HOP_GAIN_FRAC_BITS;
+			}
+			
+			/* Noise is the filtered change of the difference count between two
+			 * scans on the same channel 
+			 */
+			if(CapSense_sensorSignal[i] == 0)
+			{
+				noise = scaled - channelDiff[channel][i];
+				if(noise < 0)
+				{
+					noise = -noise;
+				}
+				channelNoise[channel][i] = (uint16)((int32)channelNoise[channel][i] + 
+					(((noise << 4) - (int32)channelNoise[channel][i]) >> FREQ_HOP_NOISE_SHIFT));
+			}
+			
+			channelDiff[channel][i] = (int16)scaled;
+			
+			/* Track the baseline while no finger is present */
+			if(diff < FREQ_HOP_BASELINE_TRACK_LIMIT)
+			{
+				channelBaseline[channel][i] += ((raw << 4) - channelBaseline[channel][i]) >> FREQ_HOP_BASELINE_SHIFT;
+			}
+		}
+		
+		for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+		{
+			raw = (int32)CapSense_sensorBaseline[i] + FrequencyHop_Combine(i);
+			
+			if(raw < 0)
+			{
+				raw = 0;
+			}
+			else if(raw > 0xFFFF)
+			{
+				raw = 0xFFFF;
+			}
+			
+			CapSense_sensorRaw[i] = (uint16)raw;
+		}
+	#endif /* #if(FREQUENCY_HOP_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: FrequencyHop_NextChannel
+********************************************************************************
+* Summary:
+*  Switches the sense clock to the next channel. Must be called before
+*  CapSense_ScanEnabledWidgets(), while the CapSense block is idle.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void FrequencyHop_NextChannel(void)
+{
+	#if(FREQUENCY_HOP_ENABLE)
+		if(++channel >= FREQ_HOP_CHANNELS)
+		{
+			channel = 0;
+		}
+		
+		CapSense_SenseClk_SetDividerValue(baseDivider + dividerOffset[channel]);
+	#endif /* #if(FREQUENCY_HOP_ENABLE) */
+}
+
+
+#if(FREQUENCY_HOP_ENABLE)
+
+/*******************************************************************************
+* Function Name: FrequencyHop_Combine
+********************************************************************************
+* Summary:
+*  Combines the difference counts of the channels of a sensor.
+*
+* Parameters:
+*  sensor - CapSense sensor index.
+*
+* Return:
+*  int32 - combined difference count
+*
+*******************************************************************************/
+static int32 FrequencyHop_Combine(uint32 sensor)
+{
+	#if(FREQ_HOP_COMBINE_MODE == FREQ_HOP_COMBINE_MEDIAN)
+		int32 a = channelDiff[0][sensor];
+		int32 b = channelDiff[1][sensor];
+		int32 c = channelDiff[2][sensor];
+		int32 temp;
+		
+		/* Median of three */
+		if(a > b)
+		{
+			temp = a;
+			a = b;
+			b = temp;
+		}
+		if(b > c)
+		{
+			b = c;
+		}
+		
+		return (a > b) ? a : b;
+	#else
+		uint32 ch, cleanest = 0;
+		
+		for(ch = 1; ch < FREQ_HOP_CHANNELS; ch++)
+		{
+			if(channelNoise[ch][sensor] < channelNoise[cleanest][sensor])
+			{
+				cleanest = ch;
+			}
+		}
+		
+		return channelDiff[cleanest][sensor];
+	#endif /* #if(FREQ_HOP_COMBINE_MODE == FREQ_HOP_COMBINE_MEDIAN) */
+}
+
+#endif /* #if(FREQUENCY_HOP_ENABLE) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/*****************************************************************************
+* File Name		: FrequencyHop.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  FrequencyHop.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FREQUENCY_HOP_H		/* Guard to prevent multiple inclusions */
+#define FREQUENCY_HOP_H
+
+#include "cytypes.h"
+#include "main.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables the frequency hopping scan mode. When disabled, all the
+ * scans use the sense clock divider configured in the CapSense component.
+ */
+#ifndef FREQUENCY_HOP_ENABLE
+	#define FREQUENCY_HOP_ENABLE			(DISABLED)
+#endif /* #ifndef FREQUENCY_HOP_ENABLE */
+
+/* Number of sense clock channels scanned in rotation (2 or 3). One channel is
+ * scanned per frame, so the combined difference count includes samples up to
+ * FREQ_HOP_CHANNELS - 1 frames old, see FrequencyHop_ProcessScan().
+ */
+#define FREQ_HOP_CHANNELS					(3)
+
+/* Sense clock divider of each channel, relative to the divider configured in
+ * the CapSense component. 
+ */
+#define FREQ_HOP_DIVIDER_OFFSET_0			(0)
+#define FREQ_HOP_DIVIDER_OFFSET_1			(1)
+#define FREQ_HOP_DIVIDER_OFFSET_2			(3)
+
+/* Selects how the channels are combined for each sensor:
+ * FREQ_HOP_COMBINE_MEDIAN - median of the channels (3 channels only)
+ * FREQ_HOP_COMBINE_CLEANEST - channel with the lowest noise 
+ */
+#define FREQ_HOP_COMBINE_MEDIAN				(0)
+#define FREQ_HOP_COMBINE_CLEANEST			(1)
+#define FREQ_HOP_COMBINE_MODE				(FREQ_HOP_COMBINE_MEDIAN)
+
+/* Fractional bits of the gain that scales the difference count of a channel
+ * to the component baseline 
+ */
+#define FREQ_HOP_GAIN_FRAC_BITS				(12)
+
+/* Filter weights (as right shifts) of the per channel baseline and noise */
+#define FREQ_HOP_BASELINE_SHIFT				(6)
+#define FREQ_HOP_NOISE_SHIFT				(3)
+
+/* The baseline of a channel only follows the raw count while the difference
+ * is below this limit, so that a finger is not absorbed into the baseline. 
+ */
+#define FREQ_HOP_BASELINE_TRACK_LIMIT		(20)
+
+#if((FREQ_HOP_COMBINE_MODE == FREQ_HOP_COMBINE_MEDIAN) && (FREQ_HOP_CHANNELS != 3))
+	#error "FREQ_HOP_COMBINE_MEDIAN requires FREQ_HOP_CHANNELS to be 3"
+#endif
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void FrequencyHop_Init(void);
+void FrequencyHop_ProcessScan(void);
+void FrequencyHop_NextChannel(void);
+
+
+#endif /* #ifndef FREQUENCY_HOP_H */
+
+
+/* [] END OF FILE */
@@ -38,7 +38,8 @@
 *******************************************************************************/
 
 #include "Gesture.h"
-#include "CapSense_CSHL.h"
+#include "Centroid.h"
+#include "Log.h"
 #include "stdbool.h"
 #include "stdlib.h"
 
@@ -57,6 +58,12 @@ int32 accRadius, accTheta;
 /* Status of various segments */
 uint32 capsenseButtonStatus;
 
+/* Status of the buttons and the slider accepted by the arbitration, and its
+ * confidence 
+ */
+uint32 arbitratedButtonStatus;
+uint32 buttonConfidence;
+
 /* X and Y coordinates from Gesture Pad radius and theta */
 int32 xPos, yPos;
 
@@ -64,6 +71,14 @@ int32 xPos, yPos;
 uint32 radius;
 int32 theta;
 
+/* Theta with CENTROID_FRAC_BITS fractional bits, and its accumulated change 
+ * during CapSense activity on the Gesture Pad 
+ */
+int32 thetaFine, accThetaFine;
+
+/* Confidence of the radial slider position from the current scan */
+uint32 sliderConfidence;
+
 /*******************************************************************************
 * 	Static Variable Declarations
 *******************************************************************************/
@@ -119,6 +134,29 @@ const int16 sinLookUp[] = {0,
 const uint32 sectorLookup[] = {SECTOR_0_WEIGHT, SECTOR_1_WEIGHT, SECTOR_2_WEIGHT, SECTOR_3_WEIGHT, SECTOR_4_WEIGHT};
 const uint32 sectorToButtonLookup[] = {CENTRE_BTN_MASK, UP_BTN_MASK, LEFT_BTN_MASK, DOWN_BTN_MASK, RIGHT_BTN_MASK};
 
+/* Adjacency model and CapSense widget of each element ranked by the button arbitration */
+const uint32 arbitrationAdjacency[ARBITRATION_ELEMENTS] = 
+{
+	[LEFT_BTN_ID] = LEFT_BTN_ADJACENT,
+	[RIGHT_BTN_ID] = RIGHT_BTN_ADJACENT,
+	[UP_BTN_ID] = UP_BTN_ADJACENT,
+	[DOWN_BTN_ID] = DOWN_BTN_ADJACENT,
+	[CENTRE_BTN_ID] = CENTRE_BTN_ADJACENT,
+	[SLIDER_ID] = SLIDER_ADJACENT
+};
+const uint8 arbitrationWidget[ARBITRATION_ELEMENTS] = 
+{
+	[LEFT_BTN_ID] = CapSense_LEFT__BTN,
+	[RIGHT_BTN_ID] = CapSense_RIGHT__BTN,
+	[UP_BTN_ID] = CapSense_UP__BTN,
+	[DOWN_BTN_ID] = CapSense_DOWN__BTN,
+	[CENTRE_BTN_ID] = CapSense_CENTRE__BTN,
+	[SLIDER_ID] = CapSense_RADIALSLIDER0__RS
+};
+
+/* Button in the direction of each slider quadrant, indexed by (sliderSector & SLIDER_4_SECTOR_MASK) >> 1 */
+const uint8 sliderSectorToButtonLookup[] = {RIGHT_BTN_ID, DOWN_BTN_ID, LEFT_BTN_ID, UP_BTN_ID};
+
 /*******************************************************************************
 * 	Global Function Prototypes
 *******************************************************************************/
@@ -131,7 +169,7 @@ tGestureId DetectGesture(uint8 isAnySensorActive);
 * 	Local Function Prototypes
 *******************************************************************************/
 
-static uint32 Gestures_ValidateButtons(uint32 buttonStatus, uint32 sliderSector);
+static uint32 Gestures_ArbitrateButtons(uint32 buttonStatus, uint32 sliderSector, uint32 *confidence);
 static int32 Gestures_CalculateTheta(uint32 buttonStatus, int32 sliderPos);
 static uint32 Gestures_CalculateRadius(uint32 buttonStatus);
 static tGestureId Gestures_Process(uint32 radius, int32 theta);
@@ -158,8 +196,10 @@ static tGestureId Gestures_Process(uint32 radius, int32 theta);
 *******************************************************************************/
 tGestureId DetectGesture(uint8 isAnySensorActive)
 {	
+	static int32 prevThetaFine = INVALID_ANGLE_FINE;
 	tGestureId gestureId;
-	uint32 buttonStatus = 0, sliderSector = 0, sliderPos = 0;	
+	uint32 buttonStatus = 0, sliderSector = 0, sliderPos = 0, sliderPosFine;	
+	int32 thetaFineChange;
 	
 	/* If any sensor is active, get the status of various CapSense elements */
 	if(isAnySensorActive)
@@ -169,11 +209,14 @@ tGestureId DetectGesture(uint8 isAnySensorActive)
 	}
 	
 	/* Read the slider status */
-	sliderPos = CapSense_GetRadialCentroidPos(CapSense_RADIALSLIDER0__RS);
+	sliderPosFine = Centroid_GetRadialPos(&sliderConfidence);
 	
 	/* If slider is active, process slider position */
-	if(sliderPos != 0xFFFF)
+	if(sliderPosFine != CENTROID_INVALID)
 	{
+		sliderPos = sliderPosFine >> CENTROID_FRAC_BITS;
+		sliderCentroid = sliderPos;
+		
 		/* Update slider active status to the button status */
 		buttonStatus |= SLIDER_ACT_MASK;
 		
@@ -184,21 +227,65 @@ tGestureId DetectGesture(uint8 isAnySensorActive)
 		if(sliderPos < ANGLE_90)
 		{
 			sliderPos = sliderPos + 10;		
+			sliderPosFine = sliderPosFine + (10 << CENTROID_FRAC_BITS);
 		}
 	}
 	else
 	{
+		sliderCentroid = 0xFFFF;
+		sliderConfidence = 0;
+		
 		/* Clear slider active status */
 		buttonStatus &= ~SLIDER_ACT_MASK;
 	}
 	
-	/* Validate the buttons pressed and update the status with valid button presses */
-	buttonStatus = Gestures_ValidateButtons(buttonStatus, sliderSector);
+	/* Arbitrate the buttons pressed and update the status with valid button presses */
+	buttonStatus = Gestures_ArbitrateButtons(buttonStatus, sliderSector, &buttonConfidence);
+	arbitratedButtonStatus = buttonStatus;
 	
 	/* Get radius and theta from active buttons and slider position */
 	radius = Gestures_CalculateRadius(buttonStatus);
 	theta = Gestures_CalculateTheta(buttonStatus, sliderPos);
 	
+	/* Fine theta follows the slider centroid with its fractional part, and the
+		button position otherwise */
+	if(theta == INVALID_ANGLE)
+	{
+		thetaFine = INVALID_ANGLE_FINE;
+		accThetaFine = 0;
+	}
+	else
+	{
+		if(buttonStatus & SLIDER_ACT_MASK)
+		{
+			thetaFine = (int32)sliderPosFine;
+			if(thetaFine > (SLIDER_MID_POS << CENTROID_FRAC_BITS))
+			{
+				thetaFine -= (SLIDER_RESOLUTION << CENTROID_FRAC_BITS);
+			}
+		}
+		else
+		{
+			thetaFine = theta * (1 << CENTROID_FRAC_BITS);
+		}
+		
+		/* Accumulate with the same cross over correction as theta */
+		if(prevThetaFine != INVALID_ANGLE_FINE)
+		{
+			thetaFineChange = thetaFine - prevThetaFine;
+			if(thetaFineChange > (ANGLE_90 << CENTROID_FRAC_BITS))
+			{
+				thetaFineChange -= (2*ANGLE_180) << CENTROID_FRAC_BITS;
+			}
+			else if(thetaFineChange < -(ANGLE_90 << CENTROID_FRAC_BITS))
+			{
+				thetaFineChange += (2*ANGLE_180) << CENTROID_FRAC_BITS;
+			}
+			accThetaFine += thetaFineChange;
+		}
+	}
+	prevThetaFine = thetaFine;
+	
 	/* Obtain the gesture from theta and radius */
 	gestureId = Gestures_Process(radius, theta);
 	
@@ -220,120 +307,130 @@ tGestureId DetectGesture(uint8 isAnySensorActive)
 }
 
 /*******************************************************************************
-* Function Name: Gestures_ValidateButtons
+* Function Name: Gestures_ArbitrateButtons
 ********************************************************************************
 *
 * Summary:
-* This function validates the button and slider active status and returns the 
-*	validated output. 
+* This function arbitrates between all the active buttons and the slider and 
+*	returns the combination of elements that a single finger can produce. 
 *
 * Parameters:
 *  buttonStatus - status of various buttons, refer to Gesture.h for various
 *					masks
 *  sliderSector - sector of the slider which is active (slider divided
-*                   into four sectors)
+*                   into eight sectors)
+*  confidence - pointer to store the confidence of the result (0 to 
+*					CONFIDENCE_MAX)
 *
 * Return:
 * uint32 - validated button status
 *
+* Theory:
+* Each active element is given a strength - its signal normalized to its finger
+* threshold (the strongest segment for the slider). The elements are accepted
+* in order of decreasing strength as long as they are adjacent to all the 
+* elements accepted before (see the x_ADJACENT macros in Gesture.h). 
+* Elements reported in the previous scan and the button in the direction of 
+* the slider sector get a bonus, which resolves ties without toggling.
+* The confidence is the margin between the weakest accepted and the strongest
+* rejected element, relative to the weakest accepted element.
+*
 *******************************************************************************/
-uint32 Gestures_ValidateButtons(uint32 buttonStatus, uint32 sliderSector)
+static uint32 Gestures_ArbitrateButtons(uint32 buttonStatus, uint32 sliderSector, uint32 *confidence)
 {
 	static uint32 prevButtonStatus;
 	
-	/* If both slider and centre button are active, slider gets preference
-		Only one of these two can be activated in the design */
-	if((buttonStatus & SLIDER_ACT_MASK) && (buttonStatus & CENTRE_BTN_MASK))
-	{
-		buttonStatus &= ~ CENTRE_BTN_MASK;		
-	}
+	uint32 strength[ARBITRATION_ELEMENTS];
+	uint32 element, strongest, signal, segment;
+	uint32 pending, accepted = 0;
+	uint32 weakestAccepted = 0, strongestRejected = 0;
 	
-	/* If both left and right button are active, analyze and report only the
-		more probable button */
-	if((buttonStatus & LEFT_BTN_MASK) && (buttonStatus & RIGHT_BTN_MASK))
+	/* Calculate the strength of the active elements */
+	pending = buttonStatus;
+	for(element = 0; element < ARBITRATION_ELEMENTS; element++)
 	{
-		/* If slider is active, then check the sector of slider is referred to 
-			decide the button to be reported */
-		if(buttonStatus & SLIDER_ACT_MASK)
+		strength[element] = 0;
+		
+		if(pending & (1u << element))
 		{
-			if((sliderSector & SLIDER_4_SECTOR_MASK) == SECTOR_LEFT) 
-			/* Clear Right button mask if slider sector is left */
+			if(element == SLIDER_ID)
 			{
-				buttonStatus &= ~RIGHT_BTN_MASK;
+				signal = 0;
+				for(segment = 0; segment < RADIAL_SLIDER_SEGMENTS; segment++)
+				{
+					if(GetSignal(SLIDER_ID + segment) > signal)
+					{
+						signal = GetSignal(SLIDER_ID + segment);
+					}
+				}
 			}
-			else if((sliderSector & SLIDER_4_SECTOR_MASK) == SECTOR_RIGHT)
-			/* Clear Left button mask if slider sector is Right */
+			else
 			{
-				buttonStatus &= ~LEFT_BTN_MASK;
+				signal = GetSignal(element);
 			}
-			else
-			/* Retain the previous button status if slider sector is neither left nor right */
+			
+			strength[element] = (signal * ARBITRATION_UNITY) / (CapSense_fingerThreshold[arbitrationWidget[element]] + 1u);
+			
+			if(prevButtonStatus & (1u << element))
 			{
-				buttonStatus &= ~(LEFT_BTN_MASK | RIGHT_BTN_MASK);
-				buttonStatus |= prevButtonStatus & (LEFT_BTN_MASK | RIGHT_BTN_MASK);
+				strength[element] += ARBITRATION_HOLD_BONUS;
 			}
 		}
-		else
-		/* If slider is not active, use button signal to decide the button */
+	}
+	
+	/* The slider points at one of the direction buttons */
+	if(pending & SLIDER_ACT_MASK)
+	{
+		element = sliderSectorToButtonLookup[(sliderSector & SLIDER_4_SECTOR_MASK) >> 1];
+		if(pending & (1u << element))
 		{
-			if(GetSignal(LEFT_BTN_ID) > GetSignal(RIGHT_BTN_ID))
-			{
-				buttonStatus &= ~RIGHT_BTN_MASK;
-			}
-			else if(GetSignal(LEFT_BTN_ID) < GetSignal(RIGHT_BTN_ID))
-			{
-				buttonStatus &= ~LEFT_BTN_MASK;
-			}
-			else
-			{
-				buttonStatus &= ~(LEFT_BTN_MASK | RIGHT_BTN_MASK);
-				buttonStatus |= prevButtonStatus & (LEFT_BTN_MASK | RIGHT_BTN_MASK);
-			}
+			strength[element] += ARBITRATION_SECTOR_BONUS;
 		}
 	}
 	
-	/* Same logic as Left/Right button for Up/Down button as well */
-	if((buttonStatus & UP_BTN_MASK) && (buttonStatus & DOWN_BTN_MASK))
+	/* Accept the elements in order of decreasing strength */
+	while(pending != 0)
 	{
-		if(buttonStatus & SLIDER_ACT_MASK)
+		strongest = ARBITRATION_ELEMENTS;
+		for(element = 0; element < ARBITRATION_ELEMENTS; element++)
 		{
-			if((sliderSector & SLIDER_4_SECTOR_MASK) == SECTOR_UP)
+			if((pending & (1u << element)) && ((strongest == ARBITRATION_ELEMENTS) || (strength[element] > strength[strongest])))
 			{
-				buttonStatus &= ~DOWN_BTN_MASK;
-			}
-			else if((sliderSector & SLIDER_4_SECTOR_MASK) == SECTOR_DOWN)
-			{
-				buttonStatus &= ~UP_BTN_MASK;
-			}
-			else
-			{
-				buttonStatus &= ~(UP_BTN_MASK | DOWN_BTN_MASK);
-				buttonStatus |= prevButtonStatus & (UP_BTN_MASK | DOWN_BTN_MASK);
+				strongest = element;
 			}
 		}
-		else
+		pending &= ~(1u << strongest);
+		
+		if((arbitrationAdjacency[strongest] & accepted) == accepted)
 		{
-			if(GetSignal(UP_BTN_ID) > GetSignal(DOWN_BTN_ID))
-			{
-				buttonStatus &= ~DOWN_BTN_MASK;
-			}
-			else if(GetSignal(UP_BTN_ID) < GetSignal(DOWN_BTN_ID))
-			{
-				buttonStatus &= ~UP_BTN_MASK;
-			}
-			else
-			{
-				buttonStatus &= ~(UP_BTN_MASK | DOWN_BTN_MASK);
-				buttonStatus |= prevButtonStatus & (UP_BTN_MASK | DOWN_BTN_MASK);
-			}
+			accepted |= (1u << strongest);
+			weakestAccepted = strength[strongest];
 		}
+		else if(strength[strongest] > strongestRejected)
+		{
+			strongestRejected = strength[strongest];
+		}
+	}
+	
+	/* Report the margin to the strongest rejected element as the confidence */
+	if(strongestRejected == 0)
+	{
+		*confidence = CONFIDENCE_MAX;
+	}
+	else if(weakestAccepted > strongestRejected)
+	{
+		*confidence = ((weakestAccepted - strongestRejected) * CONFIDENCE_MAX) / weakestAccepted;
+	}
+	else
+	{
+		*confidence = 0;
 	}
 	
 	/* Store current buttonStatus to previous button status for next cycle */
-	prevButtonStatus = buttonStatus;
+	prevButtonStatus = accepted;
 	
 	/* Return the validated button status */
-	return	buttonStatus;
+	return accepted;
 }
 
 
@@ -500,7 +597,7 @@ int32 Gestures_CalculateTheta(uint32 buttonStatus, int32 sliderPos)
 *
 * Parameters:
 *  theta - angle for which sine needs to be calculated (-90 to 90);
-*			1 count = 2 degrees;
+*			1 count = 2 degrees; must not be INVALID_ANGLE
 *
 * Return:
 * int32 - sine theta value scaled to 256 (i.e. 1 = 256, 0.5 = 128 etc)
@@ -508,42 +605,39 @@ int32 Gestures_CalculateTheta(uint32 buttonStatus, int32 sliderPos)
 *******************************************************************************/
 int32 GetSinTheta(int32 theta)
 {
-	int32 sinTheta = INVALID_SINE;
+	int32 sinTheta;
 	
-	/* Return sine theta, only if angle/theta is valid */
-	if(theta != INVALID_ANGLE)
+	CYASSERT((theta >= -ANGLE_180) && (theta <= ANGLE_180));
+	
+	/* Based on theta, lookup the sine table appropriately and return the value */
+	/* sin(-theta) = -sin(theta) */
+	if(theta < 0)
+	{			
+		theta = -theta;
+		
+		/* sin(180-theta) = sin(theta) */
+		if(theta > ANGLE_90)
+		{
+			sinTheta = -1 * sinLookUp[ANGLE_180 - theta];
+		}
+		else
+		{
+			sinTheta = -1 * sinLookUp[theta];
+		}
+	}
+	else
 	{
-		/* Based on theta, lookup the sine table appropriately and return the value */
-		/* sin(-theta) = -sin(theta) */
-		if(theta < 0)
-		{			
-			theta = -theta;
-			
-			/* sin(180-theta) = sin(theta) */
-			if(theta > ANGLE_90)
-			{
-				sinTheta = -1 * sinLookUp[ANGLE_180 - theta];
-			}
-			else
-			{
-				sinTheta = -1 * sinLookUp[theta];
-			}
+		/* sin(180-theta) = sin(theta) */
+		if(theta > ANGLE_90)
+		{
+			sinTheta = sinLookUp[ANGLE_180 - theta];
 		}
 		else
 		{
-			/* sin(180-theta) = sin(theta) */
-			if(theta > ANGLE_90)
-			{
-				sinTheta = sinLookUp[ANGLE_180 - theta];
-			}
-			else
-			{
-				sinTheta = sinLookUp[theta];
-			}
+			sinTheta = sinLookUp[theta];
 		}
 	}
 	
-	
 	return sinTheta;
 }
 
@@ -556,7 +650,7 @@ int32 GetSinTheta(int32 theta)
 *
 * Parameters:
 *  theta - angle for which cosine needs to be calculated (-90 to 90);
-*			1 count = 2 degrees;
+*			1 count = 2 degrees; must not be INVALID_ANGLE
 *
 * Return:
 * int32 - cosine theta value scaled to 256 (i.e. 1 = 256, 0.5 = 128 etc)
@@ -564,28 +658,26 @@ int32 GetSinTheta(int32 theta)
 *******************************************************************************/
 int32 GetCosTheta(int32 theta)
 {
-	int32 cosTheta = INVALID_SINE;
+	int32 cosTheta;
+	
+	CYASSERT((theta >= -ANGLE_180) && (theta <= ANGLE_180));
 	
-	/* Return cosine theta, only if angle/theta is valid */
-	if(theta != INVALID_ANGLE)
+	/* Trigonometric relations used in the calculation
+	cos(theta) = sin(90 - theta) 
+	cos(-theta) = cos(theta) 
+	cos(180 - theta) = -cos(theta) */
+	if(theta < 0)
 	{
-		/* Trigonometric relations used in the calculation
-		cos(theta) = sin(90 - theta) 
-		cos(-theta) = cos(theta) 
-		cos(180 - theta) = -cos(theta) */
-		if(theta < 0)
-		{
-			theta = -theta;
-		}
-		
-		if(theta > ANGLE_90)
-		{
-			cosTheta = -1 * sinLookUp[theta - ANGLE_90];
-		}
-		else
-		{
-			cosTheta = sinLookUp[ANGLE_90 - theta];
-		}
+		theta = -theta;
+	}
+	
+	if(theta > ANGLE_90)
+	{
+		cosTheta = -1 * sinLookUp[theta - ANGLE_90];
+	}
+	else
+	{
+		cosTheta = sinLookUp[ANGLE_90 - theta];
 	}
 	
 	return cosTheta;
@@ -604,7 +696,7 @@ int32 GetCosTheta(int32 theta)
 *			1 count = 2 degrees;
 *
 * Return:
-* int32 - Cartesian coordinate x (-8 to +8)
+* int32 - Cartesian coordinate x (-16 to +16)
 *
 *******************************************************************************/
 int32 Gestures_CalculateX(uint32 radius, int32 theta)
@@ -643,7 +735,7 @@ int32 Gestures_CalculateX(uint32 radius, int32 theta)
 *			1 count = 2 degrees;
 *
 * Return:
-* int32 - Cartesian coordinate y (-8 to +8)
+* int32 - Cartesian coordinate y (-16 to +16)
 *
 *******************************************************************************/
 int32 Gestures_CalculateY(uint32 radius, int32 theta)
@@ -676,7 +768,8 @@ int32 Gestures_CalculateY(uint32 radius, int32 theta)
 * Parameters:
 * radius - Polar coordinate radius  (0 to 4)
 * theta - Polar coordinate theta (-90 to 90);
-*			1 count = 2 degrees;
+*			1 count = 2 degrees; must not be INVALID_ANGLE, the state machine
+*			only calls this function for a touched pad
 *
 * Return:
 * uint32 - sector number
@@ -689,28 +782,26 @@ int32 Gestures_CalculateY(uint32 radius, int32 theta)
 *******************************************************************************/
 uint32 Gestures_GetSector(uint32 radius, int32 theta)
 {
-	uint32 sector = INVALID_SECTOR;
+	uint32 sector;
+	
+	CYASSERT((theta >= -ANGLE_180) && (theta <= ANGLE_180));
 	
-	/* Process only for valid theta */
-	if(theta != INVALID_ANGLE)
+	/* If radius = 0, sector is 0 (CENTRE button) */
+	if(radius == 0)
 	{
-		/* If radius = 0, sector is 0 (CENTRE button) */
-		if(radius == 0)
+		sector = 0;
+	}
+	else
+	{
+		/* Calculate sector based on theta if radius != 0 */
+		if(theta >= 0)
 		{
-			sector = 0;
+			sector = 1 + (theta/ANGLE_90);
 		}
 		else
 		{
-			/* Calculate sector based on theta if radius != 0 */
-			if(theta >= 0)
-			{
-				sector = 1 + (theta/ANGLE_90);
-			}
-			else
-			{
-				sector = (uint32)((int32)4 + (theta/ANGLE_90));
-			}			
-		}
+			sector = (uint32)((int32)4 + (theta/ANGLE_90));
+		}			
 	}
 	
 	return sector;
@@ -850,6 +941,8 @@ tGestureId Gestures_Process(uint32 radius, int32 theta)
 				firstTheta = theta;				
 				Gesture_sectorHistory[FIRST_SECTOR_INDEX] = Gestures_GetSector(radius, theta);
 				
+				LOG_GESTURE_INFO(TELEMETRY_EVENT_TOUCH_DOWN, Gesture_sectorHistory[FIRST_SECTOR_INDEX] | (radius << 8));
+				
 				/* Move the state to 1st sector process */
 				processState = GESTURE_STATE_1ST_SECTOR;
 			}
@@ -952,6 +1045,7 @@ tGestureId Gestures_Process(uint32 radius, int32 theta)
 						
 						/* Store the new sector */
 						Gesture_sectorHistory[SECOND_SECTOR_INDEX] = sector;
+						LOG_GESTURE_TRACE(TELEMETRY_EVENT_SECTOR, sector);
 						debounceCounter = 0;
 					}
 				}
@@ -1006,6 +1100,7 @@ tGestureId Gestures_Process(uint32 radius, int32 theta)
 							three sectors to process a gesture). */
 						processState = GESTURE_STATE_3RD_SECTOR;
 						Gesture_sectorHistory[THIRD_SECTOR_INDEX] = sector;
+						LOG_GESTURE_TRACE(TELEMETRY_EVENT_SECTOR, sector);
 						
 						/* Calculate the unique sector sum gesture detection */
 						sectorHistorySum = sectorLookup[Gesture_sectorHistory[THIRD_SECTOR_INDEX]] * THIRD_SECTOR_WEIGHT
@@ -1076,6 +1171,7 @@ tGestureId Gestures_Process(uint32 radius, int32 theta)
 						Gesture_sectorHistory[FIRST_SECTOR_INDEX] = Gesture_sectorHistory[SECOND_SECTOR_INDEX];
 						Gesture_sectorHistory[SECOND_SECTOR_INDEX] = Gesture_sectorHistory[THIRD_SECTOR_INDEX];						
 						Gesture_sectorHistory[THIRD_SECTOR_INDEX] = sector;
+						LOG_GESTURE_TRACE(TELEMETRY_EVENT_SECTOR, sector);
 						
 						sectorHistorySum = sectorLookup[Gesture_sectorHistory[THIRD_SECTOR_INDEX]] * THIRD_SECTOR_WEIGHT
 									+ sectorLookup[Gesture_sectorHistory[SECOND_SECTOR_INDEX]] * SECOND_SECTOR_WEIGHT
@@ -1139,6 +1235,8 @@ tGestureId Gestures_Process(uint32 radius, int32 theta)
 		
 		/* Gesture release state - this state clears all state machine variables for the next activation */
 		case GESTURE_STATE_SECTOR_RELEASE:			
+			LOG_GESTURE_INFO(TELEMETRY_EVENT_TOUCH_UP, 0);
+			
 			debounceCounter = 0;
 			tapCounter = 0;
 			
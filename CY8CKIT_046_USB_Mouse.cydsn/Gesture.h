@@ -42,7 +42,7 @@
 	#define GESTURE_H 
 
 	#include "cytypes.h"
-	#include "CapSense.h"
+	#include "Platform.h"
 	#include "stdbool.h"
 
 
@@ -89,6 +89,11 @@
 	#define DOWN_BTN_ID					CapSense_SENSOR_DOWN__BTN
 	#define CENTRE_BTN_ID				CapSense_SENSOR_CENTRE__BTN	
 	#define SLIDER_ID					CapSense_SENSOR_RADIALSLIDER0_E0__RS
+	
+	/* Number of segments of the radial slider. The segments are the sensors
+	 * SLIDER_ID to SLIDER_ID + RADIAL_SLIDER_SEGMENTS - 1.
+	 */
+	#define RADIAL_SLIDER_SEGMENTS		(8)
 
 	/* These macros defines the mask for each sensor to be used with CapSense APIs
 	 * or global variables. 
@@ -100,6 +105,43 @@
 	#define CENTRE_BTN_MASK				(1 << CENTRE_BTN_ID)
 	#define SLIDER_ACT_MASK				(1 << SLIDER_ID)
 		
+	/* Number of elements (5 buttons and the slider) ranked by the button 
+	 * arbitration. The slider is the element after the buttons.
+	 */
+	#define ARBITRATION_ELEMENTS		(SLIDER_ID + 1)
+	
+	/* Adjacency model of the Gesture Pad used by the button arbitration. Each 
+	 * macro lists the elements which can be touched together with the element
+	 * by a single finger. Opposite buttons, and the centre button and the 
+	 * slider, are never adjacent.
+	 */
+	#define LEFT_BTN_ADJACENT			(UP_BTN_MASK | DOWN_BTN_MASK | CENTRE_BTN_MASK | SLIDER_ACT_MASK)
+	#define RIGHT_BTN_ADJACENT			(UP_BTN_MASK | DOWN_BTN_MASK | CENTRE_BTN_MASK | SLIDER_ACT_MASK)
+	#define UP_BTN_ADJACENT				(LEFT_BTN_MASK | RIGHT_BTN_MASK | CENTRE_BTN_MASK | SLIDER_ACT_MASK)
+	#define DOWN_BTN_ADJACENT			(LEFT_BTN_MASK | RIGHT_BTN_MASK | CENTRE_BTN_MASK | SLIDER_ACT_MASK)
+	#define CENTRE_BTN_ADJACENT			(LEFT_BTN_MASK | RIGHT_BTN_MASK | UP_BTN_MASK | DOWN_BTN_MASK)
+	#define SLIDER_ADJACENT				(LEFT_BTN_MASK | RIGHT_BTN_MASK | UP_BTN_MASK | DOWN_BTN_MASK)
+	
+	/* Normalized signal strength of an element which is exactly at its finger
+	 * threshold 
+	 */
+	#define ARBITRATION_UNITY			(256)
+	
+	/* Strength added to the elements reported in the previous scan, so that
+	 * equally strong elements do not toggle between scans.
+	 */
+	#define ARBITRATION_HOLD_BONUS		(ARBITRATION_UNITY/8)
+	
+	/* Strength added to the button in the direction of the slider sector, 
+	 * when the slider is active.
+	 */
+	#define ARBITRATION_SECTOR_BONUS	(ARBITRATION_UNITY/4)
+	
+	/* Range of the confidence reported with the arbitrated button status.
+	 * Maximum confidence is reported when no active element was rejected.
+	 */
+	#define CONFIDENCE_MAX				(255)
+		
 	#define SLIDER_4_SECTOR_MASK		0x06
 	#define SECTOR_LEFT					0x04
 	#define SECTOR_UP					0x06
@@ -116,6 +158,7 @@
 	#define ANGLE_135					(ANGLE_45 + ANGLE_90)
 	#define ANGLE_180					(SLIDER_RESOLUTION/2)
 	#define INVALID_ANGLE				250
+	#define INVALID_ANGLE_FINE			(0x7FFFFFFF)
 		
 	#define INVALID_SECTOR				255
 	#define INVALID_SINE				1000
@@ -209,12 +252,26 @@
 	tGestureId DetectGesture(uint8 isAnySensorActive);
 
 	extern uint32 capsenseButtonStatus;
+	/* Status of the buttons and the slider accepted by the arbitration from the
+	 * last scan, and its confidence (0 to CONFIDENCE_MAX)
+	 */
+	extern uint32 arbitratedButtonStatus;
+	extern uint32 buttonConfidence;
 	extern int32 xPos, yPos;
 	/* Accumulated theta and radius during CapSense activity on the Gesture Pad*/
 	extern int32 accRadius, accTheta;
 
 	extern uint32 radius;
 	extern int32 theta;
+	
+	/* Theta with CENTROID_FRAC_BITS fractional bits (1 count = 2/256 degrees),
+	 * INVALID_ANGLE_FINE if no touch. accThetaFine is the accumulated change of 
+	 * thetaFine since touch down.
+	 */
+	extern int32 thetaFine, accThetaFine;
+	
+	/* Confidence (0 to CONFIDENCE_MAX) of the radial slider position */
+	extern uint32 sliderConfidence;
 		
 #endif /* #ifndef GESTURES_H */
 
@@ -0,0 +1,387 @@
+/*******************************************************************************
+* File Name: GestureStats.c
+*
+* Version 1.0
+*
+* Description: This file contains the gesture recognition accuracy and latency
+*               benchmark.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "GestureStats.h"
+#include "TouchSynth.h"
+#include "Timebase.h"
+#include "Telemetry.h"
+#include "stdbool.h"
+#include "string.h"
+
+
+#if(GESTURE_STATS_ENABLE)
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Touches per label (rows) and recognized gesture (columns). The label is the
+ * gesture the trace was annotated with, GESTURE_NONE for unlabeled touches. 
+ * The recognized gesture is GESTURE_NONE if nothing was recognized.
+ */
+static uint16 confusion[GESTURE_STATS_IDS][GESTURE_STATS_IDS];
+
+/* Frames from touch down to recognition, per recognized gesture */
+static uint16 latency[GESTURE_STATS_IDS][GESTURE_STATS_BUCKETS];
+
+/* State of the touch in progress */
+static bool isTouching;
+static uint32 touchFrames;
+static uint32 touchLabel;
+static tGestureId touchGesture;
+
+/* Frames processed and time stamp at the start of the run */
+static uint32 runFrames;
+static uint32 runStartMs;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static tGestureId GestureStats_ButtonToGesture(uint32 buttonStatus);
+static uint32 GestureStats_Percent(uint32 part, uint32 total);
+
+#endif /* #if(GESTURE_STATS_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: GestureStats_Update
+********************************************************************************
+* Summary:
+*  Follows the touches frame by frame. The first gesture recognized during a 
+*  touch is compared with the label of the touch and its latency is recorded
+*  when the touch is released.
+*
+* Parameters:
+*  gestureId - gesture returned by DetectGesture() for the frame.
+*
+* Return:
+*  None
+*
+* Theory:
+*  Clicks are not returned as gestures by DetectGesture(); they are reported 
+*  through capsenseButtonStatus and are counted as the matching x_CLICK 
+*  gesture id. A click is reported on the release frame, so the release is 
+*  evaluated after the events of the frame. With synthesized traces, each 
+*  mis-recognized touch is printed as miss,<label>,<recognized>,<seed>, where
+*  seed recreates the trajectory, refer to TouchSynth_GetSeed().
+*
+*******************************************************************************/
+void GestureStats_Update(tGestureId gestureId)
+{
+	#if(GESTURE_STATS_ENABLE)
+		uint32 label = SensorTrace_GetLabel();
+		uint32 bucket;
+		
+		runFrames++;
+		
+		if(label == GESTURE_STATS_LABEL_DUMP)
+		{
+			GestureStats_Dump();
+			GestureStats_Clear();
+			return;
+		}
+		
+		if(theta != INVALID_ANGLE)
+		{
+			isTouching = true;
+			touchFrames++;
+			
+			if((label != TRACE_LABEL_NONE) && (label < GESTURE_STATS_IDS))
+			{
+				touchLabel = label;
+			}
+		}
+		
+		if(isTouching)
+		{
+			/* Keep the first gesture of the touch */
+			if(touchGesture == GESTURE_NONE)
+			{
+				if((gestureId != GESTURE_NONE) && (gestureId != GESTURE_INVALID))
+				{
+					touchGesture = gestureId;
+				}
+				else
+				{
+					touchGesture = GestureStats_ButtonToGesture(capsenseButtonStatus);
+				}
+				
+				if(touchGesture != GESTURE_NONE)
+				{
+					bucket = touchFrames / GESTURE_STATS_BUCKET_FRAMES;
+					if(bucket >= GESTURE_STATS_BUCKETS)
+					{
+						bucket = GESTURE_STATS_BUCKETS - 1;
+					}
+					latency[touchGesture][bucket]++;
+				}
+			}
+			
+			if(theta == INVALID_ANGLE)
+			{
+				confusion[touchLabel][touchGesture]++;
+				
+				#if(GESTURE_STATS_PRINT_MISSES)
+					if((touchLabel != GESTURE_NONE) && (touchLabel != touchGesture))
+					{
+						Telemetry_Flush();
+						UART_UartPutString("miss");
+						PrintField(touchLabel);
+						PrintField(touchGesture);
+						PrintField(TouchSynth_GetSeed());
+						UART_UartPutString("\n\r");
+					}
+				#endif /* #if(GESTURE_STATS_PRINT_MISSES) */
+				
+				isTouching = false;
+				touchFrames = 0;
+				touchLabel = GESTURE_NONE;
+				touchGesture = GESTURE_NONE;
+			}
+		}
+	#endif /* #if(GESTURE_STATS_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: GestureStats_Dump
+********************************************************************************
+* Summary:
+*  Prints the results over UART as comma separated lines, one record per line:
+*   config,<parameter>,<value>
+*   throughput,<frames>,<milliseconds>
+*   summary,<gesture>,<true pos>,<false pos>,<false neg>,<precision %>,<recall %>
+*   confusion,<label>,<recognized>,<touches>
+*   latency,<gesture>,<bucket>,<touches>
+*  Only labeled touches are counted in the summary. Zero entries of the matrix
+*  and of the histograms are skipped.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void GestureStats_Dump(void)
+{
+	#if(GESTURE_STATS_ENABLE)
+		uint32 label, gesture, bucket;
+		uint32 truePositive, falsePositive, falseNegative;
+		
+		Telemetry_Flush();
+		
+		UART_UartPutString("config,SECTOR_DEBOUNCE");
+		PrintField(SECTOR_DEBOUNCE);
+		UART_UartPutString("\n\rconfig,THETA_CHANGE_THRESHOLD");
+		PrintField(THETA_CHANGE_THRESHOLD);
+		UART_UartPutString("\n\rconfig,TAP_TIME_1_SEC");
+		PrintField(TAP_TIME_1_SEC);
+		UART_UartPutString("\n\rconfig,BUCKET_FRAMES");
+		PrintField(GESTURE_STATS_BUCKET_FRAMES);
+		UART_UartPutString("\n\rthroughput");
+		PrintField(runFrames);
+		PrintField(Timebase_GetMs() - runStartMs);
+		UART_UartPutString("\n\r");
+		
+		for(gesture = GESTURE_RELEASE; gesture < GESTURE_STATS_IDS; gesture++)
+		{
+			truePositive = confusion[gesture][gesture];
+			falsePositive = 0;
+			falseNegative = 0;
+			
+			for(label = GESTURE_NONE; label < GESTURE_STATS_IDS; label++)
+			{
+				if(label != gesture)
+				{
+					/* Unlabeled touches are not false positives */
+					if(label != GESTURE_NONE)
+					{
+						falsePositive += confusion[label][gesture];
+					}
+					falseNegative += confusion[gesture][label];
+				}
+			}
+			
+			UART_UartPutString("summary");
+			PrintField(gesture);
+			PrintField(truePositive);
+			PrintField(falsePositive);
+			PrintField(falseNegative);
+			PrintField(GestureStats_Percent(truePositive, truePositive + falsePositive));
+			PrintField(GestureStats_Percent(truePositive, truePositive + falseNegative));
+			UART_UartPutString("\n\r");
+		}
+		
+		for(label = GESTURE_NONE; label < GESTURE_STATS_IDS; label++)
+		{
+			for(gesture = GESTURE_NONE; gesture < GESTURE_STATS_IDS; gesture++)
+			{
+				if(confusion[label][gesture] != 0)
+				{
+					UART_UartPutString("confusion");
+					PrintField(label);
+					PrintField(gesture);
+					PrintField(confusion[label][gesture]);
+					UART_UartPutString("\n\r");
+				}
+			}
+		}
+		
+		for(gesture = GESTURE_NONE; gesture < GESTURE_STATS_IDS; gesture++)
+		{
+			for(bucket = 0; bucket < GESTURE_STATS_BUCKETS; bucket++)
+			{
+				if(latency[gesture][bucket] != 0)
+				{
+					UART_UartPutString("latency");
+					PrintField(gesture);
+					PrintField(bucket);
+					PrintField(latency[gesture][bucket]);
+					UART_UartPutString("\n\r");
+				}
+			}
+		}
+	#endif /* #if(GESTURE_STATS_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: GestureStats_Clear
+********************************************************************************
+* Summary:
+*  Clears the results and the state of the touch in progress.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void GestureStats_Clear(void)
+{
+	#if(GESTURE_STATS_ENABLE)
+		memset(confusion, 0, sizeof(confusion));
+		memset(latency, 0, sizeof(latency));
+		
+		isTouching = false;
+		touchFrames = 0;
+		touchLabel = GESTURE_NONE;
+		touchGesture = GESTURE_NONE;
+		
+		runFrames = 0;
+		runStartMs = Timebase_GetMs();
+	#endif /* #if(GESTURE_STATS_ENABLE) */
+}
+
+
+#if(GESTURE_STATS_ENABLE)
+
+/*******************************************************************************
+* Function Name: GestureStats_ButtonToGesture
+********************************************************************************
+* Summary:
+*  Returns the click gesture id for a button status.
+*
+* Parameters:
+*  buttonStatus - button status as reported in capsenseButtonStatus.
+*
+* Return:
+*  Click gesture id, or GESTURE_NONE if no single button is reported.
+*
+*******************************************************************************/
+static tGestureId GestureStats_ButtonToGesture(uint32 buttonStatus)
+{
+	tGestureId gestureId;
+	
+	switch(buttonStatus)
+	{
+		case LEFT_BTN_MASK:
+			gestureId = GESTURE_LEFT_CLICK;
+			break;
+		case RIGHT_BTN_MASK:
+			gestureId = GESTURE_RIGHT_CLICK;
+			break;
+		case CENTRE_BTN_MASK:
+			gestureId = GESTURE_MIDDLE_CLICK;
+			break;
+		case UP_BTN_MASK:
+			gestureId = GESTURE_UP_CLICK;
+			break;
+		case DOWN_BTN_MASK:
+			gestureId = GESTURE_DOWN_CLICK;
+			break;
+		default:
+			gestureId = GESTURE_NONE;
+			break;
+	}
+	
+	return gestureId;
+}
+
+
+/*******************************************************************************
+* Function Name: GestureStats_Percent
+********************************************************************************
+* Summary:
+*  Returns a part of a total as a percentage, rounded down.
+*
+* Parameters:
+*  part - count of the part, not larger than total
+*  total - count of the total
+*
+* Return:
+*  uint32 - percentage from 0 to 100, 0 if total is 0
+*
+*******************************************************************************/
+static uint32 GestureStats_Percent(uint32 part, uint32 total)
+{
+	return (total == 0) ? 0 : ((part * 100) / total);
+}
+
+
+#endif /* #if(GESTURE_STATS_ENABLE) */
+
+
+/* [] END OF FILE */
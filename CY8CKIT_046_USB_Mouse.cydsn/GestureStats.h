@@ -0,0 +1,89 @@
+/*****************************************************************************
+* File Name		: GestureStats.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  GestureStats.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef GESTURE_STATS_H		/* Guard to prevent multiple inclusions */
+#define GESTURE_STATS_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "Gesture.h"
+#include "SensorTrace.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables the gesture benchmark. Enabled by default when replaying
+ * or synthesizing traces, as the labels of the trace frames are the reference.
+ */
+#define GESTURE_STATS_ENABLE				(SENSOR_TRACE_INJECT)
+
+/* Number of gesture ids in the confusion matrix and histograms */
+#define GESTURE_STATS_IDS					(GESTURE_INVALID + 1)
+
+/* Latency histogram - number of buckets and width of each bucket in frames.
+ * The last bucket collects all the latencies beyond the range. 
+ */
+#define GESTURE_STATS_BUCKETS				(16)
+#define GESTURE_STATS_BUCKET_FRAMES			(4)
+
+/* Prints every mis-recognized touch of synthesized traces as it happens */
+#define GESTURE_STATS_PRINT_MISSES			(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH)
+
+/* A replayed frame with this label dumps the results and clears them, so that
+ * the end of a corpus can be marked in the trace itself. 
+ */
+#define GESTURE_STATS_LABEL_DUMP			(0xFFu)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void GestureStats_Update(tGestureId gestureId);
+void GestureStats_Dump(void);
+void GestureStats_Clear(void);
+
+
+#endif /* #ifndef GESTURE_STATS_H */
+
+
+/* [] END OF FILE */
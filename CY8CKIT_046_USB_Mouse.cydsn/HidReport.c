@@ -41,8 +41,10 @@
 #include "HidReport.h"
 #include "main.h"
 #include "Gesture.h"
+#include "Centroid.h"
 #include "cytypes.h"
-#include "UART_SPI_UART.h"
+#include "Platform.h"
+#include "Log.h"
 
 
 /*******************************************************************************
@@ -68,6 +70,38 @@ int8 mouseReport[MOUSE_RPT_SIZE] = {0, 0, 0, 0};
  */
 uint8 keyboardReport[KEY_RPT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0};
 
+#if(CONSUMER_REPORT_ENABLE)
+	/* Consumer control data report array. The report format is as follows.
+	 * Byte0 to Byte1: Usage of the pressed key on the consumer page, low byte
+	 *				   first. 0 if no key is pressed.
+	 */
+	uint8 consumerReport[CONSUMER_RPT_SIZE] = {0, 0};
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
+
+/*******************************************************************************
+*   Static Variable Declarations
+*******************************************************************************/
+
+#if(CONSUMER_REPORT_ENABLE)
+	/* Volume steps not sent yet, positive for volume up */
+	static int32 pendingVolumeSteps;
+	
+	/* Media key not sent yet */
+	static uint16 pendingUsage = CONSUMER_USAGE_NONE;
+	
+	/* Direction of the inner rotation in progress, 1 for clockwise (volume 
+	 * up), -1 for counter clockwise and 0 if none.
+	 */
+	static int32 volumeDirection;
+	
+	/* Inner rotation since the last volume step, in thetaFine counts, and 
+	 * accThetaFine of the previous frame.
+	 */
+	static int32 volumeRotation;
+	static int32 prevAccThetaFine;
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
 
 /*******************************************************************************
 *   External Variable Declarations
@@ -77,13 +111,22 @@ uint8 keyboardReport[KEY_RPT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0};
 extern uint16 sliderCentroid;
 
 
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+#if(CONSUMER_REPORT_ENABLE)
+	static void HidReport_UpdateConsumer(tGestureId gestureId);
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
+
 /*******************************************************************************
 * Function Name: ConvertGestureToHidReport
 ********************************************************************************
 *
 * Summary:
-* This function updates the keyboard and mouse report arrays based on the given
-* gesture id. 
+* This function updates the keyboard, mouse and consumer control report arrays
+* based on the given gesture id. 
 *
 * Parameters:
 * gestureId - Id of the detected gesture.
@@ -101,6 +144,10 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 	
 	static tGestureId prevGestureId = GESTURE_NONE;
 	
+	#if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE)
+		static uint32 prevButtonStatus = 0;
+	#endif /* #if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE) */
+	
 	uint32 i;
 
 	/* Initialize keyboard & mouse report to zero before updating with valid
@@ -119,17 +166,25 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 	{
 		case LEFT_BTN_MASK:
 			mouseReport[MOUSE_RPT_BTN_POS] |= MOUSE_RPT_LEFT_BTN_MASK; 
-			PRINT("Left Click\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_LEFT_CLICK);
 		break; 
 		
 		case RIGHT_BTN_MASK:
 			mouseReport[MOUSE_RPT_BTN_POS] |= MOUSE_RPT_RIGHT_BTN_MASK; 
-			PRINT("Right Click\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_RIGHT_CLICK);
 		break;
 			
 		case CENTRE_BTN_MASK:
+		#if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE)
+			/* The centre button is play/pause, sent once per press */
+			if(prevButtonStatus != CENTRE_BTN_MASK)
+			{
+				pendingUsage = CONSUMER_USAGE_PLAY_PAUSE;
+			}
+		#else
 			mouseReport[MOUSE_RPT_BTN_POS] |= MOUSE_RPT_MIDDLE_BTN_MASK; 
-			PRINT("Middle Click\n\r");
+		#endif /* #if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE) */
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_MIDDLE_CLICK);
 		break;
 			
 		default:
@@ -142,17 +197,33 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 	switch(gestureId)
 	{		
 	case GESTURE_LEFT_SWIPE:
+		LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_LEFT_SWIPE);
+	#if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE)
+		/* Left swipe sends out previous track, once per swipe */
+		if(prevGestureId != GESTURE_LEFT_SWIPE)
+		{
+			pendingUsage = CONSUMER_USAGE_SCAN_PREVIOUS;
+		}
+	#else
 		/* Left swipe sends out Ctrl + Shift + TAB keys to computer */
-		PRINT("Left Swipe\n\r");
 		keyboardReport[KEY_RPT_MODIF_POS] |= (KEY_RPT_LEFT_CTRL_MASK | KEY_RPT_LEFT_SHIFT_MASK); 
 		keyboardReport[KEY_RPT_KEY1_POS] = KEY_RPT_TAB_CODE;
+	#endif /* #if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE) */
 		break;
 		
 	case GESTURE_RIGHT_SWIPE:
+		LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_RIGHT_SWIPE);
+	#if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE)
+		/* Right swipe sends out next track, once per swipe */
+		if(prevGestureId != GESTURE_RIGHT_SWIPE)
+		{
+			pendingUsage = CONSUMER_USAGE_SCAN_NEXT;
+		}
+	#else
 		/* Right swipe sends out Ctrl + TAB keys to computer */
-		PRINT("Right Swipe\n\r");
 		keyboardReport[KEY_RPT_MODIF_POS] |= KEY_RPT_LEFT_CTRL_MASK; 
 		keyboardReport[KEY_RPT_KEY1_POS] = KEY_RPT_TAB_CODE;
+	#endif /* #if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE) */
 		break;
 		
 	case GESTURE_UP_SWIPE:
@@ -165,13 +236,13 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 			/* Start with higher speed the first time scroll gesture occurs. */
 			scrollUpdateThreshold = 0;
 			mouseReport[MOUSE_RPT_V_POS] = START_SCROLL_SPEED;
-			PRINT("Up Swipe\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_UP_SWIPE);
 		}
 		else if(++scrollUpdateThreshold >= CONT_SCROLL_UPDATE_FREQ)
 		{
 			/* Control scroll speed by limiting the update rate */
 			scrollUpdateThreshold = 0;
-			PRINT("Up Swipe\n\r");
+			LOG_HID_TRACE(TELEMETRY_EVENT_GESTURE, GESTURE_UP_SWIPE);
 			mouseReport[MOUSE_RPT_V_POS] = CONT_SCROLL_SPEED;
 		}
 		break;
@@ -186,13 +257,13 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 			/* Start with higher speed the first time scroll gesture occurs. */
 			scrollUpdateThreshold = 0;
 			mouseReport[MOUSE_RPT_V_POS] = -START_SCROLL_SPEED;
-			PRINT("Down Swipe\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_DOWN_SWIPE);
 		}
 		else if(++scrollUpdateThreshold >= CONT_SCROLL_UPDATE_FREQ)
 		{
 			/* Control scroll speed by limiting the update rate */
 			scrollUpdateThreshold = 0;
-			PRINT("Down Swipe\n\r");
+			LOG_HID_TRACE(TELEMETRY_EVENT_GESTURE, GESTURE_DOWN_SWIPE);
 			mouseReport[MOUSE_RPT_V_POS] = -CONT_SCROLL_SPEED;
 		}
 		break;
@@ -200,31 +271,32 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 	case GESTURE_OUTWARD_SWIPE:
 		if(prevGestureId != GESTURE_OUTWARD_SWIPE)
 		{				
-			PRINT("Outward Swipe\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_OUTWARD_SWIPE);
 		}
-		mouseReport[MOUSE_RPT_X_POS] = (int8)xPos/2;
-		mouseReport[MOUSE_RPT_Y_POS] = -(int8)yPos/2;
+		/* xPos and yPos are within -16 to 16, refer to Gestures_CalculateX() */
+		mouseReport[MOUSE_RPT_X_POS] = (int8)(xPos/2);
+		mouseReport[MOUSE_RPT_Y_POS] = (int8)(-yPos/2);
 		break;
 
 	case GESTURE_INNER_CLKWISE:
-		PRINT("Inner Clockwise\n\r");
+		LOG_HID_TRACE(TELEMETRY_EVENT_GESTURE, GESTURE_INNER_CLKWISE);
 		break;
 		
 	case GESTURE_INNER_COUNTER_CLKWISE:
-		PRINT("Inner Counter-Clockwise\n\r");
+		LOG_HID_TRACE(TELEMETRY_EVENT_GESTURE, GESTURE_INNER_COUNTER_CLKWISE);
 		break;
 		
 	case GESTURE_OUTER_CLKWISE:
 		if(prevGestureId != GESTURE_OUTER_CLKWISE)
 		{
-			PRINT("Outer Clockwise\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_OUTER_CLKWISE);
 		}
 		break;
 		
 	case GESTURE_OUTER_COUNTER_CLKWISE:
 		if(prevGestureId != GESTURE_OUTER_COUNTER_CLKWISE)
 		{
-			PRINT("Outer Counter-Clockwise\n\r");
+			LOG_HID_INFO(TELEMETRY_EVENT_GESTURE, GESTURE_OUTER_COUNTER_CLKWISE);
 		}
 		break;
 		
@@ -232,8 +304,128 @@ void ConvertGestureToHidReport(tGestureId gestureId)
 		break;
 	}	
 	
+	#if(CONSUMER_REPORT_ENABLE)
+		/* Inner rotations change the volume */
+		HidReport_UpdateConsumer(gestureId);
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+	
+	#if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE)
+		prevButtonStatus = capsenseButtonStatus;
+	#endif /* #if(CONSUMER_REPORT_ENABLE && CONSUMER_MEDIA_KEYS_ENABLE) */
+	
 	prevGestureId = gestureId;
 }
 
 
+#if(CONSUMER_REPORT_ENABLE)
+
+/*******************************************************************************
+* Function Name: HidReport_UpdateConsumer
+********************************************************************************
+*
+* Summary:
+* This function converts the inner rotation gestures to volume steps and 
+* updates the consumer control report with the next pending key.
+*
+* Parameters:
+* gestureId - Id of the detected gesture.
+*
+* Return:
+* None
+*
+* Theory:
+* The rotation of each frame is the change of the unwrapped angle accThetaFine.
+* The gesture engine reports an inner rotation gesture once per sector the 
+* finger enters, with no gesture in the frames between. The first gesture of 
+* a rotation sends one step right away, and every further 
+* CONSUMER_VOLUME_STEP_ANGLE of rotation in the direction of the gesture one
+* more, measured in every frame until the finger is released, another 
+* gesture is reported, or the rotation reverses. The rate of the steps is then
+* proportional to the angular speed. Turning back takes rotation off the next
+* step, without sending steps in the other direction before the gesture does.
+* Each key is pressed for one frame and released for the next, so that the 
+* host sees every step.
+*
+*******************************************************************************/
+static void HidReport_UpdateConsumer(tGestureId gestureId)
+{
+	int32 rotation = accThetaFine - prevAccThetaFine;
+	int32 direction = 0;
+	uint16 usage = CONSUMER_USAGE_NONE;
+	
+	prevAccThetaFine = accThetaFine;
+	
+	if(gestureId == GESTURE_INNER_CLKWISE)
+	{
+		direction = 1;
+	}
+	else if(gestureId == GESTURE_INNER_COUNTER_CLKWISE)
+	{
+		direction = -1;
+	}
+	
+	if((direction != 0) && (direction != volumeDirection))
+	{
+		/* Start of the rotation, drop the steps of the other direction */
+		volumeDirection = direction;
+		volumeRotation = 0;
+		pendingVolumeSteps = direction;
+	}
+	else if((thetaFine == INVALID_ANGLE_FINE) || ((direction == 0) && (gestureId != GESTURE_NONE)))
+	{
+		/* Released, or another gesture */
+		volumeDirection = 0;
+	}
+	else if(volumeDirection != 0)
+	{
+		/* Theta increases counter clockwise */
+		volumeRotation -= rotation * volumeDirection;
+		if(volumeRotation < 0)
+		{
+			volumeRotation = 0;
+		}
+		
+		while(volumeRotation >= (CONSUMER_VOLUME_STEP_ANGLE << CENTROID_FRAC_BITS))
+		{
+			volumeRotation -= (CONSUMER_VOLUME_STEP_ANGLE << CENTROID_FRAC_BITS);
+			pendingVolumeSteps += volumeDirection;
+		}
+		
+		if(pendingVolumeSteps > CONSUMER_MAX_PENDING_STEPS)
+		{
+			pendingVolumeSteps = CONSUMER_MAX_PENDING_STEPS;
+		}
+		else if(pendingVolumeSteps < -CONSUMER_MAX_PENDING_STEPS)
+		{
+			pendingVolumeSteps = -CONSUMER_MAX_PENDING_STEPS;
+		}
+	}
+	
+	/* Release the key of the previous frame before the next press */
+	if((consumerReport[CONSUMER_RPT_USAGE_LSB_POS] | consumerReport[CONSUMER_RPT_USAGE_MSB_POS]) == 0)
+	{
+		if(pendingUsage != CONSUMER_USAGE_NONE)
+		{
+			usage = pendingUsage;
+			pendingUsage = CONSUMER_USAGE_NONE;
+		}
+		else if(pendingVolumeSteps > 0)
+		{
+			usage = CONSUMER_USAGE_VOLUME_UP;
+			pendingVolumeSteps--;
+		}
+		else if(pendingVolumeSteps < 0)
+		{
+			usage = CONSUMER_USAGE_VOLUME_DOWN;
+			pendingVolumeSteps++;
+		}
+	}
+	
+	consumerReport[CONSUMER_RPT_USAGE_LSB_POS] = LO8(usage);
+	consumerReport[CONSUMER_RPT_USAGE_MSB_POS] = HI8(usage);
+}
+
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
+
 /* [] END OF FILE */
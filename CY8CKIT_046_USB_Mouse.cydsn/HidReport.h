@@ -128,6 +128,42 @@
 /* Mask for Middle button in the mouse */
 #define MOUSE_RPT_MIDDLE_BTN_MASK		(4)
 
+/* Macros to be used with consumer control HID report. Do not modify these 
+ * macros. 
+ */
+
+/* Indicates the position in the consumer control report array of the low and
+ * high byte of the usage. A usage of 0 releases the key.
+ */
+#define CONSUMER_RPT_USAGE_LSB_POS		(0)
+#define CONSUMER_RPT_USAGE_MSB_POS		(1)
+
+/* Usages of the consumer page (0x0C) */
+#define CONSUMER_USAGE_NONE				(0x0000u)
+#define CONSUMER_USAGE_SCAN_NEXT		(0x00B5u)
+#define CONSUMER_USAGE_SCAN_PREVIOUS	(0x00B6u)
+#define CONSUMER_USAGE_PLAY_PAUSE		(0x00CDu)
+#define CONSUMER_USAGE_VOLUME_UP		(0x00E9u)
+#define CONSUMER_USAGE_VOLUME_DOWN		(0x00EAu)
+
+/* Inner rotation by this angle sends one volume step, in theta counts (45
+ * degrees). The rotation is started with one step, so faster rotations give
+ * proportionally more steps per second.
+ */
+#define CONSUMER_VOLUME_STEP_ANGLE		(ANGLE_45)
+
+/* A step is sent as a press and a release in two frames, so a fast rotation
+ * can get ahead of the reports. At most this many steps are kept pending, so
+ * the volume stops changing soon after the rotation does.
+ */
+#define CONSUMER_MAX_PENDING_STEPS		(4)
+
+/* Enables the media keys. Left and right swipes send previous and next track
+ * instead of Ctrl + Shift + TAB and Ctrl + TAB, and the centre button sends 
+ * play/pause instead of the middle click.
+ */
+#define CONSUMER_MEDIA_KEYS_ENABLE		(DISABLED)
+
 /* These macros indicate the sector of the radial slider at which finger is at.
  */
 #define MOUSE_DIR_SOUTH_WEST			(0)
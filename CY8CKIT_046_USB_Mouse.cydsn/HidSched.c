@@ -0,0 +1,464 @@
+/*******************************************************************************
+* File Name: HidSched.c
+*
+* Version 1.0
+*
+* Description: This file schedules the HID reports on the USB IN endpoints.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "HidSched.h"
+#include "HidReport.h"
+#include "Profile.h"
+#include "Latency.h"
+#include "Timebase.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Size of the largest report */
+#define HID_MAX_RPT_SIZE				((KEY_RPT_SIZE > MOUSE_RPT_SIZE) ? KEY_RPT_SIZE : MOUSE_RPT_SIZE)
+
+#if(CONSUMER_RPT_SIZE > HID_MAX_RPT_SIZE)
+	#error "HID_MAX_RPT_SIZE must include the consumer control report"
+#endif /* #if(CONSUMER_RPT_SIZE > HID_MAX_RPT_SIZE) */
+
+
+/*******************************************************************************
+*	Data Type Definitions
+********************************************************************************/
+
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	/* Report sent on the single interface. The bytes from relativePos on are
+	 * relative values, which are sent again even if unchanged when non-zero.
+	 */
+	typedef struct
+	{
+		uint8 reportId;
+		uint8 size;
+		uint8 relativePos;
+		const uint8 *report;
+		uint8 *lastSent;
+	}tHidReportEntry;
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+
+
+/*******************************************************************************
+*   External Variable Declarations
+*******************************************************************************/
+
+/* Keyboard, Mouse and Consumer control HID report arrays, declared in 
+ * HidReport.c 
+ */
+extern uint8 keyboardReport[];
+extern int8 mouseReport[];
+#if(CONSUMER_REPORT_ENABLE)
+	extern uint8 consumerReport[];
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	/* Last report sent of each kind */
+	static uint8 lastKeyboardReport[KEY_RPT_SIZE];
+	static uint8 lastMouseReport[MOUSE_RPT_SIZE];
+	#if(CONSUMER_REPORT_ENABLE)
+		static uint8 lastConsumerReport[CONSUMER_RPT_SIZE];
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+	
+	/* Reports in priority order */
+	static const tHidReportEntry reportTable[HID_REPORT_COUNT] = 
+	{
+		[HID_REPORT_KEYBOARD] = {HID_REPORT_ID_KEYBOARD, KEY_RPT_SIZE, KEY_RPT_SIZE, 
+			(const uint8 *)keyboardReport, lastKeyboardReport},
+	#if(CONSUMER_REPORT_ENABLE)
+		[HID_REPORT_CONSUMER] = {HID_REPORT_ID_CONSUMER, CONSUMER_RPT_SIZE, CONSUMER_RPT_SIZE, 
+			consumerReport, lastConsumerReport},
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+		[HID_REPORT_MOUSE] = {HID_REPORT_ID_MOUSE, MOUSE_RPT_SIZE, MOUSE_RPT_X_POS, 
+			(const uint8 *)mouseReport, lastMouseReport}
+	};
+	
+	/* Report ID followed by the report, loaded into the endpoint */
+	static uint8 transferBuffer[HID_REPORT_ID_SIZE + HID_MAX_RPT_SIZE];
+	
+	/* Bit n is set while report n of reportTable is pending */
+	static uint32 pendingMask;
+#else
+	/* KEYBOARD_DATA_SENT, MOUSE_DATA_SENT and CONSUMER_DATA_SENT are set once
+	 * the report of the frame is loaded.
+	 */
+	static uint32 usbDataSentFlag = USB_HID_DATA_SENT;
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+
+/* Time the reports of the last frame were queued, refer to
+ * HidSched_GetPendingMs()
+ */
+static uint32 queueMs;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	static bool HidSched_IsPending(const tHidReportEntry *entry);
+	static void HidSched_Load(tHidReport report);
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: HidSched_Reset
+********************************************************************************
+* Summary:
+*  Drops the pending reports, called when the USB is disconnected.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HidSched_Reset(void)
+{
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	pendingMask = 0;
+	
+	/* The host starts from released keys and buttons */
+	memset(lastKeyboardReport, 0, sizeof(lastKeyboardReport));
+	memset(lastMouseReport, 0, sizeof(lastMouseReport));
+	#if(CONSUMER_REPORT_ENABLE)
+		memset(lastConsumerReport, 0, sizeof(lastConsumerReport));
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+#else
+	usbDataSentFlag = USB_HID_DATA_SENT;
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_IsAcked
+********************************************************************************
+* Summary:
+*  Checks if the host acknowledged a report, i.e. if the drivers of the device
+*  are installed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true if an endpoint was acknowledged.
+*
+*******************************************************************************/
+bool HidSched_IsAcked(void)
+{
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	return (USBFS_GetEPAckState(HID_END_POINT) != 0);
+#else
+	#if(CONSUMER_REPORT_ENABLE)
+		if(USBFS_GetEPAckState(CONSUMER_END_POINT) != 0)
+		{
+			return true;
+		}
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+	
+	return ((USBFS_GetEPAckState(KEYBOARD_END_POINT) != 0) || (USBFS_GetEPAckState(MOUSE_END_POINT) != 0));
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_LoadInitial
+********************************************************************************
+* Summary:
+*  Loads the initial data into the endpoints when the device first enumerates.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HidSched_LoadInitial(void)
+{
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	HidSched_Load(HID_REPORT_KEYBOARD);
+#else
+	USBFS_LoadInEP(KEYBOARD_END_POINT, (uint8 *)keyboardReport, KEY_RPT_SIZE);
+	USBFS_LoadInEP(MOUSE_END_POINT, (uint8 *)mouseReport, MOUSE_RPT_SIZE);
+	#if(CONSUMER_REPORT_ENABLE)
+		USBFS_LoadInEP(CONSUMER_END_POINT, consumerReport, CONSUMER_RPT_SIZE);
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_Queue
+********************************************************************************
+* Summary:
+*  Queues the reports of the frame, called after ConvertGestureToHidReport().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  With separate interfaces both reports are sent every frame. On the single
+*  interface only the reports that carry new data are queued, so a frame with
+*  no change does not use the endpoint at all.
+*
+*******************************************************************************/
+void HidSched_Queue(void)
+{
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	uint32 report;
+	
+	queueMs = Timebase_GetMs();
+	
+	for(report = 0; report < HID_REPORT_COUNT; report++)
+	{
+		if(HidSched_IsPending(&reportTable[report]))
+		{
+			pendingMask |= (1u << report);
+		}
+	}
+#else
+	queueMs = Timebase_GetMs();
+	usbDataSentFlag = USB_HID_DATA_SENT_FLAG_CLEAR;
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_IsIdle
+********************************************************************************
+* Summary:
+*  Checks if all the queued reports are loaded, i.e. if the next frame can 
+*  update the report arrays.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true if no report is pending.
+*
+*******************************************************************************/
+bool HidSched_IsIdle(void)
+{
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	return (pendingMask == 0);
+#else
+	return (usbDataSentFlag == USB_HID_DATA_SENT);
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_GetPendingMs
+********************************************************************************
+* Summary:
+*  Returns how long the queued reports have been waiting for the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - time since the reports were queued in ms, 0 if all of them are
+*  loaded.
+*
+* Theory:
+*  The main loop only processes a frame once the reports of the previous
+*  frame are loaded, so the reports still pending are always those of the
+*  last HidSched_Queue().
+*
+*******************************************************************************/
+uint32 HidSched_GetPendingMs(void)
+{
+	return HidSched_IsIdle() ? 0 : (Timebase_GetMs() - queueMs);
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_Service
+********************************************************************************
+* Summary:
+*  Loads the pending reports into the endpoints that the host emptied. Called
+*  on every iteration of the main loop once the drivers are installed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  On the single interface one endpoint state is checked per iteration and the
+*  highest priority pending report is loaded, so a key press goes out before 
+*  a media key, and a media key before a mouse movement of the same frame.
+*
+*******************************************************************************/
+void HidSched_Service(void)
+{
+#if(HID_SINGLE_INTERFACE_ENABLE)
+	uint32 report;
+	
+	if((pendingMask != 0) && (USBFS_GetEPState(HID_END_POINT) == USBFS_EVENT_PENDING))
+	{
+		for(report = 0; (pendingMask & (1u << report)) == 0; report++)
+		{
+		}
+		
+		HidSched_Load((tHidReport)report);
+		pendingMask &= ~(1u << report);
+	}
+#else
+	if(usbDataSentFlag == USB_HID_DATA_SENT)
+	{
+		return;
+	}
+	
+	/* Send Keyboard data to PC, if there is an USB keyboard endpoint event pending */
+	if(USBFS_GetEPState(KEYBOARD_END_POINT) == USBFS_EVENT_PENDING)
+	{
+		PROFILE_BEGIN(PROFILE_USB);
+		USBFS_LoadInEP(KEYBOARD_END_POINT, (uint8 *)keyboardReport, KEY_RPT_SIZE);
+		PROFILE_END(PROFILE_USB);
+		Latency_LoadInEP(KEYBOARD_DATA_SENT);
+		usbDataSentFlag |= KEYBOARD_DATA_SENT;
+	}
+	
+	/* Send Mouse data to PC, if there is an USB mouse endpoint event pending */
+	if(USBFS_GetEPState(MOUSE_END_POINT) == USBFS_EVENT_PENDING)
+	{
+		PROFILE_BEGIN(PROFILE_USB);
+		USBFS_LoadInEP(MOUSE_END_POINT, (uint8 *)mouseReport, MOUSE_RPT_SIZE);
+		PROFILE_END(PROFILE_USB);
+		Latency_LoadInEP(MOUSE_DATA_SENT);
+		usbDataSentFlag |= MOUSE_DATA_SENT;
+	}
+	
+	#if(CONSUMER_REPORT_ENABLE)
+		/* Send Consumer control data to PC, if there is an USB consumer endpoint event pending */
+		if(USBFS_GetEPState(CONSUMER_END_POINT) == USBFS_EVENT_PENDING)
+		{
+			PROFILE_BEGIN(PROFILE_USB);
+			USBFS_LoadInEP(CONSUMER_END_POINT, consumerReport, CONSUMER_RPT_SIZE);
+			PROFILE_END(PROFILE_USB);
+			Latency_LoadInEP(CONSUMER_DATA_SENT);
+			usbDataSentFlag |= CONSUMER_DATA_SENT;
+		}
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+}
+
+
+#if(HID_SINGLE_INTERFACE_ENABLE)
+
+/*******************************************************************************
+* Function Name: HidSched_IsPending
+********************************************************************************
+* Summary:
+*  Checks if a report carries new data for the host.
+*
+* Parameters:
+*  entry - report to check.
+*
+* Return:
+*  bool - true if the report differs from the last one sent, or has non-zero
+*  relative values.
+*
+*******************************************************************************/
+static bool HidSched_IsPending(const tHidReportEntry *entry)
+{
+	uint32 i;
+	
+	if(memcmp(entry->report, entry->lastSent, entry->size) != 0)
+	{
+		return true;
+	}
+	
+	for(i = entry->relativePos; i < entry->size; i++)
+	{
+		if(entry->report[i] != 0)
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+
+/*******************************************************************************
+* Function Name: HidSched_Load
+********************************************************************************
+* Summary:
+*  Loads a report with its report ID into the endpoint of the single interface.
+*
+* Parameters:
+*  report - report to load.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HidSched_Load(tHidReport report)
+{
+	const tHidReportEntry *entry = &reportTable[report];
+	
+	transferBuffer[0] = entry->reportId;
+	memcpy(&transferBuffer[HID_REPORT_ID_SIZE], entry->report, entry->size);
+	memcpy(entry->lastSent, entry->report, entry->size);
+	
+	PROFILE_BEGIN(PROFILE_USB);
+	USBFS_LoadInEP(HID_END_POINT, transferBuffer, HID_REPORT_ID_SIZE + entry->size);
+	PROFILE_END(PROFILE_USB);
+	Latency_LoadInEP(1u << report);
+}
+
+#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,390 @@
+/*******************************************************************************
+* File Name: Latency.c
+*
+* Version 1.0
+*
+* Description: This file contains the touch to USB latency measurement.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "Latency.h"
+#include "Profile.h"
+#include "Timebase.h"
+#include "stdbool.h"
+#include "string.h"
+
+
+#if(LATENCY_ENABLE)
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* State of the frame being measured */
+#define LATENCY_STATE_IDLE					(0)
+#define LATENCY_STATE_DECIDED				(1)
+#define LATENCY_STATE_LOADED				(2)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Names of the segments in the dump */
+static const char8 * const segmentName[LATENCY_SEGMENTS] = 
+{
+	[LATENCY_SCAN] = "latency_scan",
+	[LATENCY_PROCESS] = "latency_process",
+	[LATENCY_QUEUE] = "latency_queue",
+	[LATENCY_USB] = "latency_usb",
+	[LATENCY_TOTAL] = "latency_total",
+	[LATENCY_CONTACT] = "latency_contact"
+};
+
+/* Statistics of the current window and of the last complete window */
+static tProfileStat segmentStat[LATENCY_SEGMENTS];
+static tProfileStat lastSegmentStat[LATENCY_SEGMENTS];
+static bool isLastWindowValid;
+
+/* Start and completion of the scan in progress */
+static uint32 scanStart, scanComplete;
+static bool isScanning;
+
+/* Time stamps of the frame being measured, in system clock cycles */
+static uint32 frameScanStart, frameScanComplete, frameDecision, frameLoad;
+static uint32 frameState = LATENCY_STATE_IDLE;
+static uint32 frameLoadedFlag, frameAckFlag;
+static bool isFrameContact, wasSensorActive;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void Latency_Complete(uint32 ackTime);
+
+#endif /* #if(LATENCY_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: Latency_Poll
+********************************************************************************
+* Summary:
+*  Detects the completion of the scan and the ACK of the loaded reports. Must
+*  be called on every iteration of the main loop.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  Events are time stamped when they are detected, so the resolution is one
+*  iteration of the main loop.
+*
+*******************************************************************************/
+void Latency_Poll(void)
+{
+	#if(LATENCY_ENABLE)
+		uint32 now = Timebase_GetCycles();
+		
+		if(isScanning && (CapSense_IsBusy() == 0))
+		{
+			scanComplete = now;
+			isScanning = false;
+		}
+		
+		if(frameState == LATENCY_STATE_LOADED)
+		{
+		#if(HID_SINGLE_INTERFACE_ENABLE)
+			/* Only the reports with new data are sent, in priority order. The
+			 * frame completes with the ACK of the first one.
+			 */
+			if(USBFS_GetEPAckState(HID_END_POINT))
+			{
+				Latency_Complete(now);
+			}
+		#else
+			if((frameLoadedFlag & KEYBOARD_DATA_SENT) && USBFS_GetEPAckState(KEYBOARD_END_POINT))
+			{
+				frameAckFlag |= KEYBOARD_DATA_SENT;
+			}
+			if((frameLoadedFlag & MOUSE_DATA_SENT) && USBFS_GetEPAckState(MOUSE_END_POINT))
+			{
+				frameAckFlag |= MOUSE_DATA_SENT;
+			}
+			#if(CONSUMER_REPORT_ENABLE)
+				if((frameLoadedFlag & CONSUMER_DATA_SENT) && USBFS_GetEPAckState(CONSUMER_END_POINT))
+				{
+					frameAckFlag |= CONSUMER_DATA_SENT;
+				}
+			#endif /* #if(CONSUMER_REPORT_ENABLE) */
+			
+			if(frameAckFlag == USB_HID_DATA_SENT)
+			{
+				Latency_Complete(now);
+			}
+		#endif /* #if(HID_SINGLE_INTERFACE_ENABLE) */
+		}
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Latency_ScanStart
+********************************************************************************
+* Summary:
+*  Time stamps the start of a scan. Must be called after 
+*  CapSense_ScanEnabledWidgets().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Latency_ScanStart(void)
+{
+	#if(LATENCY_ENABLE)
+		scanStart = Timebase_GetCycles();
+		isScanning = true;
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Latency_FrameStart
+********************************************************************************
+* Summary:
+*  Takes over the time stamps of the completed scan for the frame being 
+*  processed. Must be called before the scan results are processed. The time
+*  stamps of a frame whose reports wait for the acknowledge are kept.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Latency_FrameStart(void)
+{
+	#if(LATENCY_ENABLE)
+		if(isScanning)
+		{
+			scanComplete = Timebase_GetCycles();
+			isScanning = false;
+		}
+		
+		if(frameState != LATENCY_STATE_LOADED)
+		{
+			frameScanStart = scanStart;
+			frameScanComplete = scanComplete;
+		}
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Latency_Decision
+********************************************************************************
+* Summary:
+*  Time stamps the gesture decision. Must be called after the HID reports of 
+*  the frame are updated. A frame whose reports were not loaded yet is 
+*  dropped from the measurement.
+*
+* Parameters:
+*  isAnySensorActive - sensor status of the frame, used to detect the first
+*                      frame of a touch
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Latency_Decision(uint32 isAnySensorActive)
+{
+	#if(LATENCY_ENABLE)
+		if(frameState != LATENCY_STATE_LOADED)
+		{
+			frameDecision = Timebase_GetCycles();
+			frameState = LATENCY_STATE_DECIDED;
+			frameLoadedFlag = 0;
+			frameAckFlag = 0;
+			isFrameContact = (isAnySensorActive && !wasSensorActive);
+		}
+		
+		wasSensorActive = (isAnySensorActive != 0);
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Latency_LoadInEP
+********************************************************************************
+* Summary:
+*  Time stamps the load of a report. Must be called after USBFS_LoadInEP().
+*
+* Parameters:
+*  dataSentFlag - KEYBOARD_DATA_SENT, MOUSE_DATA_SENT or CONSUMER_DATA_SENT,
+*                 or the bit of the report in single interface mode, refer to
+*                 HidSched.h.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Latency_LoadInEP(uint32 dataSentFlag)
+{
+	#if(LATENCY_ENABLE)
+		if(frameState == LATENCY_STATE_DECIDED)
+		{
+			frameLoad = Timebase_GetCycles();
+			frameState = LATENCY_STATE_LOADED;
+		}
+		
+		if(frameState == LATENCY_STATE_LOADED)
+		{
+			frameLoadedFlag |= dataSentFlag;
+			frameAckFlag &= ~dataSentFlag;
+		}
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Latency_Dump
+********************************************************************************
+* Summary:
+*  Prints the statistics of the last complete window, or of the current window
+*  if no window is complete yet, refer to Profile_PrintStat() for the format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Latency_Dump(void)
+{
+	#if(LATENCY_ENABLE)
+		uint32 segment;
+		
+		for(segment = 0; segment < LATENCY_SEGMENTS; segment++)
+		{
+			Profile_PrintStat(segmentName[segment], isLastWindowValid ? &lastSegmentStat[segment] : &segmentStat[segment]);
+		}
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Latency_Clear
+********************************************************************************
+* Summary:
+*  Clears the statistics of the current and of the last complete window. The 
+*  frame being measured is still completed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Latency_Clear(void)
+{
+	#if(LATENCY_ENABLE)
+		uint32 segment;
+		
+		for(segment = 0; segment < LATENCY_SEGMENTS; segment++)
+		{
+			Profile_ClearStat(&segmentStat[segment]);
+		}
+		isLastWindowValid = false;
+	#endif /* #if(LATENCY_ENABLE) */
+}
+
+
+#if(LATENCY_ENABLE)
+
+/*******************************************************************************
+* Function Name: Latency_Complete
+********************************************************************************
+* Summary:
+*  Accumulates the segments of the measured frame once all its reports are 
+*  acknowledged, and starts a new window when the current one is full.
+*
+* Parameters:
+*  ackTime - time stamp of the ACK
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Latency_Complete(uint32 ackTime)
+{
+	uint32 segment;
+	
+	Profile_Accumulate(&segmentStat[LATENCY_SCAN], frameScanComplete - frameScanStart);
+	Profile_Accumulate(&segmentStat[LATENCY_PROCESS], frameDecision - frameScanComplete);
+	Profile_Accumulate(&segmentStat[LATENCY_QUEUE], frameLoad - frameDecision);
+	Profile_Accumulate(&segmentStat[LATENCY_USB], ackTime - frameLoad);
+	Profile_Accumulate(&segmentStat[LATENCY_TOTAL], ackTime - frameScanStart);
+	
+	if(isFrameContact)
+	{
+		Profile_Accumulate(&segmentStat[LATENCY_CONTACT], ackTime - frameScanStart);
+	}
+	
+	frameState = LATENCY_STATE_IDLE;
+	
+	if(segmentStat[LATENCY_TOTAL].count == LATENCY_WINDOW)
+	{
+		memcpy(lastSegmentStat, segmentStat, sizeof(segmentStat));
+		isLastWindowValid = true;
+		
+		for(segment = 0; segment < LATENCY_SEGMENTS; segment++)
+		{
+			Profile_ClearStat(&segmentStat[segment]);
+		}
+	}
+}
+
+#endif /* #if(LATENCY_ENABLE) */
+
+
+/* [] END OF FILE */
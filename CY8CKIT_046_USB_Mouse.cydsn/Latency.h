@@ -0,0 +1,97 @@
+/*****************************************************************************
+* File Name		: Latency.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  Latency.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LATENCY_H		/* Guard to prevent multiple inclusions */
+#define LATENCY_H
+
+#include "cytypes.h"
+#include "main.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables the latency measurement. The host build enables it 
+ * per target.
+ */
+#ifndef LATENCY_ENABLE
+	#define LATENCY_ENABLE					(DISABLED)
+#endif /* #ifndef LATENCY_ENABLE */
+
+/* Measured segments of a frame:
+ * LATENCY_SCAN - scan start to scan complete
+ * LATENCY_PROCESS - scan complete to gesture decision and HID report
+ * LATENCY_QUEUE - decision to the first USBFS_LoadInEP() of the reports
+ * LATENCY_USB - first USBFS_LoadInEP() to the ACK of all the reports
+ * LATENCY_TOTAL - scan start to the ACK of all the reports
+ * LATENCY_CONTACT - as LATENCY_TOTAL, for the first frame of each touch only
+ */
+#define LATENCY_SCAN						(0)
+#define LATENCY_PROCESS						(1)
+#define LATENCY_QUEUE						(2)
+#define LATENCY_USB							(3)
+#define LATENCY_TOTAL						(4)
+#define LATENCY_CONTACT						(5)
+#define LATENCY_SEGMENTS					(6)
+
+/* Number of frames after which the statistics restart. The statistics of the
+ * last complete window are kept for the dump.
+ */
+#define LATENCY_WINDOW						(1024)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void Latency_Poll(void);
+void Latency_ScanStart(void);
+void Latency_FrameStart(void);
+void Latency_Decision(uint32 isAnySensorActive);
+void Latency_LoadInEP(uint32 dataSentFlag);
+void Latency_Dump(void);
+void Latency_Clear(void);
+
+
+#endif /* #ifndef LATENCY_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,484 @@
+/*******************************************************************************
+* File Name: LedAnim.c
+*
+* Version 1.0
+*
+* Description: This file contains the LED animation engine, which fades the PWM
+*               compare values toward their targets from the SysTick interrupt
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "LedAnim.h"
+#include "stdbool.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Fractional bits of the channel levels, so that slow ramps still progress.
+ * A full scale compare value of 65535 still fits an int32.
+ */
+#define LED_ANIM_FRAC_BITS				(15)
+
+
+/*******************************************************************************
+*	Local Data Type Definitions
+********************************************************************************/
+
+/* Intent posted by the main loop */
+typedef struct
+{
+	uint16 compare[LED_CHANNELS];
+	tLedEffect effect;
+	uint32 periodMs;
+}tLedIntent;
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Last intent posted, and set while an overlay is shown instead. Only 
+ * accessed by the main loop.
+ */
+static uint16 baseCompare[LED_CHANNELS];
+static tLedEffect baseEffect;
+static uint32 basePeriodMs;
+static bool isOverlayOn;
+
+#if(LED_ANIM_ENABLE)
+
+/* Mailbox from the main loop to the SysTick interrupt. The main loop writes 
+ * the slot that is not published and then publishes it by incrementing the
+ * sequence number, so the interrupt never reads a slot that is being written.
+ */
+static volatile tLedIntent mailbox[2];
+static volatile uint8 mailboxSeq;
+
+/* The following variables are only accessed by the SysTick interrupt */
+
+/* Last sequence number taken from the mailbox */
+static uint8 mailboxSeen;
+
+/* Effect in progress, its target and its ramp or blink time in ms */
+static tLedEffect animEffect;
+static uint16 target[LED_CHANNELS];
+static uint32 rampMs;
+
+/* Channel levels and their change per ms, with LED_ANIM_FRAC_BITS fraction */
+static int32 level[LED_CHANNELS];
+static int32 step[LED_CHANNELS];
+
+/* Ms left of the current ramp or blink phase */
+static uint32 msLeft;
+
+/* Set while breathing or blinking towards the target, clear towards off */
+static bool isTowardsTarget;
+
+/* Set when a fade has completed and the levels are held */
+static bool isIdle = true;
+
+#endif /* #if(LED_ANIM_ENABLE) */
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void LedAnim_Publish(const uint16 *compare, tLedEffect effect, uint32 periodMs);
+
+#if(LED_ANIM_ENABLE)
+
+static void LedAnim_SysTickCallback(void);
+static void LedAnim_Start(const volatile tLedIntent *intent);
+static void LedAnim_Ramp(bool isToTarget);
+static void LedAnim_Write(void);
+
+#endif /* #if(LED_ANIM_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: LedAnim_Init
+********************************************************************************
+* Summary:
+*  Registers the engine in the SysTick interrupt. Timebase_Init() must have 
+*  started the SysTick timer.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedAnim_Init(void)
+{
+	#if(LED_ANIM_ENABLE)
+		(void)CySysTickSetCallback(LED_ANIM_SYSTICK_CALLBACK, LedAnim_SysTickCallback);
+	#endif /* #if(LED_ANIM_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_Post
+********************************************************************************
+* Summary:
+*  Posts new target compare values and the effect used to show them. While an
+*  overlay is shown, the intent is kept and shown when the overlay is cleared.
+*
+* Parameters:
+*  compare - PWM compare values of the red, green and blue channels
+*  effect - effect used to show the target
+*  periodMs - fade time, or breathe/blink period in milliseconds
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedAnim_Post(const uint16 *compare, tLedEffect effect, uint32 periodMs)
+{
+	uint32 channel;
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		baseCompare[channel] = compare[channel];
+	}
+	baseEffect = effect;
+	basePeriodMs = periodMs;
+	
+	if(!isOverlayOn)
+	{
+		LedAnim_Publish(compare, effect, periodMs);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_SetOverlay
+********************************************************************************
+* Summary:
+*  Shows an overlay, e.g. a status code, in place of the posted intent until
+*  LedAnim_ClearOverlay() is called.
+*
+* Parameters:
+*  compare - PWM compare values of the red, green and blue channels
+*  effect - effect used to show the overlay
+*  periodMs - fade time, or breathe/blink period in milliseconds
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedAnim_SetOverlay(const uint16 *compare, tLedEffect effect, uint32 periodMs)
+{
+	isOverlayOn = true;
+	LedAnim_Publish(compare, effect, periodMs);
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_ClearOverlay
+********************************************************************************
+* Summary:
+*  Removes the overlay and shows the last posted intent again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedAnim_ClearOverlay(void)
+{
+	if(isOverlayOn)
+	{
+		isOverlayOn = false;
+		LedAnim_Publish(baseCompare, baseEffect, basePeriodMs);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_Publish
+********************************************************************************
+* Summary:
+*  Hands the intent to be shown to the SysTick interrupt. The effect starts 
+*  from the current levels at the next millisecond tick and replaces the 
+*  effect in progress.
+*
+* Parameters:
+*  compare - PWM compare values of the red, green and blue channels
+*  effect - effect used to show the target
+*  periodMs - fade time, or breathe/blink period in milliseconds
+*
+* Return:
+*  None
+*
+* Theory:
+*  Called from the main loop only. Intents posted faster than the interrupt
+*  takes them replace each other, only the last one is shown. The published 
+*  slot is only read by the interrupt, so it can be compared here.
+*
+*******************************************************************************/
+static void LedAnim_Publish(const uint16 *compare, tLedEffect effect, uint32 periodMs)
+{
+	#if(LED_ANIM_ENABLE)
+		volatile tLedIntent *intent = &mailbox[mailboxSeq & 1u];
+		uint32 channel;
+		
+		/* Do not restart the effect in progress when the same intent is posted
+		 * again, e.g. by a caller that posts every frame.
+		 */
+		if((intent->effect == effect) && (intent->periodMs == periodMs) &&
+			(intent->compare[LED_RED] == compare[LED_RED]) &&
+			(intent->compare[LED_GREEN] == compare[LED_GREEN]) &&
+			(intent->compare[LED_BLUE] == compare[LED_BLUE]))
+		{
+			return;
+		}
+		
+		intent = &mailbox[(mailboxSeq + 1u) & 1u];
+		for(channel = 0; channel < LED_CHANNELS; channel++)
+		{
+			intent->compare[channel] = compare[channel];
+		}
+		intent->effect = effect;
+		intent->periodMs = periodMs;
+		
+		/* Publish the slot */
+		mailboxSeq++;
+	#else
+		(void)effect;
+		(void)periodMs;
+		
+		LedDriver_Write(compare);
+	#endif /* #if(LED_ANIM_ENABLE) */
+}
+
+
+#if(LED_ANIM_ENABLE)
+
+/*******************************************************************************
+* Function Name: LedAnim_SysTickCallback
+********************************************************************************
+* Summary:
+*  SysTick interrupt callback, called every millisecond. Takes a new intent 
+*  from the mailbox and advances the effect in progress.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedAnim_SysTickCallback(void)
+{
+	uint8 seq = mailboxSeq;
+	uint32 channel;
+	
+	if(seq != mailboxSeen)
+	{
+		mailboxSeen = seq;
+		LedAnim_Start(&mailbox[seq & 1u]);
+	}
+	
+	if(isIdle)
+	{
+		return;
+	}
+	
+	if(animEffect == LED_EFFECT_BLINK)
+	{
+		if(--msLeft == 0)
+		{
+			LedAnim_Ramp(!isTowardsTarget);
+		}
+		return;
+	}
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		level[channel] += step[channel];
+	}
+	
+	if(--msLeft == 0)
+	{
+		/* End the ramp exactly on its end value */
+		for(channel = 0; channel < LED_CHANNELS; channel++)
+		{
+			level[channel] = isTowardsTarget ? ((int32)target[channel] << LED_ANIM_FRAC_BITS) : 0;
+		}
+		
+		if(animEffect == LED_EFFECT_BREATHE)
+		{
+			LedAnim_Ramp(!isTowardsTarget);
+		}
+		else
+		{
+			/* Fade completed, hold the target */
+			isIdle = true;
+		}
+	}
+	
+	LedAnim_Write();
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_Start
+********************************************************************************
+* Summary:
+*  Starts the effect of an intent from the current levels.
+*
+* Parameters:
+*  intent - intent taken from the mailbox
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedAnim_Start(const volatile tLedIntent *intent)
+{
+	uint32 channel;
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		target[channel] = intent->compare[channel];
+	}
+	animEffect = intent->effect;
+	
+	/* Breathe and blink use one ramp or phase per half period */
+	rampMs = intent->periodMs;
+	if(animEffect != LED_EFFECT_FADE)
+	{
+		rampMs /= 2;
+	}
+	
+	if(rampMs == 0)
+	{
+		/* Nothing to animate, show the target */
+		for(channel = 0; channel < LED_CHANNELS; channel++)
+		{
+			level[channel] = (int32)target[channel] << LED_ANIM_FRAC_BITS;
+		}
+		isIdle = true;
+		LedAnim_Write();
+	}
+	else
+	{
+		isIdle = false;
+		LedAnim_Ramp(true);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_Ramp
+********************************************************************************
+* Summary:
+*  Starts a ramp, or a blink phase, towards the target or towards off.
+*
+* Parameters:
+*  isToTarget - true to go towards the target, false to go towards off
+*
+* Return:
+*  None
+*
+* Theory:
+*  The division is done once per ramp, every tick only adds the step.
+*
+*******************************************************************************/
+static void LedAnim_Ramp(bool isToTarget)
+{
+	uint32 channel;
+	int32 end;
+	
+	isTowardsTarget = isToTarget;
+	msLeft = rampMs;
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		end = isToTarget ? ((int32)target[channel] << LED_ANIM_FRAC_BITS) : 0;
+		
+		if(animEffect == LED_EFFECT_BLINK)
+		{
+			level[channel] = end;
+		}
+		else
+		{
+			step[channel] = (end - level[channel]) / (int32)rampMs;
+		}
+	}
+	
+	if(animEffect == LED_EFFECT_BLINK)
+	{
+		LedAnim_Write();
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LedAnim_Write
+********************************************************************************
+* Summary:
+*  Writes the channel levels to the LED driver, which only updates the PWMs
+*  whose compare value changed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedAnim_Write(void)
+{
+	uint16 compare[LED_CHANNELS];
+	uint32 channel;
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		compare[channel] = (uint16)(level[channel] >> LED_ANIM_FRAC_BITS);
+	}
+	
+	LedDriver_Write(compare);
+}
+
+#endif /* #if(LED_ANIM_ENABLE) */
+
+
+/* [] END OF FILE */
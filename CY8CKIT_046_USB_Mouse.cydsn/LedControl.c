@@ -37,9 +37,10 @@
 * indemnify Cypress against all liability.
 *******************************************************************************/
 
-#include "project.h"
+#include "Platform.h"
 #include "LedControl.h"
 #include "main.h"
+#include "Log.h"
 
 
 /*******************************************************************************
@@ -50,25 +51,102 @@ static bool isRgbLedOn = false;
 static tLedColor ledColor = INIT_LED_COLOR;
 static tBrightLevel brightness = INIT_BRIGHT_LEVEL;
 
+/* accThetaFine of the previous frame, to get the rotation of each frame */
+static int32 prevAccThetaFine;
 
-/*******************************************************************************
-*   External Variable Declarations
-*******************************************************************************/
+#if(LED_HUE_MODE_ENABLE)
+	/* Hue of COLOR_HUE, 0 to LED_HUE_FINE_TURN - 1 thetaFine counts */
+	static int32 hueFine;
+#else
+	/* Brightness dialed on the outer ring, with LED_DIAL_FRAC_BITS fractional
+	 * bits. brightness follows it with hysteresis.
+	 */
+	static int32 brightnessFine;
+#endif /* #if(LED_HUE_MODE_ENABLE) */
 
+/* PWM compare value of a fully on channel per brightness level, i.e. the 
+ * CIE 1931 lightness L = 100 * level / 255 converted to luminance:
+ *   Y = ((L + 16) / 116)^3 for L > 8, else Y = L / 903.3
+ *   compare = round(LED_MAX_COMPARE * Y)
+ * Regenerate the table when LED_MAX_COMPARE is changed.
+ */
+static const uint16 lightnessToCompare[BRIGHT_LEVEL_MAX + 1] = 
+{
+	    0,    12,    24,    36,    49,    61,    73,    85,
+	   97,   109,   122,   134,   146,   158,   170,   182,
+	  194,   207,   219,   231,   243,   255,   268,   281,
+	  294,   308,   322,   337,   352,   368,   384,   400,
+	  417,   435,   453,   471,   490,   509,   529,   550,
+	  571,   592,   614,   637,   660,   683,   707,   732,
+	  758,   783,   810,   837,   865,   893,   922,   951,
+	  981,  1012,  1043,  1075,  1108,  1141,  1175,  1210,
+	 1245,  1281,  1318,  1355,  1393,  1432,  1472,  1512,
+	 1553,  1594,  1637,  1680,  1724,  1768,  1814,  1860,
+	 1907,  1955,  2003,  2053,  2103,  2154,  2206,  2258,
+	 2312,  2366,  2421,  2477,  2534,  2591,  2650,  2709,
+	 2770,  2831,  2893,  2956,  3020,  3085,  3150,  3217,
+	 3284,  3353,  3422,  3493,  3564,  3637,  3710,  3784,
+	 3860,  3936,  4013,  4091,  4171,  4251,  4332,  4415,
+	 4498,  4582,  4668,  4755,  4842,  4931,  5021,  5111,
+	 5203,  5296,  5390,  5486,  5582,  5680,  5778,  5878,
+	 5979,  6081,  6184,  6288,  6394,  6500,  6608,  6717,
+	 6828,  6939,  7052,  7166,  7281,  7397,  7514,  7633,
+	 7753,  7875,  7997,  8121,  8246,  8372,  8500,  8629,
+	 8759,  8891,  9023,  9157,  9293,  9430,  9568,  9707,
+	 9848,  9990, 10134, 10279, 10425, 10573, 10722, 10872,
+	11024, 11177, 11332, 11488, 11646, 11805, 11965, 12127,
+	12290, 12455, 12621, 12789, 12958, 13128, 13301, 13474,
+	13649, 13826, 14004, 14184, 14365, 14548, 14732, 14918,
+	15105, 15294, 15485, 15677, 15871, 16066, 16263, 16461,
+	16662, 16863, 17067, 17272, 17478, 17686, 17896, 18108,
+	18321, 18536, 18752, 18971, 19190, 19412, 19635, 19860,
+	20087, 20316, 20546, 20778, 21011, 21247, 21484, 21723,
+	21963, 22206, 22450, 22696, 22944, 23193, 23445, 23698,
+	23953, 24210, 24468, 24729, 24991, 25255, 25521, 25789,
+	26059, 26330, 26604, 26879, 27157, 27436, 27717, 28000
+};
 
-/* Indicates the shift or delta in the slider centroid, accumulated over
- * multiple scans. 
+/* Duty ratio of the red, green and blue channels per color. The ratios apply
+ * to the luminance, so the channels are mixed after the lightness conversion.
+ * The colors are only approximate.
  */
-extern uint32 accSliderDelta;
+static const tLedRatio colorRatio[LED_COLORS] = 
+{
+	{0,					0,					0},					/* COLOR_OFF */
+	{LED_RATIO_FULL,	0,					LED_RATIO_FULL},	/* COLOR_VIOLET */
+	{LED_RATIO_FULL/4,	0,					LED_RATIO_FULL},	/* COLOR_INDIGO */
+	{0,					0,					LED_RATIO_FULL},	/* COLOR_BLUE */
+	{0,					LED_RATIO_FULL,		0},					/* COLOR_GREEN */
+	{LED_RATIO_FULL,	LED_RATIO_FULL,		0},					/* COLOR_YELLOW */
+	{LED_RATIO_FULL,	LED_RATIO_FULL/2,	0},					/* COLOR_ORANGE */
+	{LED_RATIO_FULL,	0,					0},					/* COLOR_RED */
+	{LED_RATIO_FULL,	LED_RATIO_FULL,		LED_RATIO_FULL}		/* COLOR_WHITE */
+};
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static bool LedControl_GetRotation(int32 *rotation);
+
+#if(LED_HUE_MODE_ENABLE)
+	static void LedControl_StepBrightness(bool isBrighter);
+	static void LedControl_DialHue(int32 rotation);
+	static void LedControl_HsvToRatio(uint32 hue, uint32 saturation, tLedRatio *ratio);
+#else
+	static void LedControl_DialBrightness(bool isDialing, int32 rotation);
+#endif /* #if(LED_HUE_MODE_ENABLE) */
 
 
 /*******************************************************************************
 * Function Name: UpdateLedColor
 ********************************************************************************
 * Summary:
-*  Changes the color of the onboard RGB LED depending on the gesture 
-*  value passed to the function. This function also saves the new LED color 
-*  information in the global variable prevLEDColor.
+*  Changes the color of the onboard RGB LED depending on the gesture
+*  value passed to the function. The selected color and brightness are kept
+*  in the static variables ledColor and brightness of this file, so that the
+*  centre button restores them when it turns the LED back on.
 *
 * Parameters:
 *  gestureId - Id of the gesture detected.
@@ -79,6 +157,9 @@ extern uint32 accSliderDelta;
 *******************************************************************************/
 void UpdateLedColor(tGestureId gestureId)
 {
+	int32 rotation;
+	bool isDialing = LedControl_GetRotation(&rotation);
+	
 	if(capsenseButtonStatus == CENTRE_BTN_MASK)
 	{
 		/* Centre button is used to turn on/off the RGB LED */
@@ -93,195 +174,64 @@ void UpdateLedColor(tGestureId gestureId)
 	}
 	else if(isRgbLedOn)
 	{
+	#if(LED_HUE_MODE_ENABLE)
+		/* The outer ring dials the hue, the inner ring steps the brightness */
+		if(isDialing)
+		{
+			LedControl_DialHue(rotation);
+		}
+		
+		switch (gestureId)
+		{
+		case GESTURE_INNER_CLKWISE:
+			LedControl_StepBrightness(true);
+			break;
+			
+		case GESTURE_INNER_COUNTER_CLKWISE:
+			LedControl_StepBrightness(false);
+			break;
+			
+		default:
+			break;
+		}
+	#else
+		/* The outer ring dials the brightness, the inner ring steps the color */
+		LedControl_DialBrightness(isDialing, rotation);
+		
 		/* Check the gesture and control the output accordingly */	
 		switch (gestureId)
 		{		
 		/* Change color in order of VIBGYOR. */
 		case GESTURE_INNER_CLKWISE:
-			switch (ledColor)
+			if((ledColor < COLOR_RAINBOW_FIRST) || (ledColor >= COLOR_RAINBOW_LAST))
 			{
-			case COLOR_VIOLET:
-				ledColor = COLOR_INDIGO;
-				break;
-			
-			case COLOR_INDIGO:
-				ledColor = COLOR_BLUE;
-				break;
-				
-			case COLOR_BLUE:
-				ledColor = COLOR_GREEN;
-				break;
-			
-			case COLOR_GREEN:
-				ledColor = COLOR_YELLOW;
-				break;
-			
-			case COLOR_YELLOW:
-				ledColor = COLOR_ORANGE;
-				break;
-			
-			case COLOR_ORANGE:
-				ledColor = COLOR_RED;
-				break;
-			
-			case COLOR_RED:
-				ledColor = COLOR_VIOLET;
-				break;
-
-			default:
-				ledColor = COLOR_VIOLET;
-				break;
-			}		
+				ledColor = COLOR_RAINBOW_FIRST;
+			}
+			else
+			{
+				ledColor++;
+			}
 			break;
 			
-			/* Fine color change in reverse order of VIBGYOR. */
+		/* Fine color change in reverse order of VIBGYOR. */
 		case GESTURE_INNER_COUNTER_CLKWISE:
-			switch (ledColor)
+			if((ledColor <= COLOR_RAINBOW_FIRST) || (ledColor > COLOR_RAINBOW_LAST))
 			{
-			case COLOR_VIOLET:
-				ledColor = COLOR_RED;
-				break;
-			
-			case COLOR_INDIGO:
-				ledColor = COLOR_VIOLET;
-				break;
-				
-			case COLOR_BLUE:
-				ledColor = COLOR_INDIGO;
-				break;
-			
-			case COLOR_GREEN:
-				ledColor = COLOR_BLUE;
-				break;
-			
-			case COLOR_YELLOW:
-				ledColor = COLOR_GREEN;
-				break;
-			
-			case COLOR_ORANGE:
-				ledColor = COLOR_YELLOW;
-				break;
-			
-			case COLOR_RED:
-				ledColor = COLOR_ORANGE;
-				break;
-
-			default:
-				ledColor = COLOR_RED;
-				break;
-			}	
-				break;
-		
-		case GESTURE_OUTER_CLKWISE:													
-			switch(brightness)
+				ledColor = COLOR_RAINBOW_LAST;
+			}
+			else
 			{
-				case BRIGHT_LEVEL_0:
-					brightness = BRIGHT_LEVEL_1;
-					break;
-				
-				case BRIGHT_LEVEL_1:
-					brightness = BRIGHT_LEVEL_2;
-					break;
-				
-				case BRIGHT_LEVEL_2:
-					brightness = BRIGHT_LEVEL_3;
-					break;
-				
-				case BRIGHT_LEVEL_3:
-					brightness = BRIGHT_LEVEL_4;
-					break;
-				
-				case BRIGHT_LEVEL_4:
-					brightness = BRIGHT_LEVEL_5;
-					break;
-				
-				case BRIGHT_LEVEL_5:
-					brightness = BRIGHT_LEVEL_6;
-					break;
-				
-				case BRIGHT_LEVEL_6:
-					brightness = BRIGHT_LEVEL_7;
-					break;
-				
-				case BRIGHT_LEVEL_7:
-					brightness = BRIGHT_LEVEL_8;
-					break;
-				
-				case BRIGHT_LEVEL_8:
-					brightness = BRIGHT_LEVEL_9;
-					break;
-				
-				case BRIGHT_LEVEL_9:
-				/* Saturate at the maximum brightness. */
-					brightness = BRIGHT_LEVEL_9;
-					break;
-				
-				default:
-					/* Start with a default brightness of 70%. */
-					brightness = BRIGHT_LEVEL_7;
-					break;		
-			}			
+				ledColor--;
+			}
+			break;
+
+		default:
 			break;
-			
-		case GESTURE_OUTER_COUNTER_CLKWISE:										
-			switch(brightness)
-			{
-				case BRIGHT_LEVEL_0:
-				
-					/* Saturate at the minimum brightness. */
-					brightness = BRIGHT_LEVEL_0;
-					break;
-				
-				case BRIGHT_LEVEL_1:
-					brightness = BRIGHT_LEVEL_0;
-					break;
-				
-				case BRIGHT_LEVEL_2:
-					brightness = BRIGHT_LEVEL_1;
-					break;
-				
-				case BRIGHT_LEVEL_3:
-					brightness = BRIGHT_LEVEL_2;
-					break;
-				
-				case BRIGHT_LEVEL_4:
-					brightness = BRIGHT_LEVEL_3;
-					break;
-				
-				case BRIGHT_LEVEL_5:
-					brightness = BRIGHT_LEVEL_4;
-					break;
-				
-				case BRIGHT_LEVEL_6:
-					brightness = BRIGHT_LEVEL_5;
-					break;
-				
-				case BRIGHT_LEVEL_7:
-					brightness = BRIGHT_LEVEL_6;
-					break;
-				
-				case BRIGHT_LEVEL_8:
-					brightness = BRIGHT_LEVEL_7;
-					break;
-				
-				case BRIGHT_LEVEL_9:
-					brightness = BRIGHT_LEVEL_8;
-					break;
-				
-				default:
-					/* Start with a default brightness of 70%. */
-					brightness = BRIGHT_LEVEL_7;
-					break;
-				}
-				
-				break;
-					
-			default:
-				break;
 		}
+	#endif /* #if(LED_HUE_MODE_ENABLE) */
 		
-		/* Show the color on the RGB LED. */
-		SetLedColor(ledColor, brightness);		
+		/* Show the color on the RGB LED, following the dial closely */
+		SetLedEffect(ledColor, brightness, LED_EFFECT_FADE, isDialing ? LED_DIAL_FADE_MS : LED_FADE_MS);
 	}	
 }
 
@@ -291,7 +241,8 @@ void UpdateLedColor(tGestureId gestureId)
 *******************************************************************************
 * Summary:
 *  Shows a specific color on the onboard RGB LED at a specified
-*  brightness level depending on the parameters.
+*  brightness level depending on the parameters. The LED fades to the color 
+*  in LED_FADE_MS.
 *
 * Parameters:
 *  color - LED color to be shown on the RGB LED.
@@ -303,8 +254,36 @@ void UpdateLedColor(tGestureId gestureId)
 *******************************************************************************/
 void SetLedColor(tLedColor color, tBrightLevel tempBrightness)
 {
-	/* Show the color on the LED by controlling the PWMs. 
-	 * Note that the colors are only approximate. */
+	SetLedEffect(color, tempBrightness, LED_EFFECT_FADE, LED_FADE_MS);
+}
+
+
+/******************************************************************************
+* Function Name: SetLedEffect
+*******************************************************************************
+* Summary:
+*  Shows a specific color on the onboard RGB LED at a specified brightness 
+*  level with an animation effect, refer to LedAnim.h.
+*
+* Parameters:
+*  color - LED color to be shown on the RGB LED.
+*  tempBrightness - Brightness level of the LED.
+*  effect - effect used to show the color.
+*  periodMs - fade time, or breathe/blink period in milliseconds.
+*
+* Return:
+*  None
+*
+* Theory:
+*  Only the target is computed here, the PWMs are updated in the background 
+*  by the animation engine.
+*
+*******************************************************************************/
+void SetLedEffect(tLedColor color, tBrightLevel tempBrightness, tLedEffect effect, uint32 periodMs)
+{
+	uint16 compare[LED_CHANNELS];
+	
+	LOG_LED_TRACE(TELEMETRY_EVENT_LED_COLOR, color);
 	
 	if(color == COLOR_OFF)
 	{
@@ -318,67 +297,306 @@ void SetLedColor(tLedColor color, tBrightLevel tempBrightness)
 		brightness = tempBrightness;
 	}
 	
-	switch(color)
-	{
-	case COLOR_OFF:
-		PWM_Red_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Blue_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Green_WriteCompare(LED_OFF_PWM_PERIOD);
-		break;
+	LedControl_GetCompare(color, brightness, compare);
+	LedAnim_Post(compare, effect, periodMs);
+}
+
+
+/******************************************************************************
+* Function Name: LedControl_GetCompare
+*******************************************************************************
+* Summary:
+*  Computes the PWM compare values of a color at a brightness level, without 
+*  showing it.
+*
+* Parameters:
+*  color - LED color.
+*  level - Brightness level.
+*  compare - PWM compare values of the red, green and blue channels.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedControl_GetCompare(tLedColor color, tBrightLevel level, uint16 *compare)
+{
+	uint32 fullCompare;
+	tLedRatio ratio;
 	
-	case COLOR_WHITE:
-		PWM_Red_WriteCompare(brightness);
-		PWM_Blue_WriteCompare(brightness);
-		PWM_Green_WriteCompare(brightness);
-		break;
+	#if(LED_HUE_MODE_ENABLE)
+		if(color == COLOR_HUE)
+		{
+			LedControl_HsvToRatio(((uint32)hueFine * LED_HUE_STEPS) / (uint32)LED_HUE_FINE_TURN, LED_RATIO_FULL, &ratio);
+		}
+		else
+		{
+			CYASSERT(color < LED_COLORS);
+			ratio = colorRatio[color];
+		}
+	#else
+		CYASSERT(color < LED_COLORS);
+		ratio = colorRatio[color];
+	#endif /* #if(LED_HUE_MODE_ENABLE) */
 	
-	case COLOR_VIOLET:
-		PWM_Red_WriteCompare(brightness);
-		PWM_Blue_WriteCompare(brightness);
-		PWM_Green_WriteCompare(LED_OFF_PWM_PERIOD);
-		break;
+	/* Mix the channels in fixed point from the luminance of the brightness */
+	fullCompare = lightnessToCompare[level];
+	compare[LED_RED] = (uint16)((fullCompare * ratio.red) >> LED_RATIO_SHIFT);
+	compare[LED_GREEN] = (uint16)((fullCompare * ratio.green) >> LED_RATIO_SHIFT);
+	compare[LED_BLUE] = (uint16)((fullCompare * ratio.blue) >> LED_RATIO_SHIFT);
+}
+
+
+/******************************************************************************
+* Function Name: LedControl_GetRotation
+*******************************************************************************
+* Summary:
+*  Returns the rotation of the finger on the outer ring since the previous 
+*  frame. Called every frame.
+*
+* Parameters:
+*  rotation - rotation in thetaFine counts, 0 if the ring is not touched.
+*
+* Return:
+*  bool - true while the outer ring is touched.
+*
+* Theory:
+*  The rotation is the change of the unwrapped angle accThetaFine, which is 0
+*  at touch down, so it has the sub-step precision of the centroid and does 
+*  not jump where the slider position wraps around.
+*
+*******************************************************************************/
+static bool LedControl_GetRotation(int32 *rotation)
+{
+	bool isOnRing = (radius >= LED_DIAL_MIN_RADIUS) && (radius != INVALID_RADIUS);
 	
-	case COLOR_INDIGO:
-		PWM_Red_WriteCompare(brightness/4);
-		PWM_Blue_WriteCompare(brightness);
-		PWM_Green_WriteCompare(LED_OFF_PWM_PERIOD);
-		break;
+	*rotation = isOnRing ? (accThetaFine - prevAccThetaFine) : 0;
+	prevAccThetaFine = accThetaFine;
+	
+	return isOnRing;
+}
+
+
+#if(LED_HUE_MODE_ENABLE)
+
+/******************************************************************************
+* Function Name: LedControl_StepBrightness
+*******************************************************************************
+* Summary:
+*  Changes the brightness by BRIGHT_LEVEL_STEP, saturating at the limits.
+*
+* Parameters:
+*  isBrighter - true to increase the brightness, false to decrease it.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedControl_StepBrightness(bool isBrighter)
+{
+	if(isBrighter)
+	{
+		/* Saturate at the maximum brightness. */
+		if(brightness < (BRIGHT_LEVEL_MAX - BRIGHT_LEVEL_STEP))
+		{
+			brightness += BRIGHT_LEVEL_STEP;
+		}
+		else
+		{
+			brightness = BRIGHT_LEVEL_MAX;
+		}
+	}
+	else
+	{
+		/* Saturate at the minimum brightness. */
+		if(brightness > (BRIGHT_LEVEL_MIN + BRIGHT_LEVEL_STEP))
+		{
+			brightness -= BRIGHT_LEVEL_STEP;
+		}
+		else
+		{
+			brightness = BRIGHT_LEVEL_MIN;
+		}
+	}
+}
+
+
+/******************************************************************************
+* Function Name: LedControl_DialHue
+*******************************************************************************
+* Summary:
+*  Turns the hue with the rotation of the finger on the outer ring and 
+*  switches the LED to COLOR_HUE when the hue is dialed.
+*
+* Parameters:
+*  rotation - rotation of the frame, refer to LedControl_GetRotation().
+*
+* Return:
+*  None
+*
+* Theory:
+*  One turn of the ring is one turn of the hue wheel. The rotation is 
+*  accumulated unscaled, as a scale rounded to an integer would make whole 
+*  turns drift, and the hue is wrapped with a compare, as the rotation of a 
+*  frame is less than a turn. It is scaled to the wheel when the color is 
+*  computed.
+*
+*******************************************************************************/
+static void LedControl_DialHue(int32 rotation)
+{
+	if(rotation != 0)
+	{
+		hueFine += rotation;
+		
+		if(hueFine >= LED_HUE_FINE_TURN)
+		{
+			hueFine -= LED_HUE_FINE_TURN;
+		}
+		else if(hueFine < 0)
+		{
+			hueFine += LED_HUE_FINE_TURN;
+		}
 		
-	case COLOR_BLUE:
-		PWM_Red_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Blue_WriteCompare(brightness);
-		PWM_Green_WriteCompare(LED_OFF_PWM_PERIOD);
+		ledColor = COLOR_HUE;
+	}
+}
+
+
+/******************************************************************************
+* Function Name: LedControl_HsvToRatio
+*******************************************************************************
+* Summary:
+*  Converts a hue and saturation to the duty ratios of the LED channels. The 
+*  value is applied separately, through the brightness.
+*
+* Parameters:
+*  hue - 0 to LED_HUE_STEPS - 1, 256 steps per sixth of the color wheel 
+*		 starting at red, yellow, green, cyan, blue and magenta.
+*  saturation - 0 (white) to LED_RATIO_FULL (pure hue).
+*  ratio - duty ratios of the channels, LED_RATIO_FULL for a full channel.
+*
+* Return:
+*  None
+*
+* Theory:
+*  With 256 hue steps per sixth, the sixth and the position in it are a shift
+*  and a mask, and the saturation is a multiply and a shift. No divisions.
+*
+*******************************************************************************/
+static void LedControl_HsvToRatio(uint32 hue, uint32 saturation, tLedRatio *ratio)
+{
+	uint32 rising = hue & (LED_HUE_SIXTH - 1u);
+	uint32 falling = LED_RATIO_FULL - rising;
+	uint32 red, green, blue;
+	
+	switch(hue >> LED_HUE_SIXTH_SHIFT)
+	{
+	case 0:
+		red = LED_RATIO_FULL;
+		green = rising;
+		blue = 0;
 		break;
 	
-	case COLOR_GREEN:
-		PWM_Red_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Blue_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Green_WriteCompare(brightness);
+	case 1:
+		red = falling;
+		green = LED_RATIO_FULL;
+		blue = 0;
 		break;
 	
-	case COLOR_YELLOW:
-		PWM_Red_WriteCompare(brightness);
-		PWM_Blue_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Green_WriteCompare(brightness);
+	case 2:
+		red = 0;
+		green = LED_RATIO_FULL;
+		blue = rising;
 		break;
 	
-	case COLOR_ORANGE:
-		PWM_Red_WriteCompare(brightness);
-		PWM_Blue_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Green_WriteCompare(brightness/2);	
+	case 3:
+		red = 0;
+		green = falling;
+		blue = LED_RATIO_FULL;
 		break;
-		
-	case COLOR_RED:
-		PWM_Red_WriteCompare(brightness);
-		PWM_Blue_WriteCompare(LED_OFF_PWM_PERIOD);
-		PWM_Green_WriteCompare(LED_OFF_PWM_PERIOD);
+	
+	case 4:
+		red = rising;
+		green = 0;
+		blue = LED_RATIO_FULL;
 		break;
-		
+	
 	default:
+		red = LED_RATIO_FULL;
+		green = 0;
+		blue = falling;
 		break;
 	}
+	
+	/* Blend towards white as the saturation decreases */
+	ratio->red = (uint16)(LED_RATIO_FULL - (((LED_RATIO_FULL - red) * saturation) >> LED_RATIO_SHIFT));
+	ratio->green = (uint16)(LED_RATIO_FULL - (((LED_RATIO_FULL - green) * saturation) >> LED_RATIO_SHIFT));
+	ratio->blue = (uint16)(LED_RATIO_FULL - (((LED_RATIO_FULL - blue) * saturation) >> LED_RATIO_SHIFT));
+}
+
+#endif /* #if(LED_HUE_MODE_ENABLE) */
+
+
+#if(!LED_HUE_MODE_ENABLE)
+
+/******************************************************************************
+* Function Name: LedControl_DialBrightness
+*******************************************************************************
+* Summary:
+*  Changes the brightness with the rotation of the finger on the outer ring.
+*  A sweep of LED_DIAL_BRIGHT_SWEEP covers the full brightness range.
+*
+* Parameters:
+*  isDialing - true while the outer ring is touched.
+*  rotation - rotation of the frame, refer to LedControl_GetRotation().
+*
+* Return:
+*  None
+*
+* Theory:
+*  The rotation is accumulated with LED_DIAL_FRAC_BITS fractional bits, so 
+*  slow rotations smaller than a level per frame still add up. The level 
+*  only changes once the accumulated value is LED_DIAL_HYSTERESIS beyond the
+*  current level, so centroid jitter of a resting finger does not flicker.
+*  As the levels are lightness levels, equal rotations give equal perceived
+*  changes. When the ring is released, the accumulator restarts from the 
+*  centre of the current level, which may have been set by SetLedColor().
+*
+*******************************************************************************/
+static void LedControl_DialBrightness(bool isDialing, int32 rotation)
+{
+	int32 level = (int32)brightness << LED_DIAL_FRAC_BITS;
+	
+	if(!isDialing)
+	{
+		brightnessFine = level + (LED_DIAL_ONE / 2);
+		return;
+	}
+	
+	/* The top of the range is extended by the hysteresis so that
+	 * BRIGHT_LEVEL_MAX can be reached.
+	 */
+	brightnessFine += rotation * LED_DIAL_BRIGHT_SCALE;
+	if(brightnessFine < ((int32)BRIGHT_LEVEL_MIN << LED_DIAL_FRAC_BITS))
+	{
+		brightnessFine = (int32)BRIGHT_LEVEL_MIN << LED_DIAL_FRAC_BITS;
+	}
+	else if(brightnessFine > (((int32)BRIGHT_LEVEL_MAX << LED_DIAL_FRAC_BITS) + LED_DIAL_HYSTERESIS))
+	{
+		brightnessFine = ((int32)BRIGHT_LEVEL_MAX << LED_DIAL_FRAC_BITS) + LED_DIAL_HYSTERESIS;
+	}
+	
+	if(brightnessFine >= (level + LED_DIAL_ONE + LED_DIAL_HYSTERESIS))
+	{
+		brightness = (tBrightLevel)((brightnessFine - LED_DIAL_HYSTERESIS) >> LED_DIAL_FRAC_BITS);
+	}
+	else if(brightnessFine < (level - LED_DIAL_HYSTERESIS))
+	{
+		brightness = (tBrightLevel)((brightnessFine + LED_DIAL_HYSTERESIS) >> LED_DIAL_FRAC_BITS);
+	}
 }
 
+#endif /* #if(!LED_HUE_MODE_ENABLE) */
+
 
 /* [] END OF FILE */
 
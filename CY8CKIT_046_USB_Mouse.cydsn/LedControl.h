@@ -43,6 +43,8 @@
 
 #include "cytypes.h"
 #include "Gesture.h"
+#include "LedAnim.h"
+#include "Centroid.h"
 
 
 /*******************************************************************************
@@ -59,39 +61,100 @@ typedef enum
 	COLOR_YELLOW,
 	COLOR_ORANGE,
 	COLOR_RED,
-	COLOR_WHITE
+	COLOR_WHITE,
+	LED_COLORS,			/* Number of colors of the color table, keep after them */
+	COLOR_HUE = LED_COLORS	/* Color dialed on the hue wheel, refer to LED_HUE_MODE_ENABLE */
 }tLedColor;
 
-/* Exponential values for brightness level control. */
-typedef enum
+/* Perceptual brightness, CIE 1931 lightness scaled to 0 - BRIGHT_LEVEL_MAX.
+ * Equal steps of the level appear as equal steps of brightness.
+ */
+typedef uint8 tBrightLevel;
+
+/* Duty ratio of each LED channel for a color, in Q8 (LED_RATIO_FULL = 1) */
+typedef struct
 {
-	BRIGHT_LEVEL_0 = 500, 
-	BRIGHT_LEVEL_1 = 1000,
-	BRIGHT_LEVEL_2 = 2000,
-	BRIGHT_LEVEL_3 = 4000,
-	BRIGHT_LEVEL_4 = 8000,
-	BRIGHT_LEVEL_5 = 12000,
-	BRIGHT_LEVEL_6 = 16000,
-	BRIGHT_LEVEL_7 = 20000,
-	BRIGHT_LEVEL_8 = 24000,
-	BRIGHT_LEVEL_9 = 28000
-}tBrightLevel;
+	uint16 red;
+	uint16 green;
+	uint16 blue;
+}tLedRatio;
 
 
 /*******************************************************************************
 * 	Macro Definitions
 ********************************************************************************/
 
+/* Defines the time SetLedColor() takes to fade to a new color, in ms */
+#define LED_FADE_MS						(150u)
+
 /* Defines the initial color of the RGB LED at power-up. */
 #define INIT_LED_COLOR					COLOR_OFF
 
+/* Brightness range. The minimum keeps the LED clearly visible, it is the 
+ * lightness of the PWM compare value of 500 used as the lowest level before.
+ */
+#define BRIGHT_LEVEL_MIN				(37u)
+#define BRIGHT_LEVEL_MAX				(255u)
+
+/* Brightness change for each inner rotation gesture in hue mode */
+#define BRIGHT_LEVEL_STEP				(8u)
+
 /* Defines the initial brightness level of the RGB LED at power-up. */
-#define INIT_BRIGHT_LEVEL				BRIGHT_LEVEL_0
+#define INIT_BRIGHT_LEVEL				BRIGHT_LEVEL_MIN
+
+/* PWM compare value of a fully on channel at BRIGHT_LEVEL_MAX. The lightness
+ * table in LedControl.c is generated for this value.
+ */
+#define LED_MAX_COMPARE					(28000u)
+
+/* Colors that the inner rotation gestures step through, in VIBGYOR order */
+#define COLOR_RAINBOW_FIRST				COLOR_VIOLET
+#define COLOR_RAINBOW_LAST				COLOR_RED
 
-/* Defines the minimum delta or shift in the slider centroid (accumulated over
- * multiple scans) required to change the brightness level. 
+/* Full duty ratio of a channel in the color table */
+#define LED_RATIO_SHIFT					(8)
+#define LED_RATIO_FULL					(1u << LED_RATIO_SHIFT)
+
+/* Enables the hue mode. The rotation of the finger on the outer ring turns 
+ * the hue of the LED continuously, one turn of the ring for the full color 
+ * wheel, and the inner rotation gestures change the brightness. Otherwise 
+ * the outer ring dials the brightness and the inner rotation gestures step
+ * through the colors.
+ */
+#ifndef LED_HUE_MODE_ENABLE
+	#define LED_HUE_MODE_ENABLE			(DISABLED)
+#endif /* #ifndef LED_HUE_MODE_ENABLE */
+
+/* The outer ring dials the brightness, or the hue in hue mode, when the 
+ * radius is at least this, i.e. on the slider.
+ */
+#define LED_DIAL_MIN_RADIUS				(3u)
+
+/* Fade time while dialing, short to follow the finger */
+#define LED_DIAL_FADE_MS				(30u)
+
+/* Rotation of the outer ring over which the brightness goes from 
+ * BRIGHT_LEVEL_MIN to BRIGHT_LEVEL_MAX, in theta counts (half a turn).
+ */
+#define LED_DIAL_BRIGHT_SWEEP			(ANGLE_180)
+
+/* The dialed brightness has LED_DIAL_FRAC_BITS fractional bits. It must move
+ * LED_DIAL_HYSTERESIS beyond a level to change the level. LED_DIAL_BRIGHT_SCALE
+ * converts the rotation of thetaFine to the dialed brightness.
+ */
+#define LED_DIAL_FRAC_BITS				(16)
+#define LED_DIAL_ONE					((int32)1 << LED_DIAL_FRAC_BITS)
+#define LED_DIAL_HYSTERESIS				(LED_DIAL_ONE / 2)
+#define LED_DIAL_BRIGHT_SCALE			((((int32)(BRIGHT_LEVEL_MAX - BRIGHT_LEVEL_MIN)) << LED_DIAL_FRAC_BITS) / (LED_DIAL_BRIGHT_SWEEP << CENTROID_FRAC_BITS))
+
+/* Hue wheel, six sixths of 256 steps each. The dialed hue is kept as the 
+ * rotation of thetaFine, LED_HUE_FINE_TURN counts for one turn of the ring 
+ * and of the wheel, so that whole turns bring back the same hue.
  */
-#define BRIGHT_CHANGE_ACCU_SLIDER_DELTA		(20)
+#define LED_HUE_SIXTH_SHIFT				(8)
+#define LED_HUE_SIXTH					(1u << LED_HUE_SIXTH_SHIFT)
+#define LED_HUE_STEPS					(6u * LED_HUE_SIXTH)
+#define LED_HUE_FINE_TURN				((int32)(SLIDER_RESOLUTION << CENTROID_FRAC_BITS))
 
 /* Defines the PWM period value that turns off the LED */
 #define LED_OFF_PWM_PERIOD				(0)
@@ -103,6 +166,8 @@ typedef enum
 
 void UpdateLedColor(tGestureId gestureId);
 void SetLedColor(tLedColor ledColor, tBrightLevel brightness);
+void SetLedEffect(tLedColor ledColor, tBrightLevel brightness, tLedEffect effect, uint32 periodMs);
+void LedControl_GetCompare(tLedColor color, tBrightLevel level, uint16 *compare);
 
 	
 #endif /* #ifndef LED_CONTROL_H */
@@ -0,0 +1,193 @@
+/*******************************************************************************
+* File Name: LedDriver.c
+*
+* Version 1.0
+*
+* Description: This file contains the RGB LED driver, which writes the PWM compare
+*               values that changed since the last write
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "LedDriver.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Shadow value that differs from any compare value, forces the next write */
+#define LED_DRIVER_SHADOW_UNKNOWN		(0xFFFFFFFFu)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Last compare value written to each channel */
+static uint32 shadowCompare[LED_CHANNELS];
+
+/* Channel writes requested, and compare registers actually written */
+static uint32 writesRequested;
+static uint32 writesDone;
+
+#if(LED_DRIVER_SYNC_ENABLE)
+	/* Compare buffer write function and counter mask of each channel */
+	static void (* const writeCompare[LED_CHANNELS])(uint32) = 
+	{
+		PWM_Red_WriteCompareBuf, PWM_Green_WriteCompareBuf, PWM_Blue_WriteCompareBuf
+	};
+	
+	static const uint32 counterMask[LED_CHANNELS] = 
+	{
+		PWM_Red_MASK, PWM_Green_MASK, PWM_Blue_MASK
+	};
+#else
+	/* Compare write function of each channel */
+	static void (* const writeCompare[LED_CHANNELS])(uint32) = 
+	{
+		PWM_Red_WriteCompare, PWM_Green_WriteCompare, PWM_Blue_WriteCompare
+	};
+#endif /* #if(LED_DRIVER_SYNC_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: LedDriver_Init
+********************************************************************************
+* Summary:
+*  Forces the next write of all the channels and enables the compare swap of
+*  the PWMs for the synchronized update. Called after the PWMs are started.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedDriver_Init(void)
+{
+	uint32 channel;
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		shadowCompare[channel] = LED_DRIVER_SHADOW_UNKNOWN;
+	}
+	
+	#if(LED_DRIVER_SYNC_ENABLE)
+		PWM_Red_SetCompareSwap(1u);
+		PWM_Green_SetCompareSwap(1u);
+		PWM_Blue_SetCompareSwap(1u);
+	#endif /* #if(LED_DRIVER_SYNC_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedDriver_Write
+********************************************************************************
+* Summary:
+*  Writes the compare values of the channels that changed since the last 
+*  write.
+*
+* Parameters:
+*  compare - PWM compare values of the red, green and blue channels
+*
+* Return:
+*  None
+*
+* Theory:
+*  With LED_DRIVER_SYNC_ENABLE, the changed values are written to the compare
+*  buffers and one capture command to all the changed counters requests the
+*  swap, which the counters perform at their next terminal count. The PWMs 
+*  share the clock and are started together, so they swap at the same time.
+*  Called either from the main loop or from the SysTick interrupt, never 
+*  from both, refer to LedAnim.c.
+*
+*******************************************************************************/
+void LedDriver_Write(const uint16 *compare)
+{
+	uint32 channel;
+	
+	#if(LED_DRIVER_SYNC_ENABLE)
+		uint32 swapMask = 0;
+	#endif /* #if(LED_DRIVER_SYNC_ENABLE) */
+	
+	writesRequested += LED_CHANNELS;
+	
+	for(channel = 0; channel < LED_CHANNELS; channel++)
+	{
+		if(compare[channel] != shadowCompare[channel])
+		{
+			shadowCompare[channel] = compare[channel];
+			writeCompare[channel](compare[channel]);
+			writesDone++;
+			
+			#if(LED_DRIVER_SYNC_ENABLE)
+				swapMask |= counterMask[channel];
+			#endif /* #if(LED_DRIVER_SYNC_ENABLE) */
+		}
+	}
+	
+	#if(LED_DRIVER_SYNC_ENABLE)
+		if(swapMask != 0)
+		{
+			PWM_Red_TriggerCommand(swapMask, PWM_Red_CMD_CAPTURE);
+		}
+	#endif /* #if(LED_DRIVER_SYNC_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedDriver_Dump
+********************************************************************************
+* Summary:
+*  Prints the write counters as leddriver,<requested>,<written>, the number of
+*  channel writes requested and of compare registers actually written.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedDriver_Dump(void)
+{
+	UART_UartPutString("leddriver");
+	PrintField(writesRequested);
+	PrintField(writesDone);
+	UART_UartPutString("\n\r");
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,81 @@
+/*****************************************************************************
+* File Name		: LedDriver.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  LedDriver.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LED_DRIVER_H		/* Guard to prevent multiple inclusions */
+#define LED_DRIVER_H
+
+#include "cytypes.h"
+#include "main.h"
+
+
+/*******************************************************************************
+* 	Macro Definitions
+********************************************************************************/
+
+/* Number of LED channels and their index in the compare values */
+#define LED_CHANNELS					(3u)
+#define LED_RED							(0u)
+#define LED_GREEN						(1u)
+#define LED_BLUE						(2u)
+
+/* Enables the synchronized update of the channels. The new compare values are
+ * written to the compare buffers and all the PWMs swap them in at the end of
+ * their period, so a color change never shows a partial period or a mix of 
+ * old and new channels. When disabled, the compare registers are written 
+ * directly.
+ */
+#ifndef LED_DRIVER_SYNC_ENABLE
+	#define LED_DRIVER_SYNC_ENABLE		(DISABLED)
+#endif /* #ifndef LED_DRIVER_SYNC_ENABLE */
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void LedDriver_Init(void);
+void LedDriver_Write(const uint16 *compare);
+void LedDriver_Dump(void);
+
+
+#endif /* #ifndef LED_DRIVER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,289 @@
+/*******************************************************************************
+* File Name: LedStatus.c
+*
+* Version 1.0
+*
+* Description: This file contains the status overlays of the RGB LED, which show
+*               USB suspend, stalled HID reports, CapSense noise and frame
+*               overruns as blink codes
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "LedStatus.h"
+#include "LedAnim.h"
+#include "Timebase.h"
+#include "Telemetry.h"
+#include "Log.h"
+#include "HidSched.h"
+#include "stdbool.h"
+
+
+#if(LED_STATUS_ENABLE)
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Frame budget in system clock cycles, refer to Timebase_GetCycles() */
+#define LED_STATUS_FRAME_BUDGET_CYCLES	(LED_STATUS_FRAME_BUDGET_US * (CYDEV_BCLK__SYSCLK__HZ / 1000000u))
+
+
+/*******************************************************************************
+*	Local Data Type Definitions
+********************************************************************************/
+
+/* How a condition is shown */
+typedef struct
+{
+	tLedColor color;
+	tLedEffect effect;
+	uint16 periodMs;
+}tLedStatusCode;
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Codes of the conditions, by tLedStatus. The color tells the condition, the
+ * blink rate its urgency.
+ */
+static const tLedStatusCode statusCode[LED_STATUS_COUNT] = 
+{
+	{COLOR_BLUE,	LED_EFFECT_BREATHE,	3000u},		/* LED_STATUS_USB_SUSPEND */
+	{COLOR_ORANGE,	LED_EFFECT_BLINK,	250u},		/* LED_STATUS_REPORT_STALL */
+	{COLOR_YELLOW,	LED_EFFECT_BLINK,	500u},		/* LED_STATUS_NOISE_ALARM */
+	{COLOR_RED,		LED_EFFECT_BLINK,	125u}		/* LED_STATUS_FRAME_OVERRUN */
+};
+
+/* Time each condition was last detected, valid if its bit is set in
+ * raisedMask.
+ */
+static uint32 raisedMs[LED_STATUS_COUNT];
+static uint32 raisedMask;
+
+/* Condition shown */
+static tLedStatus shownStatus = LED_STATUS_NONE;
+
+/* Bus activity check */
+static uint32 activityCheckMs;
+static bool isSuspended;
+
+/* Start of the last frame, in cycles */
+static uint32 frameStartCycles;
+
+#endif /* #if(LED_STATUS_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: LedStatus_Poll
+********************************************************************************
+* Summary:
+*  Detects the USB suspend, stalled reports and CapSense noise conditions, and
+*  shows the highest priority condition detected within LED_STATUS_HOLD_MS 
+*  over the user color. Called every iteration of the main loop.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  The frames stop while the host does not poll the endpoints, so the 
+*  conditions are checked here rather than per frame. Reports are stalled 
+*  only when the scheduler holds queued reports, a frame that is merely not 
+*  due (e.g. no report change) does not count. The overlay is only posted 
+*  when the shown condition changes.
+*
+*******************************************************************************/
+void LedStatus_Poll(void)
+{
+	#if(LED_STATUS_ENABLE)
+		uint32 now = Timebase_GetMs();
+		uint32 isConfigured = USBFS_GetConfiguration();
+		uint32 widget;
+		uint16 compare[LED_CHANNELS];
+		tLedStatus status;
+		
+		if((now - activityCheckMs) >= LED_STATUS_SUSPEND_CHECK_MS)
+		{
+			activityCheckMs = now;
+			isSuspended = (isConfigured != 0) && (USBFS_CheckActivity() == 0);
+		}
+		
+		if(isSuspended)
+		{
+			LedStatus_Raise(LED_STATUS_USB_SUSPEND);
+		}
+		else if((isConfigured != 0) && (HidSched_GetPendingMs() > LED_STATUS_REPORT_TIMEOUT_MS))
+		{
+			LedStatus_Raise(LED_STATUS_REPORT_STALL);
+		}
+		
+		for(widget = 0; widget < ADAPT_WIDGET_COUNT; widget++)
+		{
+			if(AdaptiveThreshold_GetNoise(widget) > LED_STATUS_NOISE_LIMIT)
+			{
+				LedStatus_Raise(LED_STATUS_NOISE_ALARM);
+			}
+		}
+		
+		/* Highest priority condition still within its hold time */
+		for(status = LED_STATUS_USB_SUSPEND; status < LED_STATUS_COUNT; status++)
+		{
+			if(raisedMask & (1u << status))
+			{
+				if((now - raisedMs[status]) < LED_STATUS_HOLD_MS)
+				{
+					break;
+				}
+				raisedMask &= ~(1u << status);
+			}
+		}
+		
+		if(status != shownStatus)
+		{
+			shownStatus = status;
+			LOG_LED_INFO(TELEMETRY_EVENT_LED_STATUS, status);
+			
+			if(status == LED_STATUS_NONE)
+			{
+				LedAnim_ClearOverlay();
+			}
+			else
+			{
+				LedControl_GetCompare(statusCode[status].color, LED_STATUS_BRIGHT_LEVEL, compare);
+				LedAnim_SetOverlay(compare, statusCode[status].effect, statusCode[status].periodMs);
+			}
+		}
+	#endif /* #if(LED_STATUS_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedStatus_FrameStart
+********************************************************************************
+* Summary:
+*  Marks the start of the processing of a frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedStatus_FrameStart(void)
+{
+	#if(LED_STATUS_ENABLE)
+		frameStartCycles = Timebase_GetCycles();
+	#endif /* #if(LED_STATUS_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedStatus_FrameEnd
+********************************************************************************
+* Summary:
+*  Marks the end of the processing of a frame and raises a frame overrun if 
+*  it took longer than LED_STATUS_FRAME_BUDGET_US.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedStatus_FrameEnd(void)
+{
+	#if(LED_STATUS_ENABLE)
+		if((Timebase_GetCycles() - frameStartCycles) > LED_STATUS_FRAME_BUDGET_CYCLES)
+		{
+			LedStatus_Raise(LED_STATUS_FRAME_OVERRUN);
+		}
+	#endif /* #if(LED_STATUS_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedStatus_Raise
+********************************************************************************
+* Summary:
+*  Records that a condition was detected. It is shown for LED_STATUS_HOLD_MS
+*  unless a higher priority condition is active.
+*
+* Parameters:
+*  status - condition detected
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LedStatus_Raise(tLedStatus status)
+{
+	#if(LED_STATUS_ENABLE)
+		raisedMs[status] = Timebase_GetMs();
+		raisedMask |= (1u << status);
+	#else
+		(void)status;
+	#endif /* #if(LED_STATUS_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: LedStatus_GetStatus
+********************************************************************************
+* Summary:
+*  Returns the condition shown.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  tLedStatus - condition shown, LED_STATUS_NONE if none.
+*
+*******************************************************************************/
+tLedStatus LedStatus_GetStatus(void)
+{
+	#if(LED_STATUS_ENABLE)
+		return shownStatus;
+	#else
+		return LED_STATUS_NONE;
+	#endif /* #if(LED_STATUS_ENABLE) */
+}
+
+
+/* [] END OF FILE */
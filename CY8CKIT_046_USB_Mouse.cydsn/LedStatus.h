@@ -0,0 +1,126 @@
+/*****************************************************************************
+* File Name		: LedStatus.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  LedStatus.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LED_STATUS_H		/* Guard to prevent multiple inclusions */
+#define LED_STATUS_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "LedControl.h"
+#include "AdaptiveThreshold.h"
+
+
+/*******************************************************************************
+* 	Data Type Definitions
+********************************************************************************/
+
+/* Status conditions, in decreasing priority. Only the highest priority active
+ * condition is shown.
+ */
+typedef enum
+{
+	LED_STATUS_USB_SUSPEND,		/* No bus activity, the host suspended the device */
+	LED_STATUS_REPORT_STALL,	/* The host did not take the queued HID reports in time */
+	LED_STATUS_NOISE_ALARM,		/* CapSense noise beyond the adaptive threshold range */
+	LED_STATUS_FRAME_OVERRUN,	/* Frame processing exceeded its time budget */
+	LED_STATUS_COUNT,			/* Number of conditions, keep after them */
+	LED_STATUS_NONE = LED_STATUS_COUNT
+}tLedStatus;
+
+
+/*******************************************************************************
+* 	Macro Definitions
+********************************************************************************/
+
+/* Enables or disables the status overlays. Disabled until 
+ * LED_STATUS_FRAME_BUDGET_US is measured on the board, otherwise the frame 
+ * overrun code may show on every frame. The host build enables it per target.
+ */
+#ifndef LED_STATUS_ENABLE
+	#define LED_STATUS_ENABLE			(DISABLED)
+#endif /* #ifndef LED_STATUS_ENABLE */
+
+/* A condition stays shown for this time after it was last detected, so that
+ * short events remain readable.
+ */
+#define LED_STATUS_HOLD_MS				(3000u)
+
+/* Brightness of the status codes */
+#define LED_STATUS_BRIGHT_LEVEL			(128u)
+
+/* The bus is checked for activity with this period. The host sends a start of
+ * frame every ms unless it suspended the device.
+ */
+#define LED_STATUS_SUSPEND_CHECK_MS		(10u)
+
+/* Reports are stalled when the reports queued by a frame wait for the host
+ * for longer than this while the device is configured and not suspended, 
+ * refer to HidSched_GetPendingMs().
+ */
+#define LED_STATUS_REPORT_TIMEOUT_MS	(100u)
+
+/* Noise alarm level, the noise beyond which the finger threshold saturates 
+ * at ADAPT_FINGER_TH_MAX, with ADAPT_NOISE_FRAC_BITS fractional bits.
+ */
+#define LED_STATUS_NOISE_LIMIT			((((ADAPT_FINGER_TH_MAX) - (ADAPT_FINGER_TH_BASE)) << ADAPT_NOISE_FRAC_BITS) / ADAPT_FINGER_SIGMA_GAIN)
+
+/* Processing time budget of a frame, from the end of the scan to the HID 
+ * report, in microseconds. Not measured on the board yet: set it above the 
+ * maximum of the "frame" stage of Profile_Dump() before enabling 
+ * LED_STATUS_ENABLE.
+ */
+#define LED_STATUS_FRAME_BUDGET_US		(1000u)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void LedStatus_Poll(void);
+void LedStatus_FrameStart(void);
+void LedStatus_FrameEnd(void);
+void LedStatus_Raise(tLedStatus status);
+tLedStatus LedStatus_GetStatus(void);
+
+
+#endif /* #ifndef LED_STATUS_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,192 @@
+/*****************************************************************************
+* File Name		: Log.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the per-module trace macros and the constants
+*  used in Log.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LOG_H		/* Guard to prevent multiple inclusions */
+#define LOG_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "Telemetry.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Trace levels. A module traced at a level also traces the lower levels. 
+ * LOG_LEVEL_TRACE is meant for the events which may occur on every frame.
+ */
+#define LOG_LEVEL_OFF						(0)
+#define LOG_LEVEL_ERROR						(1)
+#define LOG_LEVEL_INFO						(2)
+#define LOG_LEVEL_TRACE						(3)
+#define LOG_LEVELS							(4)
+
+/* Modules */
+#define LOG_MODULE_GESTURE					(0)
+#define LOG_MODULE_HID						(1)
+#define LOG_MODULE_LED						(2)
+#define LOG_MODULE_USB						(3)
+#define LOG_MODULE_CAPSENSE					(4)
+#define LOG_MODULES							(5)
+
+/* Compile time level of each module. The macros of the higher levels compile 
+ * to nothing. The events are sent over the telemetry channel, so nothing is 
+ * traced unless TELEMETRY_ENABLE is set.
+ */
+#define LOG_LEVEL_GESTURE					(LOG_LEVEL_INFO)
+#define LOG_LEVEL_HID						(LOG_LEVEL_INFO)
+#define LOG_LEVEL_LED						(LOG_LEVEL_INFO)
+#define LOG_LEVEL_USB						(LOG_LEVEL_INFO)
+#define LOG_LEVEL_CAPSENSE					(LOG_LEVEL_INFO)
+
+/* Bits of the runtime mask, one per module and level */
+#define LOG_MASK_BIT(module, level)			(1u << (((module) * LOG_LEVELS) + (level)))
+#define LOG_MASK_MODULE(module)				(((1u << LOG_LEVELS) - 1u) << ((module) * LOG_LEVELS))
+
+/* Runtime mask after reset - all the compiled levels enabled */
+#define LOG_MASK_DEFAULT					(0xFFFFFFFFu)
+
+/* Sends the event if the module and level are enabled in the runtime mask */
+#define LOG_EVENT(module, level, event, payload)	do { if(logMask & LOG_MASK_BIT(module, level)) { Telemetry_Event(event, payload); } } while(0)
+
+/* Trace macros - LOG_<module>_<level>(event, payload), refer to Telemetry.h 
+ * for the events.
+ */
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_GESTURE >= LOG_LEVEL_ERROR))
+	#define LOG_GESTURE_ERROR(event, payload)		LOG_EVENT(LOG_MODULE_GESTURE, LOG_LEVEL_ERROR, event, payload)
+#else
+	#define LOG_GESTURE_ERROR(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_GESTURE >= LOG_LEVEL_INFO))
+	#define LOG_GESTURE_INFO(event, payload)		LOG_EVENT(LOG_MODULE_GESTURE, LOG_LEVEL_INFO, event, payload)
+#else
+	#define LOG_GESTURE_INFO(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_GESTURE >= LOG_LEVEL_TRACE))
+	#define LOG_GESTURE_TRACE(event, payload)		LOG_EVENT(LOG_MODULE_GESTURE, LOG_LEVEL_TRACE, event, payload)
+#else
+	#define LOG_GESTURE_TRACE(event, payload)
+#endif
+
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_HID >= LOG_LEVEL_ERROR))
+	#define LOG_HID_ERROR(event, payload)		LOG_EVENT(LOG_MODULE_HID, LOG_LEVEL_ERROR, event, payload)
+#else
+	#define LOG_HID_ERROR(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_HID >= LOG_LEVEL_INFO))
+	#define LOG_HID_INFO(event, payload)		LOG_EVENT(LOG_MODULE_HID, LOG_LEVEL_INFO, event, payload)
+#else
+	#define LOG_HID_INFO(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_HID >= LOG_LEVEL_TRACE))
+	#define LOG_HID_TRACE(event, payload)		LOG_EVENT(LOG_MODULE_HID, LOG_LEVEL_TRACE, event, payload)
+#else
+	#define LOG_HID_TRACE(event, payload)
+#endif
+
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_LED >= LOG_LEVEL_ERROR))
+	#define LOG_LED_ERROR(event, payload)		LOG_EVENT(LOG_MODULE_LED, LOG_LEVEL_ERROR, event, payload)
+#else
+	#define LOG_LED_ERROR(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_LED >= LOG_LEVEL_INFO))
+	#define LOG_LED_INFO(event, payload)		LOG_EVENT(LOG_MODULE_LED, LOG_LEVEL_INFO, event, payload)
+#else
+	#define LOG_LED_INFO(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_LED >= LOG_LEVEL_TRACE))
+	#define LOG_LED_TRACE(event, payload)		LOG_EVENT(LOG_MODULE_LED, LOG_LEVEL_TRACE, event, payload)
+#else
+	#define LOG_LED_TRACE(event, payload)
+#endif
+
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_USB >= LOG_LEVEL_ERROR))
+	#define LOG_USB_ERROR(event, payload)		LOG_EVENT(LOG_MODULE_USB, LOG_LEVEL_ERROR, event, payload)
+#else
+	#define LOG_USB_ERROR(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_USB >= LOG_LEVEL_INFO))
+	#define LOG_USB_INFO(event, payload)		LOG_EVENT(LOG_MODULE_USB, LOG_LEVEL_INFO, event, payload)
+#else
+	#define LOG_USB_INFO(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_USB >= LOG_LEVEL_TRACE))
+	#define LOG_USB_TRACE(event, payload)		LOG_EVENT(LOG_MODULE_USB, LOG_LEVEL_TRACE, event, payload)
+#else
+	#define LOG_USB_TRACE(event, payload)
+#endif
+
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_CAPSENSE >= LOG_LEVEL_ERROR))
+	#define LOG_CAPSENSE_ERROR(event, payload)		LOG_EVENT(LOG_MODULE_CAPSENSE, LOG_LEVEL_ERROR, event, payload)
+#else
+	#define LOG_CAPSENSE_ERROR(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_CAPSENSE >= LOG_LEVEL_INFO))
+	#define LOG_CAPSENSE_INFO(event, payload)		LOG_EVENT(LOG_MODULE_CAPSENSE, LOG_LEVEL_INFO, event, payload)
+#else
+	#define LOG_CAPSENSE_INFO(event, payload)
+#endif
+#if((TELEMETRY_ENABLE) && (LOG_LEVEL_CAPSENSE >= LOG_LEVEL_TRACE))
+	#define LOG_CAPSENSE_TRACE(event, payload)		LOG_EVENT(LOG_MODULE_CAPSENSE, LOG_LEVEL_TRACE, event, payload)
+#else
+	#define LOG_CAPSENSE_TRACE(event, payload)
+#endif
+
+
+/*******************************************************************************
+*   External Variable Declarations
+*******************************************************************************/
+
+/* Runtime mask, refer to LOG_MASK_BIT() */
+extern uint32 logMask;
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void Log_ToggleModule(uint32 module);
+
+
+#endif /* #ifndef LOG_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/*****************************************************************************
+* File Name		: Platform.h
+* Version		: 1.0 
+*
+* Description:
+*  This file selects the hardware API used by the gesture, HID, LED
+*  and sensor processing modules.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PLATFORM_H		/* Guard to prevent multiple inclusions */
+#define PLATFORM_H
+
+/* All the application modules except main.c reach the PSoC Creator generated
+ * APIs (CapSense_*, USBFS_*, PWM_*, UART_*, CySysTick*) only through this 
+ * header. 
+ *
+ * A build for a different target defines PLATFORM_HOST and supplies 
+ * PlatformHost.h, which declares the same subset of the generated APIs and 
+ * types (cytypes.h) backed by its own implementation, for example a mock 
+ * hardware layer. The modules then compile unchanged.
+ */
+#if defined(PLATFORM_HOST)
+	#include "PlatformHost.h"
+#else
+	#include "project.h"
+#endif /* #if defined(PLATFORM_HOST) */
+
+#endif /* #ifndef PLATFORM_H */
+
+
+/* [] END OF FILE */
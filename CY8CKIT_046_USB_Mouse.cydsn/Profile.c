@@ -0,0 +1,304 @@
+/*******************************************************************************
+* File Name: Profile.c
+*
+* Version 1.0
+*
+* Description: This file contains the execution time instrumentation of the
+*               main loop stages.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "Profile.h"
+#include "Timebase.h"
+#include "string.h"
+
+
+#if(PROFILE_ENABLE)
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Names of the stages in the dump */
+static const char8 * const stageName[PROFILE_STAGES] = 
+{
+	[PROFILE_BASELINE] = "baseline",
+	[PROFILE_SENSOR_FILTER] = "filter",
+	[PROFILE_THRESHOLD] = "threshold",
+	[PROFILE_GESTURE] = "gesture",
+	[PROFILE_LED] = "led",
+	[PROFILE_HID] = "hid",
+	[PROFILE_USB] = "usb",
+	[PROFILE_FRAME] = "frame"
+};
+
+/* Cycle count at the start of each stage, and statistics of each stage */
+static uint32 stageStart[PROFILE_STAGES];
+static tProfileStat stageStat[PROFILE_STAGES];
+
+#endif /* #if(PROFILE_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: Profile_Begin
+********************************************************************************
+* Summary:
+*  Marks the start of a stage. Use PROFILE_BEGIN() instead of calling this 
+*  function directly.
+*
+* Parameters:
+*  stage - stage, refer to Profile.h
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Profile_Begin(uint32 stage)
+{
+	#if(PROFILE_ENABLE)
+		stageStart[stage] = Timebase_GetCycles();
+	#endif /* #if(PROFILE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Profile_End
+********************************************************************************
+* Summary:
+*  Marks the end of a stage and accumulates its duration. Use PROFILE_END() 
+*  instead of calling this function directly.
+*
+* Parameters:
+*  stage - stage, refer to Profile.h
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Profile_End(uint32 stage)
+{
+	#if(PROFILE_ENABLE)
+		Profile_Accumulate(&stageStat[stage], Timebase_GetCycles() - stageStart[stage]);
+	#endif /* #if(PROFILE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Profile_Dump
+********************************************************************************
+* Summary:
+*  Prints the statistics of all the stages over UART, refer to 
+*  Profile_PrintStat() for the format.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Profile_Dump(void)
+{
+	#if(PROFILE_ENABLE)
+		uint32 stage;
+		
+		for(stage = 0; stage < PROFILE_STAGES; stage++)
+		{
+			Profile_PrintStat(stageName[stage], &stageStat[stage]);
+		}
+	#endif /* #if(PROFILE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Profile_Clear
+********************************************************************************
+* Summary:
+*  Clears the statistics of all the stages.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Profile_Clear(void)
+{
+	#if(PROFILE_ENABLE)
+		uint32 stage;
+		
+		for(stage = 0; stage < PROFILE_STAGES; stage++)
+		{
+			Profile_ClearStat(&stageStat[stage]);
+		}
+	#endif /* #if(PROFILE_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Profile_Accumulate
+********************************************************************************
+* Summary:
+*  Adds a duration to the statistics.
+*
+* Parameters:
+*  stat - statistics to update
+*  cycles - duration in system clock cycles
+*
+* Return:
+*  None
+*
+* Theory:
+*  The histogram bucket is the position of the most significant bit, found 
+*  with a binary search as the Cortex-M0 has no count leading zeros 
+*  instruction.
+*
+*******************************************************************************/
+void Profile_Accumulate(tProfileStat *stat, uint32 cycles)
+{
+	uint32 bucket = 0, value = cycles;
+	
+	if(value >= (1u << 16))
+	{
+		value >>= 16;
+		bucket += 16;
+	}
+	if(value >= (1u << 8))
+	{
+		value >>= 8;
+		bucket += 8;
+	}
+	if(value >= (1u << 4))
+	{
+		value >>= 4;
+		bucket += 4;
+	}
+	if(value >= (1u << 2))
+	{
+		value >>= 2;
+		bucket += 2;
+	}
+	if(value >= (1u << 1))
+	{
+		bucket += 1;
+	}
+	
+	if(bucket >= PROFILE_BUCKETS)
+	{
+		bucket = PROFILE_BUCKETS - 1;
+	}
+	
+	if(stat->histogram[bucket] != 0xFFFFu)
+	{
+		stat->histogram[bucket]++;
+	}
+	
+	if((stat->count == 0) || (cycles < stat->min))
+	{
+		stat->min = cycles;
+	}
+	if(cycles > stat->max)
+	{
+		stat->max = cycles;
+	}
+	
+	stat->sum += cycles;
+	stat->count++;
+}
+
+
+/*******************************************************************************
+* Function Name: Profile_ClearStat
+********************************************************************************
+* Summary:
+*  Clears the statistics.
+*
+* Parameters:
+*  stat - statistics to clear
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Profile_ClearStat(tProfileStat *stat)
+{
+	memset(stat, 0, sizeof(*stat));
+}
+
+
+/*******************************************************************************
+* Function Name: Profile_PrintStat
+********************************************************************************
+* Summary:
+*  Prints the statistics over UART as comma separated lines:
+*   profile,<name>,<count>,<min>,<max>,<mean>
+*   histogram,<name>,<bucket>,<count>
+*  Durations are in system clock cycles. Empty histogram buckets are skipped.
+*
+* Parameters:
+*  name - name of the measured duration
+*  stat - statistics to print
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Profile_PrintStat(const char8 name[], const tProfileStat *stat)
+{
+	uint32 bucket;
+	
+	UART_UartPutString("profile,");
+	UART_UartPutString(name);
+	PrintField(stat->count);
+	PrintField(stat->min);
+	PrintField(stat->max);
+	PrintField((stat->count != 0) ? (uint32)(stat->sum / stat->count) : 0);
+	UART_UartPutString("\n\r");
+	
+	for(bucket = 0; bucket < PROFILE_BUCKETS; bucket++)
+	{
+		if(stat->histogram[bucket] != 0)
+		{
+			UART_UartPutString("histogram,");
+			UART_UartPutString(name);
+			PrintField(bucket);
+			PrintField(stat->histogram[bucket]);
+			UART_UartPutString("\n\r");
+		}
+	}
+}
+
+
+/* [] END OF FILE */
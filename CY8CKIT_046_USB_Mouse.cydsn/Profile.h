@@ -0,0 +1,117 @@
+/*****************************************************************************
+* File Name		: Profile.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  Profile.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILE_H		/* Guard to prevent multiple inclusions */
+#define PROFILE_H
+
+#include "cytypes.h"
+#include "main.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables the stage instrumentation. When disabled, the probes
+ * compile to nothing.
+ */
+#define PROFILE_ENABLE						(DISABLED)
+
+/* Stages of the main loop */
+#define PROFILE_BASELINE					(0)
+#define PROFILE_SENSOR_FILTER				(1)
+#define PROFILE_THRESHOLD					(2)
+#define PROFILE_GESTURE						(3)
+#define PROFILE_LED							(4)
+#define PROFILE_HID							(5)
+#define PROFILE_USB							(6)
+#define PROFILE_FRAME						(7)
+#define PROFILE_STAGES						(8)
+
+/* Histogram buckets. Bucket n counts the durations of 2^n to 2^(n+1) - 1 
+ * cycles, the last bucket counts all the longer durations.
+ */
+#define PROFILE_BUCKETS						(24)
+
+/* Probes - place PROFILE_BEGIN(stage) and PROFILE_END(stage) around the code
+ * to be measured.
+ */
+#if(PROFILE_ENABLE)
+	#define PROFILE_BEGIN(stage)			Profile_Begin(stage)
+	#define PROFILE_END(stage)				Profile_End(stage)
+#else
+	#define PROFILE_BEGIN(stage)
+	#define PROFILE_END(stage)
+#endif /* #if(PROFILE_ENABLE) */
+
+
+/*******************************************************************************
+* Data Type Definitions
+*******************************************************************************/
+
+/* Statistics of a measured duration, in system clock cycles */
+typedef struct
+{
+	uint32 count;
+	uint32 min;
+	uint32 max;
+	uint64 sum;
+	uint16 histogram[PROFILE_BUCKETS];
+} tProfileStat;
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void Profile_Begin(uint32 stage);
+void Profile_End(uint32 stage);
+void Profile_Dump(void);
+void Profile_Clear(void);
+
+void Profile_Accumulate(tProfileStat *stat, uint32 cycles);
+void Profile_ClearStat(tProfileStat *stat);
+void Profile_PrintStat(const char8 name[], const tProfileStat *stat);
+
+
+#endif /* #ifndef PROFILE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,265 @@
+/*******************************************************************************
+* File Name: ReportDigest.c
+*
+* Version 1.0
+*
+* Description: This file contains the CRC-32 digest of the HID report stream,
+*               which is compared against a golden digest when replaying or
+*               synthesizing traces
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "ReportDigest.h"
+#include "GestureStats.h"
+#include "Telemetry.h"
+#include "stdbool.h"
+
+
+#if(REPORT_DIGEST_ENABLE)
+
+/*******************************************************************************
+*	Macro Definitions
+********************************************************************************/
+
+/* Reflected CRC-32 polynomial (IEEE 802.3) and initial value */
+#define REPORT_DIGEST_POLY					(0xEDB88320u)
+#define REPORT_DIGEST_INIT					(0xFFFFFFFFu)
+
+
+/*******************************************************************************
+* 	External Variable Declarations
+*******************************************************************************/
+
+/* Keyboard, Mouse and Consumer control HID report arrays, declared in 
+ * HidReport.c 
+ */
+extern uint8 keyboardReport[];
+extern int8 mouseReport[];
+#if(CONSUMER_REPORT_ENABLE)
+	extern uint8 consumerReport[];
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Running CRC of the reports and number of frames included */
+static uint32 digest = REPORT_DIGEST_INIT;
+static uint32 digestFrames;
+
+/* Set once the digest is printed, the following frames are ignored */
+static bool isDigestComplete;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void ReportDigest_Add(const uint8 *data, uint32 length);
+static void ReportDigest_Finish(void);
+
+#endif /* #if(REPORT_DIGEST_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: ReportDigest_Update
+********************************************************************************
+* Summary:
+*  Adds the keyboard and mouse reports of the frame to the digest, and 
+*  completes the digest at the end of the run.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  The digest covers the report buffers as ConvertGestureToHidReport() left 
+*  them in every processed frame, sent or not. It is not the report stream the
+*  host receives: on the single interface, a report without new data is not 
+*  sent again, and the host does not see the frame number. The digest only 
+*  depends on the gesture engine and the report conversion, which is what it
+*  guards. When the digest is completed it is printed as 
+*  digest,<frames>,<crc>. With REPORT_DIGEST_PRINT_REPORTS, every frame is 
+*  also printed as report,<frame>,<keyboard bytes>,<mouse bytes>, the format
+*  of the golden report streams in Host/traces.
+*
+*******************************************************************************/
+void ReportDigest_Update(void)
+{
+	#if(REPORT_DIGEST_ENABLE)
+		#if(REPORT_DIGEST_PRINT_REPORTS)
+			uint32 i;
+		#endif /* #if(REPORT_DIGEST_PRINT_REPORTS) */
+		
+		if(isDigestComplete)
+		{
+			return;
+		}
+		
+		ReportDigest_Add(keyboardReport, KEY_RPT_SIZE);
+		ReportDigest_Add((const uint8 *)mouseReport, MOUSE_RPT_SIZE);
+		#if(CONSUMER_REPORT_ENABLE)
+			ReportDigest_Add(consumerReport, CONSUMER_RPT_SIZE);
+		#endif /* #if(CONSUMER_REPORT_ENABLE) */
+		digestFrames++;
+		
+		#if(REPORT_DIGEST_PRINT_REPORTS)
+			Telemetry_Flush();
+			UART_UartPutString("report");
+			PrintField(digestFrames);
+			for(i = 0; i < KEY_RPT_SIZE; i++)
+			{
+				PrintField(keyboardReport[i]);
+			}
+			for(i = 0; i < MOUSE_RPT_SIZE; i++)
+			{
+				PrintField((uint8)mouseReport[i]);
+			}
+			#if(CONSUMER_REPORT_ENABLE)
+				for(i = 0; i < CONSUMER_RPT_SIZE; i++)
+				{
+					PrintField(consumerReport[i]);
+				}
+			#endif /* #if(CONSUMER_REPORT_ENABLE) */
+			UART_UartPutString("\n\r");
+		#endif /* #if(REPORT_DIGEST_PRINT_REPORTS) */
+		
+		if((digestFrames >= REPORT_DIGEST_FRAMES) || (SensorTrace_GetLabel() == GESTURE_STATS_LABEL_DUMP))
+		{
+			ReportDigest_Finish();
+		}
+	#endif /* #if(REPORT_DIGEST_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: ReportDigest_IsComplete
+********************************************************************************
+* Summary:
+*  Returns whether the digest is completed and printed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true once the digest is printed, always false when 
+*         REPORT_DIGEST_ENABLE is disabled
+*
+*******************************************************************************/
+bool ReportDigest_IsComplete(void)
+{
+	#if(REPORT_DIGEST_ENABLE)
+		return isDigestComplete;
+	#else
+		return false;
+	#endif /* #if(REPORT_DIGEST_ENABLE) */
+}
+
+
+#if(REPORT_DIGEST_ENABLE)
+
+/*******************************************************************************
+* Function Name: ReportDigest_Add
+********************************************************************************
+* Summary:
+*  Adds bytes to the running CRC-32.
+*
+* Parameters:
+*  data - bytes to add
+*  length - number of bytes
+*
+* Return:
+*  None
+*
+* Theory:
+*  Bitwise CRC without lookup table; twelve bytes per frame do not justify 
+*  the flash of a table.
+*
+*******************************************************************************/
+static void ReportDigest_Add(const uint8 *data, uint32 length)
+{
+	uint32 bit;
+	
+	while(length != 0)
+	{
+		digest ^= *data;
+		for(bit = 0; bit < 8; bit++)
+		{
+			if(digest & 1u)
+			{
+				digest = (digest >> 1) ^ REPORT_DIGEST_POLY;
+			}
+			else
+			{
+				digest >>= 1;
+			}
+		}
+		
+		data++;
+		length--;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: ReportDigest_Finish
+********************************************************************************
+* Summary:
+*  Completes the digest and prints it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ReportDigest_Finish(void)
+{
+	Telemetry_Flush();
+	UART_UartPutString("digest");
+	PrintField(digestFrames);
+	PrintField(digest ^ REPORT_DIGEST_INIT);
+	UART_UartPutString("\n\r");
+	
+	isDigestComplete = true;
+}
+
+#endif /* #if(REPORT_DIGEST_ENABLE) */
+
+
+/* [] END OF FILE */
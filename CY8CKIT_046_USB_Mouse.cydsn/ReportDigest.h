@@ -0,0 +1,85 @@
+/*****************************************************************************
+* File Name		: ReportDigest.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  ReportDigest.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef REPORT_DIGEST_H		/* Guard to prevent multiple inclusions */
+#define REPORT_DIGEST_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "SensorTrace.h"
+#include "stdbool.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables the digest of the HID reports. Enabled by default when
+ * replaying or synthesizing traces, as the reports then only depend on the 
+ * trace and on the firmware. The digest of a device run equals the one the
+ * host build prints for the same trace, if both process the same frames.
+ */
+#define REPORT_DIGEST_ENABLE				(SENSOR_TRACE_INJECT)
+
+/* The digest is completed and printed after this number of frames, or at a
+ * replayed frame labeled GESTURE_STATS_LABEL_DUMP, whichever comes first.
+ */
+#define REPORT_DIGEST_FRAMES				(16384u)
+
+/* Prints the reports of every frame, so that the outputs of two firmware 
+ * versions can be compared byte by byte to find the first frame that differs.
+ * The host tests SynthDigestTest and ReplayDigestTest compare the reports of
+ * every frame with the golden report streams in Host/traces instead.
+ */
+#define REPORT_DIGEST_PRINT_REPORTS			(DISABLED)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void ReportDigest_Update(void);
+bool ReportDigest_IsComplete(void);
+
+
+#endif /* #ifndef REPORT_DIGEST_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+/*******************************************************************************
+* File Name: SensorFilter.c
+*
+* Version 1.0
+*
+* Description: This file contains the per-sensor median and IIR filters applied
+*               to the CapSense difference counts.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "SensorFilter.h"
+#include "Platform.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Minimum, maximum and selection without branches. The mask is all ones when
+ * the condition is true and zero otherwise.
+ */
+#define FILTER_MASK(condition)				((uint32)0 - (uint32)(condition))
+#define FILTER_SELECT(mask, a, b)			(((a) & (mask)) | ((b) & ~(mask)))
+#define FILTER_MIN(a, b)					FILTER_SELECT(FILTER_MASK((a) < (b)), (a), (b))
+#define FILTER_MAX(a, b)					FILTER_SELECT(FILTER_MASK((a) > (b)), (a), (b))
+
+/* Fractional bits of the IIR filter state */
+#define FILTER_IIR_FRAC_BITS				(4)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Two previous inputs of the median filter of each sensor */
+static uint32 medianHistory1[CapSense_TOTAL_SENSOR_COUNT];
+static uint32 medianHistory2[CapSense_TOTAL_SENSOR_COUNT];
+
+/* IIR filter state of each sensor, with FILTER_IIR_FRAC_BITS fractional bits */
+static uint32 iirState[CapSense_TOTAL_SENSOR_COUNT];
+
+
+/*******************************************************************************
+* Function Name: SensorFilter_Init
+********************************************************************************
+* Summary:
+*  Clears the filter history of all the sensors.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SensorFilter_Init(void)
+{
+	uint32 i;
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		medianHistory1[i] = 0;
+		medianHistory2[i] = 0;
+		iirState[i] = 0;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: SensorFilter_Process
+********************************************************************************
+* Summary:
+*  Filters the difference counts of all the sensors in place. Must be called
+*  after CapSense_UpdateEnabledBaselines() and before 
+*  CapSense_CheckIsAnyWidgetActive(), so that the sensor status and the slider
+*  centroid are both calculated from the filtered values.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  Both filters are calculated for every sensor and the output is selected 
+*  with masks, so the loop has no data dependent branches and takes the same
+*  time every frame. The IIR state only needs a subtract, a shift and an add.
+*
+*******************************************************************************/
+void SensorFilter_Process(void)
+{
+	#if(SENSOR_FILTER_ENABLE)
+		uint32 i, input, median, output, medianSel, iirSel;
+		
+		for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+		{
+			input = (uint32)GetSignal(i);
+			
+			/* median(a, b, c) = max(min(a, b), min(max(a, b), c)) */
+			median = FILTER_MAX(FILTER_MIN(input, medianHistory1[i]), 
+								FILTER_MIN(FILTER_MAX(input, medianHistory1[i]), medianHistory2[i]));
+			medianHistory2[i] = medianHistory1[i];
+			medianHistory1[i] = input;
+			
+			medianSel = FILTER_MASK((SENSOR_FILTER_MEDIAN_MASK >> i) & 1u);
+			output = FILTER_SELECT(medianSel, median, input);
+			
+			/* The state is updated for all the sensors; the shift is arithmetic
+			 * so that a falling input is followed as well. 
+			 */
+			iirState[i] = (uint32)((int32)iirState[i] + 
+				(((int32)(output << FILTER_IIR_FRAC_BITS) - (int32)iirState[i]) >> SENSOR_FILTER_IIR_SHIFT));
+			
+			iirSel = FILTER_MASK((SENSOR_FILTER_IIR_MASK >> i) & 1u);
+			output = FILTER_SELECT(iirSel, (iirState[i] + (1u << (FILTER_IIR_FRAC_BITS - 1u))) >> FILTER_IIR_FRAC_BITS, output);
+			
+			CapSense_sensorSignal[i] = output;
+		}
+	#endif /* #if(SENSOR_FILTER_ENABLE) */
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*****************************************************************************
+* File Name		: SensorFilter.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  SensorFilter.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SENSOR_FILTER_H		/* Guard to prevent multiple inclusions */
+#define SENSOR_FILTER_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "Gesture.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables filtering of the difference counts. Disabled by 
+ * default, as the filters delay a touch: the median by 1 frame, and the IIR 
+ * with a shift of 1 by 2 frames for a signal of 250 against the default 
+ * finger threshold plus hysteresis of 210 (125, 188, 219). Enable it on noisy
+ * boards, and check the cost with the "filter" profile stage and the touch to
+ * report time with Latency_Dump().
+ */
+#ifndef SENSOR_FILTER_ENABLE
+	#define SENSOR_FILTER_ENABLE			(DISABLED)
+#endif /* #ifndef SENSOR_FILTER_ENABLE */
+
+/* Mask of all the sensors (5 buttons and 8 slider segments) */
+#define SENSOR_FILTER_ALL_SENSORS			((1u << CapSense_TOTAL_SENSOR_COUNT) - 1u)
+
+/* Mask of the radial slider segments */
+#define SENSOR_FILTER_SLIDER_SENSORS		(((1u << RADIAL_SLIDER_SEGMENTS) - 1u) << SLIDER_ID)
+
+/* Sensors filtered by the 3-tap median filter (bit n = sensor n). The median
+ * removes single scan spikes from the slider segments, which otherwise make
+ * the centroid jump.
+ */
+#define SENSOR_FILTER_MEDIAN_MASK			(SENSOR_FILTER_SLIDER_SENSORS)
+
+/* Sensors filtered by the first order IIR filter (bit n = sensor n). The IIR
+ * is applied after the median when both are selected.
+ */
+#define SENSOR_FILTER_IIR_MASK				(SENSOR_FILTER_ALL_SENSORS)
+
+/* IIR filter coefficient as a right shift: 
+ * output += (input - output) / 2^SENSOR_FILTER_IIR_SHIFT 
+ */
+#define SENSOR_FILTER_IIR_SHIFT				(1)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void SensorFilter_Init(void);
+void SensorFilter_Process(void);
+
+
+#endif /* #ifndef SENSOR_FILTER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,309 @@
+/*******************************************************************************
+* File Name: SensorTrace.c
+*
+* Version 1.0
+*
+* Description: This file contains the sensor trace recorder, which streams the
+*               sensor data of every frame over UART, and the trace replay.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "SensorTrace.h"
+#include "AdaptiveThreshold.h"
+#include "GestureStats.h"
+#include "Timebase.h"
+#include "TouchSynth.h"
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+#if(SENSOR_TRACE_MODE != SENSOR_TRACE_OFF)
+	/* Frame being sent or received */
+	static uint8 traceFrame[TRACE_FRAME_SIZE];
+#endif /* #if(SENSOR_TRACE_MODE != SENSOR_TRACE_OFF) */
+
+#if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY)
+	/* Bytes of traceFrame received so far, TRACE_FRAME_SIZE once a valid 
+	 * frame is waiting to be replayed 
+	 */
+	static uint32 received;
+#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY) */
+
+/* Label of the last replayed or synthesized frame */
+static uint8 replayLabel = TRACE_LABEL_NONE;
+
+#if(SENSOR_TRACE_INJECT)
+	/* Set until the first frame of a trace is injected */
+	static bool isTraceStart = true;
+#endif /* #if(SENSOR_TRACE_INJECT) */
+
+
+/*******************************************************************************
+*   External Variable Declarations
+*******************************************************************************/
+
+/* Indicates the centroid value of the radial slider. */
+extern uint16 sliderCentroid;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+#if((SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD) || (SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY))
+	static uint8 SensorTrace_Checksum(void);
+#endif /* #if((SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD) || (SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY)) */
+
+
+/*******************************************************************************
+* Function Name: SensorTrace_Record
+********************************************************************************
+* Summary:
+*  Sends the sensor data of the current frame over UART, when the trace mode is
+*  SENSOR_TRACE_RECORD. Must be called after DetectGesture().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SensorTrace_Record(void)
+{
+	#if(SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD)
+		uint32 i, signal, timestamp = Timebase_GetMs();
+		
+		traceFrame[0] = TRACE_SYNC_0;
+		traceFrame[1] = TRACE_SYNC_1;
+		traceFrame[TRACE_TIMESTAMP_POS] = (uint8)timestamp;
+		traceFrame[TRACE_TIMESTAMP_POS + 1] = (uint8)(timestamp >> 8);
+		
+		for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+		{
+			signal = (uint32)GetSignal(i);
+			traceFrame[TRACE_SIGNAL_POS + i] = (uint8)((signal > 0xFFu) ? 0xFFu : signal);
+		}
+		
+		traceFrame[TRACE_CENTROID_POS] = (uint8)sliderCentroid;
+		traceFrame[TRACE_CENTROID_POS + 1] = (uint8)(sliderCentroid >> 8);
+		traceFrame[TRACE_MASK_POS] = (uint8)(CapSense_sensorOnMask[0] & (LEFT_BTN_MASK | RIGHT_BTN_MASK | UP_BTN_MASK | DOWN_BTN_MASK | CENTRE_BTN_MASK));
+		if(sliderCentroid != 0xFFFFu)
+		{
+			traceFrame[TRACE_MASK_POS] |= SLIDER_ACT_MASK;
+		}
+		traceFrame[TRACE_LABEL_POS] = TRACE_LABEL_NONE;
+		traceFrame[TRACE_CHECKSUM_POS] = SensorTrace_Checksum();
+		
+		UART_SpiUartPutArray(traceFrame, TRACE_FRAME_SIZE);
+	#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD) */
+}
+
+
+/*******************************************************************************
+* Function Name: SensorTrace_IsFrameReady
+********************************************************************************
+* Summary:
+*  When the trace mode is SENSOR_TRACE_REPLAY, reads the bytes received on the
+*  UART so far into the next frame, without waiting for more. The main loop 
+*  only processes a frame once this returns true, and keeps servicing USB in 
+*  the meantime.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true if a valid frame is waiting to be replayed. Always true in the
+*         other modes.
+*
+* Theory:
+*  The receiver synchronizes on the two sync bytes and drops frames with a 
+*  wrong checksum. No byte is read past a complete frame, so the following
+*  frames wait in the UART receive buffer.
+*
+*******************************************************************************/
+bool SensorTrace_IsFrameReady(void)
+{
+	#if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY)
+		uint8 data;
+		
+		while((received < TRACE_FRAME_SIZE) && (UART_SpiUartGetRxBufferSize() != 0))
+		{
+			data = (uint8)UART_SpiUartReadRxData();
+			
+			/* Hunt for the sync bytes */
+			if((received == 0) && (data != TRACE_SYNC_0))
+			{
+				continue;
+			}
+			if((received == 1) && (data != TRACE_SYNC_1))
+			{
+				received = (data == TRACE_SYNC_0) ? 1 : 0;
+				continue;
+			}
+			
+			traceFrame[received++] = data;
+			
+			if((received == TRACE_FRAME_SIZE) && (traceFrame[TRACE_CHECKSUM_POS] != SensorTrace_Checksum()))
+			{
+				received = 0;
+			}
+		}
+		
+		return (received == TRACE_FRAME_SIZE);
+	#else
+		return true;
+	#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY) */
+}
+
+
+/*******************************************************************************
+* Function Name: SensorTrace_Replay
+********************************************************************************
+* Summary:
+*  When the trace mode is SENSOR_TRACE_REPLAY, replaces the difference counts
+*  and the sensor on mask of the current scan with the frame received by 
+*  SensorTrace_IsFrameReady(). When the trace mode is SENSOR_TRACE_SYNTH, the
+*  frame is synthesized by TouchSynth_Generate() instead. Must be called after 
+*  CapSense_CheckIsAnyWidgetActive() and before AdaptiveThreshold_Update() and
+*  DetectGesture(), in a frame for which SensorTrace_IsFrameReady() returned 
+*  true.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - 1 if any sensor is active in the injected frame, 0 otherwise. In
+*           the other modes, the result of CapSense_CheckIsAnyWidgetActive()
+*           must be used instead.
+*
+* Theory:
+*  Frames are processed as fast as they arrive, at most one per USB polling
+*  interval, so a trace replays at the lower of the UART and the polling rate
+*  instead of the rate it was recorded at.
+*  The raw counts are set to the baseline plus the difference counts of the 
+*  frame, so that the noise estimate samples the trace and not the scan it 
+*  replaces. The estimate is cleared at the first frame of a trace, the first
+*  frame injected or the one after a GESTURE_STATS_LABEL_DUMP frame, so that
+*  the thresholds and the reports only depend on the trace.
+*
+*******************************************************************************/
+uint32 SensorTrace_Replay(void)
+{
+	#if(SENSOR_TRACE_INJECT)
+		uint32 i;
+		
+		#if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY)
+			/* The frame is consumed, receive the next one */
+			received = 0;
+		#else
+			TouchSynth_Generate(traceFrame);
+		#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY) */
+		
+		if(isTraceStart)
+		{
+			AdaptiveThreshold_Init();
+		}
+		
+		for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+		{
+			CapSense_sensorSignal[i] = traceFrame[TRACE_SIGNAL_POS + i];
+			CapSense_sensorRaw[i] = (uint16)(CapSense_sensorBaseline[i] + traceFrame[TRACE_SIGNAL_POS + i]);
+		}
+		
+		CapSense_sensorOnMask[0] = (uint8)((CapSense_sensorOnMask[0] & ~(LEFT_BTN_MASK | RIGHT_BTN_MASK | UP_BTN_MASK | DOWN_BTN_MASK | CENTRE_BTN_MASK)) |
+								   (traceFrame[TRACE_MASK_POS] & (LEFT_BTN_MASK | RIGHT_BTN_MASK | UP_BTN_MASK | DOWN_BTN_MASK | CENTRE_BTN_MASK)));
+		replayLabel = traceFrame[TRACE_LABEL_POS];
+		isTraceStart = (replayLabel == GESTURE_STATS_LABEL_DUMP);
+		
+		return (traceFrame[TRACE_MASK_POS] != 0) ? 1u : 0u;
+	#else
+		return 0;
+	#endif /* #if(SENSOR_TRACE_INJECT) */
+}
+
+
+/*******************************************************************************
+* Function Name: SensorTrace_GetLabel
+********************************************************************************
+* Summary:
+*  Returns the label of the last replayed or synthesized frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - label, TRACE_LABEL_NONE if no frames are injected
+*
+*******************************************************************************/
+uint32 SensorTrace_GetLabel(void)
+{
+	return replayLabel;
+}
+
+
+#if((SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD) || (SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY))
+
+/*******************************************************************************
+* Function Name: SensorTrace_Checksum
+********************************************************************************
+* Summary:
+*  Calculates the checksum of the trace frame.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8 - 8 bit sum of the timestamp, data and label bytes
+*
+*******************************************************************************/
+static uint8 SensorTrace_Checksum(void)
+{
+	uint32 i;
+	uint8 sum = 0;
+	
+	for(i = TRACE_TIMESTAMP_POS; i < TRACE_CHECKSUM_POS; i++)
+	{
+		sum += traceFrame[i];
+	}
+	
+	return sum;
+}
+
+#endif /* #if((SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD) || (SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,120 @@
+/*****************************************************************************
+* File Name		: SensorTrace.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes, constants and the binary
+*  frame format used in SensorTrace.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SENSOR_TRACE_H		/* Guard to prevent multiple inclusions */
+#define SENSOR_TRACE_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "Gesture.h"
+#include "stdbool.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Trace modes:
+ * SENSOR_TRACE_OFF - normal operation.
+ * SENSOR_TRACE_RECORD - every processed frame is sent over UART.
+ * SENSOR_TRACE_REPLAY - the scan results are replaced by frames received over
+ *                       UART, one frame per processed frame. A frame is 
+ *                       only processed once its trace frame has arrived.
+ * SENSOR_TRACE_SYNTH - the scan results are replaced by frames synthesized
+ *                      from random finger trajectories, see TouchSynth.h.
+ */
+#define SENSOR_TRACE_OFF					(0)
+#define SENSOR_TRACE_RECORD					(1)
+#define SENSOR_TRACE_REPLAY					(2)
+#define SENSOR_TRACE_SYNTH					(3)
+
+/* Selects the trace mode. The host build selects it per target. */
+#ifndef SENSOR_TRACE_MODE
+	#define SENSOR_TRACE_MODE				(SENSOR_TRACE_OFF)
+#endif /* #ifndef SENSOR_TRACE_MODE */
+
+/* Set when the scan results are replaced by trace frames */
+#define SENSOR_TRACE_INJECT					((SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY) || (SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH))
+
+#if((SENSOR_TRACE_MODE == SENSOR_TRACE_RECORD) && (ENABLE_UART_DBG_OUTPUT))
+	#error "Disable TXDEBUG in main.h - debug strings would corrupt the recorded trace"
+#endif
+
+/* Trace frame format. All multi-byte fields are little endian.
+ * Byte 0-1   : TRACE_SYNC_0, TRACE_SYNC_1
+ * Byte 2-3   : Timestamp, milliseconds (wraps around)
+ * Byte 4-16  : Difference count of the 13 sensors, limited to 255 
+ *              (buttons in sensor order, then slider segments 0 to 7)
+ * Byte 17-18 : sliderCentroid (0xFFFF if the slider is not touched)
+ * Byte 19    : Sensor on mask of the buttons (bit n = sensor n) and slider
+ *              (SLIDER_ACT_MASK)
+ * Byte 20    : Label - free for annotation of the trace, e.g. with the 
+ *              intended tGestureId. Written as TRACE_LABEL_NONE by the
+ *              recorder.
+ * Byte 21    : Checksum - 8 bit sum of bytes 2 to 20
+ */
+#define TRACE_SYNC_0						(0xA5u)
+#define TRACE_SYNC_1						(0x5Au)
+
+#define TRACE_TIMESTAMP_POS					(2)
+#define TRACE_SIGNAL_POS					(4)
+#define TRACE_CENTROID_POS					(TRACE_SIGNAL_POS + CapSense_TOTAL_SENSOR_COUNT)
+#define TRACE_MASK_POS						(TRACE_CENTROID_POS + 2)
+#define TRACE_LABEL_POS						(TRACE_MASK_POS + 1)
+#define TRACE_CHECKSUM_POS					(TRACE_LABEL_POS + 1)
+#define TRACE_FRAME_SIZE					(TRACE_CHECKSUM_POS + 1)
+
+#define TRACE_LABEL_NONE					(0u)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void SensorTrace_Record(void);
+bool SensorTrace_IsFrameReady(void);
+uint32 SensorTrace_Replay(void);
+uint32 SensorTrace_GetLabel(void);
+
+
+#endif /* #ifndef SENSOR_TRACE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,265 @@
+/*******************************************************************************
+* File Name: Telemetry.c
+*
+* Version 1.0
+*
+* Description: This file contains the binary debug telemetry channel.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "Telemetry.h"
+#include "Timebase.h"
+#include "stdbool.h"
+
+
+#if(TELEMETRY_ENABLE)
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+#define TELEMETRY_RING_MASK					(TELEMETRY_RING_SIZE - 1u)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Ring of records. The main loop writes at ringHead, the UART TX interrupt 
+ * reads at ringTail. Each index is written by one side only.
+ */
+static uint8 ring[TELEMETRY_RING_SIZE];
+static volatile uint32 ringHead, ringTail;
+
+/* Sequence number of the next record, and records lost since the last 
+ * successful write 
+ */
+static uint8 sequence;
+static uint32 dropped;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static bool Telemetry_Write(uint32 event, uint32 payload);
+static CY_ISR_PROTO(Telemetry_TxIsr);
+
+#endif /* #if(TELEMETRY_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: Telemetry_Init
+********************************************************************************
+* Summary:
+*  Registers the UART TX interrupt handler that drains the ring. Must be 
+*  called after UART_Start().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+* Theory:
+*  The UART must be configured with a TX buffer no larger than the FIFO, so 
+*  that the component does not use the TX interrupt itself.
+*
+*******************************************************************************/
+void Telemetry_Init(void)
+{
+	#if(TELEMETRY_ENABLE)
+		ringHead = 0;
+		ringTail = 0;
+		
+		UART_SetTxInterruptMode(0u);
+		UART_SetCustomInterruptHandler(&Telemetry_TxIsr);
+	#endif /* #if(TELEMETRY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Telemetry_Event
+********************************************************************************
+* Summary:
+*  Queues an event record for transmission. Does not wait; the record is 
+*  dropped and counted if the ring is full.
+*
+* Parameters:
+*  event - event id, TELEMETRY_EVENT_x
+*  payload - 16 bit payload of the event
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Telemetry_Event(uint32 event, uint32 payload)
+{
+	#if(TELEMETRY_ENABLE)
+		/* Report the lost records first */
+		if(dropped != 0)
+		{
+			if(Telemetry_Write(TELEMETRY_EVENT_DROPPED, dropped))
+			{
+				dropped = 0;
+			}
+		}
+		
+		if((dropped != 0) || !Telemetry_Write(event, payload))
+		{
+			dropped++;
+		}
+		else
+		{
+			/* Start draining */
+			UART_SetTxInterruptMode(UART_INTR_TX_NOT_FULL);
+		}
+	#endif /* #if(TELEMETRY_ENABLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: Telemetry_Flush
+********************************************************************************
+* Summary:
+*  Waits until all the queued records are handed to the UART. Must be called 
+*  before writing to the UART directly, e.g. for the debug dumps.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Telemetry_Flush(void)
+{
+	#if(TELEMETRY_ENABLE)
+		while(ringTail != ringHead)
+		{
+		}
+	#endif /* #if(TELEMETRY_ENABLE) */
+}
+
+
+#if(TELEMETRY_ENABLE)
+
+/*******************************************************************************
+* Function Name: Telemetry_Write
+********************************************************************************
+* Summary:
+*  Writes a record to the ring.
+*
+* Parameters:
+*  event - event id
+*  payload - 16 bit payload
+*
+* Return:
+*  bool - true if written, false if the ring is full
+*
+*******************************************************************************/
+static bool Telemetry_Write(uint32 event, uint32 payload)
+{
+	uint32 head = ringHead, timestamp = Timebase_GetMs();
+	uint8 record[TELEMETRY_RECORD_SIZE];
+	uint32 i;
+	
+	if((TELEMETRY_RING_SIZE - ((head - ringTail) & TELEMETRY_RING_MASK)) <= TELEMETRY_RECORD_SIZE)
+	{
+		return false;
+	}
+	
+	record[0] = TELEMETRY_SYNC;
+	record[1] = (uint8)event;
+	record[2] = (uint8)timestamp;
+	record[3] = (uint8)(timestamp >> 8);
+	record[4] = (uint8)payload;
+	record[5] = (uint8)(payload >> 8);
+	record[6] = sequence++;
+	record[7] = 0;
+	
+	for(i = 1; i < (TELEMETRY_RECORD_SIZE - 1u); i++)
+	{
+		record[7] += record[i];
+	}
+	
+	for(i = 0; i < TELEMETRY_RECORD_SIZE; i++)
+	{
+		ring[(head + i) & TELEMETRY_RING_MASK] = record[i];
+	}
+	
+	/* Publish the record */
+	ringHead = (head + TELEMETRY_RECORD_SIZE) & TELEMETRY_RING_MASK;
+	
+	return true;
+}
+
+
+/*******************************************************************************
+* Function Name: Telemetry_TxIsr
+********************************************************************************
+* Summary:
+*  UART interrupt handler. Fills the TX FIFO from the ring, and disables the 
+*  TX FIFO not full interrupt when the ring is empty.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static CY_ISR(Telemetry_TxIsr)
+{
+	uint32 tail = ringTail;
+	
+	while((tail != ringHead) && (UART_SpiUartGetTxBufferSize() < UART_SPI_UART_FIFO_SIZE))
+	{
+		UART_SpiUartWriteTxData(ring[tail]);
+		tail = (tail + 1u) & TELEMETRY_RING_MASK;
+	}
+	ringTail = tail;
+	
+	if(tail == ringHead)
+	{
+		UART_SetTxInterruptMode(0u);
+	}
+	
+	UART_ClearTxInterruptSource(UART_INTR_TX_NOT_FULL);
+}
+
+#endif /* #if(TELEMETRY_ENABLE) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/*****************************************************************************
+* File Name		: Telemetry.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  Telemetry.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TELEMETRY_H		/* Guard to prevent multiple inclusions */
+#define TELEMETRY_H
+
+#include "cytypes.h"
+#include "main.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Enables or disables the telemetry channel. Enabled with the debug output, 
+ * as both use the UART.
+ */
+#define TELEMETRY_ENABLE					(ENABLE_UART_DBG_OUTPUT)
+
+/* Size of the RAM ring in bytes, must be a power of 2 */
+#define TELEMETRY_RING_SIZE					(256u)
+
+/* Record format. Records are 8 bytes, multi-byte fields are little endian.
+ * Byte 0   : TELEMETRY_SYNC
+ * Byte 1   : Event id, TELEMETRY_EVENT_x
+ * Byte 2-3 : Timestamp, milliseconds (wraps around)
+ * Byte 4-5 : Payload, depends on the event
+ * Byte 6   : Sequence number, incremented for every record
+ * Byte 7   : Checksum - 8 bit sum of bytes 1 to 6
+ * Host/tools/TelemetryDecode.py renders the records of the UART output as text.
+ */
+#define TELEMETRY_SYNC						(0xC3u)
+#define TELEMETRY_RECORD_SIZE				(8u)
+
+/* Events and their payload */
+#define TELEMETRY_EVENT_DROPPED				(0u)	/* Records lost because the ring was full */
+#define TELEMETRY_EVENT_APP_START			(1u)	/* None */
+#define TELEMETRY_EVENT_USB_DISCONNECTED	(2u)	/* None */
+#define TELEMETRY_EVENT_DRIVERS_INSTALLED	(3u)	/* None */
+#define TELEMETRY_EVENT_GESTURE				(4u)	/* tGestureId reported to the host, clicks as x_CLICK */
+#define TELEMETRY_EVENT_TOUCH_DOWN			(5u)	/* Sector | radius << 8 */
+#define TELEMETRY_EVENT_TOUCH_UP			(6u)	/* None */
+#define TELEMETRY_EVENT_SECTOR				(7u)	/* New sector */
+#define TELEMETRY_EVENT_LED_COLOR			(8u)	/* tLedColor */
+#define TELEMETRY_EVENT_THRESHOLD			(9u)	/* Widget | finger threshold << 8 */
+#define TELEMETRY_EVENT_LED_STATUS			(10u)	/* tLedStatus shown, LED_STATUS_NONE when cleared */
+#define TELEMETRY_EVENT_POLL_INTERVAL		(11u)	/* Endpoint address | bInterval << 8, not HID_POLL_INTERVAL_MS */
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void Telemetry_Init(void);
+void Telemetry_Event(uint32 event, uint32 payload);
+void Telemetry_Flush(void);
+
+
+#endif /* #ifndef TELEMETRY_H */
+
+
+/* [] END OF FILE */
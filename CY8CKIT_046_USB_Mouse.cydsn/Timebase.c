@@ -0,0 +1,185 @@
+/*******************************************************************************
+* File Name: Timebase.c
+*
+* Version 1.0
+*
+* Description: This file contains the millisecond time base of the application,
+*               driven by the SysTick timer.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "Timebase.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* SysTick callback slot used by the time base */
+#define TIMEBASE_SYSTICK_CALLBACK			(0u)
+
+/* SysTick exception pending bit (PENDSTSET) of the Interrupt Control and State
+ * Register 
+ */
+#define TIMEBASE_ICSR_PENDSTSET				(0x04000000u)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Milliseconds since Timebase_Init(), incremented by the SysTick interrupt */
+static volatile uint32 msCounter;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void Timebase_SysTickCallback(void);
+
+
+/*******************************************************************************
+* Function Name: Timebase_Init
+********************************************************************************
+* Summary:
+*  Starts the SysTick timer with its default 1 ms period and registers the
+*  time base callback.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Timebase_Init(void)
+{
+	msCounter = 0;
+	
+	CySysTickStart();
+	(void)CySysTickSetCallback(TIMEBASE_SYSTICK_CALLBACK, Timebase_SysTickCallback);
+}
+
+
+/*******************************************************************************
+* Function Name: Timebase_GetMs
+********************************************************************************
+* Summary:
+*  Returns the time since Timebase_Init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - time in milliseconds
+*
+*******************************************************************************/
+uint32 Timebase_GetMs(void)
+{
+	return msCounter;
+}
+
+
+/*******************************************************************************
+* Function Name: Timebase_GetCycles
+********************************************************************************
+* Summary:
+*  Returns a free running count of system clock cycles, combining the 
+*  millisecond counter with the current value of the SysTick down counter.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - cycle count, wraps around. Only differences are meaningful.
+*
+* Theory:
+*  The millisecond counter is read before and after the SysTick value, and the
+*  read is repeated if the SysTick interrupt occurred in between.
+*
+*  With the interrupts disabled (in a critical section or an interrupt of the
+*  same or higher priority) the counter can reload without the millisecond 
+*  counter being incremented. The SysTick pending bit tells this case apart:
+*  when it is set, the value is read again, so that it is known to be from 
+*  after the reload, and the pending period is added. The count stays 
+*  monotonic as long as the interrupts are not disabled for more than one 
+*  period. The COUNTFLAG bit is not used, as reading it clears it.
+*
+*******************************************************************************/
+uint32 Timebase_GetCycles(void)
+{
+	uint32 ms, value, isPending, reload = CySysTickGetReload();
+	
+	do
+	{
+		ms = msCounter;
+		value = CySysTickGetValue();
+		
+		isPending = CY_GET_REG32(CYREG_CM0_ICSR) & TIMEBASE_ICSR_PENDSTSET;
+		if(isPending != 0)
+		{
+			value = CySysTickGetValue();
+		}
+	} while(ms != msCounter);
+	
+	if(isPending != 0)
+	{
+		ms++;
+	}
+	
+	return (ms * (reload + 1u)) + (reload - value);
+}
+
+
+/*******************************************************************************
+* Function Name: Timebase_SysTickCallback
+********************************************************************************
+* Summary:
+*  SysTick interrupt callback, called every millisecond.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Timebase_SysTickCallback(void)
+{
+	msCounter++;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,606 @@
+/*******************************************************************************
+* File Name: TouchSynth.c
+*
+* Version 1.0
+*
+* Description: This file contains the synthetic touch trajectory generator.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "TouchSynth.h"
+#include "GestureStats.h"
+#include "stdbool.h"
+
+
+#if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH)
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Angle of the centre of each button */
+static const int32 synthButtonAngle[TOUCH_SYNTH_DIRECTIONS] = 
+{
+	[TOUCH_SYNTH_UP] = TOUCH_SYNTH_CIRCLE / 8,
+	[TOUCH_SYNTH_LEFT] = 3 * TOUCH_SYNTH_CIRCLE / 8,
+	[TOUCH_SYNTH_DOWN] = -3 * TOUCH_SYNTH_CIRCLE / 8,
+	[TOUCH_SYNTH_RIGHT] = -TOUCH_SYNTH_CIRCLE / 8
+};
+
+/* Sensor and widget of each button */
+static const uint8 synthButtonSensor[TOUCH_SYNTH_DIRECTIONS] = 
+{
+	[TOUCH_SYNTH_UP] = UP_BTN_ID,
+	[TOUCH_SYNTH_LEFT] = LEFT_BTN_ID,
+	[TOUCH_SYNTH_DOWN] = DOWN_BTN_ID,
+	[TOUCH_SYNTH_RIGHT] = RIGHT_BTN_ID
+};
+
+static const uint8 synthButtonWidget[TOUCH_SYNTH_DIRECTIONS] = 
+{
+	[TOUCH_SYNTH_UP] = CapSense_UP__BTN,
+	[TOUCH_SYNTH_LEFT] = CapSense_LEFT__BTN,
+	[TOUCH_SYNTH_DOWN] = CapSense_DOWN__BTN,
+	[TOUCH_SYNTH_RIGHT] = CapSense_RIGHT__BTN
+};
+
+/* Labels of the taps on and of the swipes towards each button */
+static const uint8 synthClickLabel[TOUCH_SYNTH_DIRECTIONS] = 
+{
+	[TOUCH_SYNTH_UP] = GESTURE_UP_CLICK,
+	[TOUCH_SYNTH_LEFT] = GESTURE_LEFT_CLICK,
+	[TOUCH_SYNTH_DOWN] = GESTURE_DOWN_CLICK,
+	[TOUCH_SYNTH_RIGHT] = GESTURE_RIGHT_CLICK
+};
+
+static const uint8 synthSwipeLabel[TOUCH_SYNTH_DIRECTIONS] = 
+{
+	[TOUCH_SYNTH_UP] = GESTURE_UP_SWIPE,
+	[TOUCH_SYNTH_LEFT] = GESTURE_LEFT_SWIPE,
+	[TOUCH_SYNTH_DOWN] = GESTURE_DOWN_SWIPE,
+	[TOUCH_SYNTH_RIGHT] = GESTURE_RIGHT_SWIPE
+};
+
+/* State of the random generator, and its state when the current trajectory
+ * was created.
+ */
+static uint32 synthRandom = TOUCH_SYNTH_SEED;
+static uint32 synthSeed;
+
+/* Current trajectory. The frames of the release before the touch come first.
+ * The position moves linearly from the start to the end radius and from the
+ * start angle by the sweep angle. A negative radius is on the opposite side 
+ * of the centre, so that straight swipes through the centre are lines too.
+ */
+static uint32 synthFrame;
+static uint32 synthGapFrames;
+static uint32 synthTouchFrames;
+static int32 synthRadiusStart, synthRadiusEnd;
+static int32 synthAngleStart, synthAngleSweep;
+static uint32 synthKind;
+static uint8 synthLabel;
+
+/* Touches synthesized in the current run */
+static uint32 synthTouches;
+static bool synthDumpPending;
+
+/* Time stamp of the synthesized frames and sensor on mask of the previous 
+ * frame 
+ */
+static uint32 synthTimestamp;
+static uint8 synthMask;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static uint32 TouchSynth_Random(uint32 range);
+static int32 TouchSynth_Noise(int32 amplitude);
+static uint32 TouchSynth_Frames(uint32 minMs, uint32 maxMs);
+static void TouchSynth_NewTrajectory(void);
+static uint32 TouchSynth_Weight(int32 distance, int32 width);
+static int32 TouchSynth_AngleDistance(int32 angle1, int32 angle2);
+static uint8 TouchSynth_Signal(uint32 weight, uint32 widget);
+static void TouchSynth_SetMaskBit(uint32 mask, uint32 signal, uint32 widget);
+
+#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH) */
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_Generate
+********************************************************************************
+* Summary:
+*  Synthesizes the next trace frame of a random sequence of taps, swipes 
+*  through the centre, outward swipes and circles on the inner and outer ring.
+*  Each touch is labeled with the gesture it is expected to be recognized as.
+*  With TOUCH_SYNTH_FUZZ_ENABLE, unlabeled touches of random frames are mixed
+*  in.
+*
+* Parameters:
+*  frame - trace frame to fill, refer to SensorTrace.h for the format. The 
+*          sync and checksum bytes are not written.
+*
+* Return:
+*  None
+*
+* Theory:
+*  The difference count of each sensor is the product of a radial and an 
+*  angular triangular response to the finger position, scaled to the finger
+*  threshold and hysteresis of the widget, plus uniform noise. 
+*  The sensor on mask is derived with the finger threshold and hysteresis of
+*  the widgets, as the CapSense component would. After TOUCH_SYNTH_RUN_TOUCHES
+*  touches, the last frame of the next release is labeled 
+*  GESTURE_STATS_LABEL_DUMP to dump the benchmark results.
+*
+*******************************************************************************/
+void TouchSynth_Generate(uint8 frame[])
+{
+	#if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH)
+		uint32 i, t, radialWeight;
+		int32 radius, angle;
+		uint8 label = TRACE_LABEL_NONE;
+		
+		if(synthFrame == 0)
+		{
+			TouchSynth_NewTrajectory();
+		}
+		
+		frame[TRACE_TIMESTAMP_POS] = (uint8)synthTimestamp;
+		frame[TRACE_TIMESTAMP_POS + 1] = (uint8)(synthTimestamp >> 8);
+		synthTimestamp += TOUCH_SYNTH_FRAME_MS;
+		
+		if(synthFrame < synthGapFrames)
+		{
+			/* Release - noise only, the widget does not matter */
+			for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+			{
+				frame[TRACE_SIGNAL_POS + i] = TouchSynth_Signal(0, CapSense_CENTRE__BTN);
+			}
+			
+			if(synthDumpPending && (synthFrame == (synthGapFrames - 1)))
+			{
+				label = GESTURE_STATS_LABEL_DUMP;
+				synthDumpPending = false;
+			}
+		}
+		#if(TOUCH_SYNTH_FUZZ_ENABLE)
+			else if(synthKind == TOUCH_SYNTH_FUZZ)
+			{
+				for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+				{
+					frame[TRACE_SIGNAL_POS + i] = (uint8)TouchSynth_Random(0x100u);
+				}
+			}
+		#endif /* #if(TOUCH_SYNTH_FUZZ_ENABLE) */
+		else
+		{
+			/* Position along the trajectory, t is the elapsed fraction in Q8 */
+			t = ((synthFrame - synthGapFrames) << TOUCH_SYNTH_FRAC_BITS) / (synthTouchFrames - 1);
+			radius = synthRadiusStart + (((synthRadiusEnd - synthRadiusStart) * (int32)t) >> TOUCH_SYNTH_FRAC_BITS);
+			angle = synthAngleStart + ((synthAngleSweep * (int32)t) >> TOUCH_SYNTH_FRAC_BITS);
+			
+			if(radius < 0)
+			{
+				radius = -radius;
+				angle += TOUCH_SYNTH_CIRCLE / 2;
+			}
+			
+			radius += TouchSynth_Noise(TOUCH_SYNTH_JITTER_RADIUS);
+			angle += TouchSynth_Noise(TOUCH_SYNTH_JITTER_ANGLE);
+			if(radius < 0)
+			{
+				radius = 0;
+			}
+			
+			frame[TRACE_SIGNAL_POS + CENTRE_BTN_ID] = TouchSynth_Signal(TouchSynth_Weight(radius, TOUCH_SYNTH_RING_WIDTH), CapSense_CENTRE__BTN);
+			
+			radialWeight = TouchSynth_Weight(radius - TOUCH_SYNTH_BUTTON_RADIUS, TOUCH_SYNTH_RING_WIDTH);
+			for(i = 0; i < TOUCH_SYNTH_DIRECTIONS; i++)
+			{
+				frame[TRACE_SIGNAL_POS + synthButtonSensor[i]] = TouchSynth_Signal((radialWeight * 
+					TouchSynth_Weight(TouchSynth_AngleDistance(angle, synthButtonAngle[i]), TOUCH_SYNTH_BUTTON_WIDTH)) >> TOUCH_SYNTH_FRAC_BITS, 
+					synthButtonWidget[i]);
+			}
+			
+			/* Segment i of the slider is centred on angle i * 45 degrees */
+			radialWeight = TouchSynth_Weight(radius - TOUCH_SYNTH_SLIDER_RADIUS, TOUCH_SYNTH_RING_WIDTH);
+			for(i = 0; i < RADIAL_SLIDER_SEGMENTS; i++)
+			{
+				frame[TRACE_SIGNAL_POS + SLIDER_ID + i] = TouchSynth_Signal((radialWeight * 
+					TouchSynth_Weight(TouchSynth_AngleDistance(angle, (int32)(i * (TOUCH_SYNTH_CIRCLE / RADIAL_SLIDER_SEGMENTS))), TOUCH_SYNTH_SEGMENT_WIDTH)) >> TOUCH_SYNTH_FRAC_BITS, 
+					CapSense_RADIALSLIDER0__RS);
+			}
+			
+			label = synthLabel;
+		}
+		
+		/* Sensor on mask */
+		for(i = 0; i < TOUCH_SYNTH_DIRECTIONS; i++)
+		{
+			TouchSynth_SetMaskBit(1u << synthButtonSensor[i], frame[TRACE_SIGNAL_POS + synthButtonSensor[i]], synthButtonWidget[i]);
+		}
+		TouchSynth_SetMaskBit(CENTRE_BTN_MASK, frame[TRACE_SIGNAL_POS + CENTRE_BTN_ID], CapSense_CENTRE__BTN);
+		
+		t = 0;
+		for(i = 0; i < RADIAL_SLIDER_SEGMENTS; i++)
+		{
+			if(frame[TRACE_SIGNAL_POS + SLIDER_ID + i] > t)
+			{
+				t = frame[TRACE_SIGNAL_POS + SLIDER_ID + i];
+			}
+		}
+		TouchSynth_SetMaskBit(SLIDER_ACT_MASK, t, CapSense_RADIALSLIDER0__RS);
+		
+		#if(TOUCH_SYNTH_FUZZ_ENABLE)
+			if((synthKind == TOUCH_SYNTH_FUZZ) && (synthFrame >= synthGapFrames))
+			{
+				synthMask = (uint8)TouchSynth_Random(SLIDER_ACT_MASK << 1);
+			}
+		#endif /* #if(TOUCH_SYNTH_FUZZ_ENABLE) */
+		
+		/* The centroid is computed by the engine from the difference counts */
+		frame[TRACE_CENTROID_POS] = 0xFFu;
+		frame[TRACE_CENTROID_POS + 1] = 0xFFu;
+		frame[TRACE_MASK_POS] = synthMask;
+		frame[TRACE_LABEL_POS] = label;
+		
+		synthFrame++;
+		if(synthFrame == (synthGapFrames + synthTouchFrames))
+		{
+			synthFrame = 0;
+		}
+	#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH) */
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_GetSeed
+********************************************************************************
+* Summary:
+*  Returns the state of the random generator when the current trajectory was 
+*  created. Used as TOUCH_SYNTH_SEED, it recreates the trajectory as the first
+*  one of the sequence.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - seed of the current trajectory
+*
+*******************************************************************************/
+uint32 TouchSynth_GetSeed(void)
+{
+	#if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH)
+		return synthSeed;
+	#else
+		return 0;
+	#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH) */
+}
+
+
+#if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH)
+
+/*******************************************************************************
+* Function Name: TouchSynth_NewTrajectory
+********************************************************************************
+* Summary:
+*  Creates the next random trajectory and the release before it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void TouchSynth_NewTrajectory(void)
+{
+	uint32 direction;
+	
+	synthSeed = synthRandom;
+	
+	if(synthTouches == TOUCH_SYNTH_RUN_TOUCHES)
+	{
+		synthTouches = 0;
+		synthDumpPending = true;
+	}
+	synthTouches++;
+	
+	synthGapFrames = TouchSynth_Frames(TOUCH_SYNTH_GAP_MIN_MS, TOUCH_SYNTH_GAP_MAX_MS);
+	direction = TouchSynth_Random(TOUCH_SYNTH_DIRECTIONS);
+	
+	synthKind = TouchSynth_Random(TOUCH_SYNTH_KINDS);
+	
+	switch(synthKind)
+	{
+		case TOUCH_SYNTH_TAP_CENTRE:
+			synthTouchFrames = TouchSynth_Frames(TOUCH_SYNTH_TAP_MIN_MS, TOUCH_SYNTH_TAP_MAX_MS);
+			synthRadiusStart = 0;
+			synthRadiusEnd = 0;
+			synthAngleStart = 0;
+			synthAngleSweep = 0;
+			synthLabel = GESTURE_MIDDLE_CLICK;
+			break;
+		
+		case TOUCH_SYNTH_TAP_BUTTON:
+			synthTouchFrames = TouchSynth_Frames(TOUCH_SYNTH_TAP_MIN_MS, TOUCH_SYNTH_TAP_MAX_MS);
+			synthRadiusStart = TOUCH_SYNTH_BUTTON_RADIUS;
+			synthRadiusEnd = TOUCH_SYNTH_BUTTON_RADIUS;
+			synthAngleStart = synthButtonAngle[direction];
+			synthAngleSweep = 0;
+			synthLabel = synthClickLabel[direction];
+			break;
+		
+		case TOUCH_SYNTH_SWIPE:
+			/* From the opposite button through the centre */
+			synthTouchFrames = TouchSynth_Frames(TOUCH_SYNTH_SWIPE_MIN_MS, TOUCH_SYNTH_SWIPE_MAX_MS);
+			synthRadiusStart = -TOUCH_SYNTH_BUTTON_RADIUS;
+			synthRadiusEnd = TOUCH_SYNTH_BUTTON_RADIUS;
+			synthAngleStart = synthButtonAngle[direction];
+			synthAngleSweep = 0;
+			synthLabel = synthSwipeLabel[direction];
+			break;
+		
+		case TOUCH_SYNTH_OUTWARD:
+			synthTouchFrames = TouchSynth_Frames(TOUCH_SYNTH_SWIPE_MIN_MS, TOUCH_SYNTH_SWIPE_MAX_MS);
+			synthRadiusStart = 0;
+			synthRadiusEnd = TOUCH_SYNTH_SLIDER_RADIUS;
+			synthAngleStart = (int32)TouchSynth_Random(TOUCH_SYNTH_CIRCLE) - (TOUCH_SYNTH_CIRCLE / 2);
+			synthAngleSweep = 0;
+			synthLabel = GESTURE_OUTWARD_SWIPE;
+			break;
+		
+		case TOUCH_SYNTH_FUZZ:
+			synthTouchFrames = TouchSynth_Frames(TOUCH_SYNTH_ARC_MIN_MS, TOUCH_SYNTH_ARC_MAX_MS);
+			synthLabel = TRACE_LABEL_NONE;
+			break;
+		
+		default:
+			/* Circle of 3/4 to 1 turn, counter clockwise is increasing theta */
+			synthTouchFrames = TouchSynth_Frames(TOUCH_SYNTH_ARC_MIN_MS, TOUCH_SYNTH_ARC_MAX_MS);
+			synthRadiusStart = TouchSynth_Random(2) ? TOUCH_SYNTH_BUTTON_RADIUS : TOUCH_SYNTH_SLIDER_RADIUS;
+			synthRadiusEnd = synthRadiusStart;
+			synthAngleStart = (int32)TouchSynth_Random(TOUCH_SYNTH_CIRCLE) - (TOUCH_SYNTH_CIRCLE / 2);
+			synthAngleSweep = (int32)(3 * TOUCH_SYNTH_CIRCLE / 4 + TouchSynth_Random(TOUCH_SYNTH_CIRCLE / 4));
+			
+			if(direction & 1u)
+			{
+				synthAngleSweep = -synthAngleSweep;
+				synthLabel = (synthRadiusStart == TOUCH_SYNTH_BUTTON_RADIUS) ? GESTURE_INNER_CLKWISE : GESTURE_OUTER_CLKWISE;
+			}
+			else
+			{
+				synthLabel = (synthRadiusStart == TOUCH_SYNTH_BUTTON_RADIUS) ? GESTURE_INNER_COUNTER_CLKWISE : GESTURE_OUTER_COUNTER_CLKWISE;
+			}
+			break;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_Random
+********************************************************************************
+* Summary:
+*  Advances the random generator, a 32 bit Galois LFSR, and returns a value in
+*  the range 0 to range - 1.
+*
+* Parameters:
+*  range - number of possible values, not 0
+*
+* Return:
+*  uint32 - random value
+*
+*******************************************************************************/
+static uint32 TouchSynth_Random(uint32 range)
+{
+	synthRandom = (synthRandom >> 1) ^ ((0u - (synthRandom & 1u)) & 0x80200003u);
+	
+	return synthRandom % range;
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_Noise
+********************************************************************************
+* Summary:
+*  Returns a random value in the range -amplitude to amplitude.
+*
+* Parameters:
+*  amplitude - largest magnitude of the value, not negative
+*
+* Return:
+*  int32 - random value
+*
+*******************************************************************************/
+static int32 TouchSynth_Noise(int32 amplitude)
+{
+	return (int32)TouchSynth_Random((uint32)(2 * amplitude + 1)) - amplitude;
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_Frames
+********************************************************************************
+* Summary:
+*  Returns a random number of frames for a duration in the range minMs to 
+*  maxMs, at least 2.
+*
+* Parameters:
+*  minMs - shortest duration in milliseconds
+*  maxMs - longest duration in milliseconds
+*
+* Return:
+*  uint32 - number of frames of TOUCH_SYNTH_FRAME_MS
+*
+*******************************************************************************/
+static uint32 TouchSynth_Frames(uint32 minMs, uint32 maxMs)
+{
+	uint32 frames = (minMs + TouchSynth_Random(maxMs - minMs + 1)) / TOUCH_SYNTH_FRAME_MS;
+	
+	return (frames < 2) ? 2 : frames;
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_Weight
+********************************************************************************
+* Summary:
+*  Triangular sensor response. Returns 1.0 (Q8) at distance 0, falling to 0 at
+*  the distance width.
+*
+* Parameters:
+*  distance - distance of the finger from the centre of the sensor, positive
+*             or negative
+*  width - distance at which the response reaches 0
+*
+* Return:
+*  uint32 - response weight, TOUCH_SYNTH_FRAC_BITS fraction bits
+*
+*******************************************************************************/
+static uint32 TouchSynth_Weight(int32 distance, int32 width)
+{
+	if(distance < 0)
+	{
+		distance = -distance;
+	}
+	
+	return (distance >= width) ? 0 : (uint32)(((width - distance) << TOUCH_SYNTH_FRAC_BITS) / width);
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_AngleDistance
+********************************************************************************
+* Summary:
+*  Returns the difference of two angles, wrapped to half a circle.
+*
+* Parameters:
+*  angle1, angle2 - angles, TOUCH_SYNTH_FRAC_BITS fraction bits
+*
+* Return:
+*  int32 - angle1 - angle2 in the range -TOUCH_SYNTH_CIRCLE / 2 to 
+*          TOUCH_SYNTH_CIRCLE / 2
+*
+*******************************************************************************/
+static int32 TouchSynth_AngleDistance(int32 angle1, int32 angle2)
+{
+	int32 distance = (angle1 - angle2) % TOUCH_SYNTH_CIRCLE;
+	
+	if(distance > (TOUCH_SYNTH_CIRCLE / 2))
+	{
+		distance -= TOUCH_SYNTH_CIRCLE;
+	}
+	else if(distance < -(TOUCH_SYNTH_CIRCLE / 2))
+	{
+		distance += TOUCH_SYNTH_CIRCLE;
+	}
+	
+	return distance;
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_Signal
+********************************************************************************
+* Summary:
+*  Returns the difference count for a sensor response weight, with noise and
+*  limited to the range of the trace format.
+*
+* Parameters:
+*  weight - sensor response, TOUCH_SYNTH_FRAC_BITS fraction bits
+*  widget - CapSense widget of the sensor
+*
+* Return:
+*  uint8 - difference count
+*
+* Theory:
+*  The peak, the signal of a centred finger, is TOUCH_SYNTH_PEAK_MARGIN above 
+*  the level at which the component turns the sensor on, so that it follows
+*  the thresholds of each widget (200 and 100 counts in the configuration).
+*
+*******************************************************************************/
+static uint8 TouchSynth_Signal(uint32 weight, uint32 widget)
+{
+	uint32 peak = (uint32)CapSense_fingerThreshold[widget] + CapSense_hysteresis[widget] + TOUCH_SYNTH_PEAK_MARGIN;
+	int32 signal = (int32)((peak * weight) >> TOUCH_SYNTH_FRAC_BITS) + TouchSynth_Noise(TOUCH_SYNTH_NOISE);
+	
+	if(signal < 0)
+	{
+		signal = 0;
+	}
+	else if(signal > 0xFF)
+	{
+		signal = 0xFF;
+	}
+	
+	return (uint8)signal;
+}
+
+
+/*******************************************************************************
+* Function Name: TouchSynth_SetMaskBit
+********************************************************************************
+* Summary:
+*  Updates a bit of the sensor on mask. The bit is set above finger threshold 
+*  plus hysteresis, and cleared below finger threshold minus hysteresis.
+*
+* Parameters:
+*  mask - bit of the sensor in the mask
+*  signal - difference count of the sensor
+*  widget - CapSense widget of the sensor
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void TouchSynth_SetMaskBit(uint32 mask, uint32 signal, uint32 widget)
+{
+	uint32 threshold = CapSense_fingerThreshold[widget];
+	uint32 hysteresis = CapSense_hysteresis[widget];
+	
+	if(signal >= (threshold + hysteresis))
+	{
+		synthMask |= (uint8)mask;
+	}
+	else if((signal + hysteresis) < threshold)
+	{
+		synthMask &= (uint8)~mask;
+	}
+}
+
+#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_SYNTH) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,152 @@
+/*****************************************************************************
+* File Name		: TouchSynth.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  TouchSynth.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TOUCH_SYNTH_H		/* Guard to prevent multiple inclusions */
+#define TOUCH_SYNTH_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "Gesture.h"
+#include "SensorTrace.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Frame period the trajectories are synthesized for. The trajectory durations
+ * are given in milliseconds, so this sets the number of frames per gesture
+ * seen by the gesture engine. The frames themselves are generated as fast as 
+ * the main loop runs.
+ */
+#define TOUCH_SYNTH_FRAME_MS				(10)
+
+/* Number of touches after which the gesture benchmark results are dumped and 
+ * cleared. 
+ */
+#define TOUCH_SYNTH_RUN_TOUCHES				(1000)
+
+/* Initial state of the random generator, must not be 0. Set to a seed printed
+ * by the benchmark to make the mis-recognized trajectory the first one.
+ */
+#define TOUCH_SYNTH_SEED					(0x2F6E2B1u)
+
+/* Adds touches made of random difference counts and sensor on masks, not 
+ * related to any finger position, to stress the gesture engine and the HID 
+ * conversion with arbitrary frame sequences. These touches are not labeled.
+ */
+#define TOUCH_SYNTH_FUZZ_ENABLE				(DISABLED)
+
+/* Difference count of a sensor with the finger on its centre, above the
+ * finger threshold plus the hysteresis of its widget, and the amplitude of the
+ * uniform noise added to every sensor (+/-). The margin must exceed the noise
+ * for a centred finger to turn the sensor on in every frame.
+ */
+#define TOUCH_SYNTH_PEAK_MARGIN				(40)
+#define TOUCH_SYNTH_NOISE					(8)
+
+#if(TOUCH_SYNTH_PEAK_MARGIN <= TOUCH_SYNTH_NOISE)
+	#error "TOUCH_SYNTH_PEAK_MARGIN must exceed TOUCH_SYNTH_NOISE"
+#endif
+
+/* Positions are polar coordinates with TOUCH_SYNTH_FRAC_BITS fraction bits.
+ * The radius is in the units of Gestures_CalculateRadius() (centre 0, 
+ * buttons 2, slider 4), the angle is in theta counts (1 count = 2 degrees).
+ */
+#define TOUCH_SYNTH_FRAC_BITS				(8)
+#define TOUCH_SYNTH_ONE						(1 << TOUCH_SYNTH_FRAC_BITS)
+#define TOUCH_SYNTH_CIRCLE					(SLIDER_RESOLUTION << TOUCH_SYNTH_FRAC_BITS)
+
+#define TOUCH_SYNTH_BUTTON_RADIUS			(2 * TOUCH_SYNTH_ONE)
+#define TOUCH_SYNTH_SLIDER_RADIUS			(4 * TOUCH_SYNTH_ONE)
+
+/* Sensor response: the signal falls linearly to 0 at the given distance from
+ * the centre of the sensor, radially and along the circle.
+ */
+#define TOUCH_SYNTH_RING_WIDTH				(3 * TOUCH_SYNTH_ONE / 2)
+#define TOUCH_SYNTH_BUTTON_WIDTH			(TOUCH_SYNTH_CIRCLE / 4)
+#define TOUCH_SYNTH_SEGMENT_WIDTH			(3 * TOUCH_SYNTH_CIRCLE / 16)
+
+/* Maximum position error added to every frame of a trajectory (+/-) */
+#define TOUCH_SYNTH_JITTER_RADIUS			(TOUCH_SYNTH_ONE / 4)
+#define TOUCH_SYNTH_JITTER_ANGLE			(2 * TOUCH_SYNTH_ONE)
+
+/* Duration ranges of the trajectories and of the release between them, in 
+ * milliseconds.
+ */
+#define TOUCH_SYNTH_GAP_MIN_MS				(50)
+#define TOUCH_SYNTH_GAP_MAX_MS				(300)
+#define TOUCH_SYNTH_TAP_MIN_MS				(50)
+#define TOUCH_SYNTH_TAP_MAX_MS				(300)
+#define TOUCH_SYNTH_SWIPE_MIN_MS			(150)
+#define TOUCH_SYNTH_SWIPE_MAX_MS			(600)
+#define TOUCH_SYNTH_ARC_MIN_MS				(400)
+#define TOUCH_SYNTH_ARC_MAX_MS				(1500)
+
+/* Trajectory kinds */
+#define TOUCH_SYNTH_TAP_CENTRE				(0)
+#define TOUCH_SYNTH_TAP_BUTTON				(1)
+#define TOUCH_SYNTH_SWIPE					(2)
+#define TOUCH_SYNTH_OUTWARD					(3)
+#define TOUCH_SYNTH_ARC_INNER				(4)
+#define TOUCH_SYNTH_ARC_OUTER				(5)
+#define TOUCH_SYNTH_FUZZ					(6)
+#define TOUCH_SYNTH_KINDS					(6 + TOUCH_SYNTH_FUZZ_ENABLE)
+
+/* Directions of the buttons */
+#define TOUCH_SYNTH_UP						(0)
+#define TOUCH_SYNTH_LEFT					(1)
+#define TOUCH_SYNTH_DOWN					(2)
+#define TOUCH_SYNTH_RIGHT					(3)
+#define TOUCH_SYNTH_DIRECTIONS				(4)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void TouchSynth_Generate(uint8 frame[]);
+uint32 TouchSynth_GetSeed(void);
+
+
+#endif /* #ifndef TOUCH_SYNTH_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,179 @@
+/*******************************************************************************
+* File Name: UsbSof.c
+*
+* Version 1.0
+*
+* Description: This file aligns the HID report generation to the USB start of
+*               frame.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "Platform.h"
+#include "UsbSof.h"
+#include "Timebase.h"
+#include "Telemetry.h"
+#include "Log.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Fields of the standard descriptors, refer to chapter 9.6 of the USB 2.0 
+ * specification
+ */
+#define USB_DESCR_LENGTH				(0u)
+#define USB_DESCR_TYPE					(1u)
+#define USB_EP_DESCR_ADDRESS			(2u)
+#define USB_EP_DESCR_ATTRIBUTES			(3u)
+#define USB_EP_DESCR_INTERVAL			(6u)
+
+#define USB_EP_DIR_IN					(0x80u)
+#define USB_EP_TYPE_MASK				(0x03u)
+#define USB_EP_TYPE_INTERRUPT			(0x03u)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+#if(USB_SOF_SYNC_ENABLE)
+	/* Low byte of the USB frame number and the time of the last report */
+	static uint8 lastFrameNumber;
+	static uint32 lastReportMs;
+#endif /* #if(USB_SOF_SYNC_ENABLE) */
+
+
+/*******************************************************************************
+* Function Name: UsbSof_IsReportDue
+********************************************************************************
+* Summary:
+*  Checks if a new polling interval started since the last report, i.e. if the
+*  next frame should be processed now. Called only when the scan is complete 
+*  and the previous reports are sent, as a due interval is consumed.
+*
+* Parameters:
+*  isConfigured - true once the host configured the device.
+*
+* Return:
+*  bool - true if the frame should be processed.
+*
+* Theory:
+*  The frame number register of the USBFS block is updated with each start of
+*  frame packet. Processing the frame right after the start of frame loads the
+*  endpoints with fresh reports early in the interval, instead of with reports
+*  that were built right after the previous poll and waited for a whole
+*  interval. Polling the register from the main loop keeps the processing out
+*  of the interrupt context. As the next scan is started by the frame, the 
+*  scan has to complete within the interval to report every interval.
+*
+*******************************************************************************/
+bool UsbSof_IsReportDue(bool isConfigured)
+{
+#if(USB_SOF_SYNC_ENABLE)
+	uint8 frameNumber = (uint8)USBFS_SOF0_REG;
+	uint32 nowMs = Timebase_GetMs();
+	
+	if(isConfigured && 
+		((uint8)(frameNumber - lastFrameNumber) < HID_POLL_INTERVAL_MS) &&
+		((nowMs - lastReportMs) < USB_SOF_TIMEOUT_MS))
+	{
+		return false;
+	}
+	
+	lastFrameNumber = frameNumber;
+	lastReportMs = nowMs;
+#else
+	(void)isConfigured;
+#endif /* #if(USB_SOF_SYNC_ENABLE) */
+	
+	return true;
+}
+
+
+/*******************************************************************************
+* Function Name: UsbSof_CheckInterval
+********************************************************************************
+* Summary:
+*  Checks that the host was asked to poll every interrupt IN endpoint of the 
+*  active configuration every HID_POLL_INTERVAL_MS. Called once per 
+*  enumeration.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true if all the intervals match, or if the device is not 
+*  configured.
+*
+* Theory:
+*  The endpoint descriptors are walked in the configuration descriptor 
+*  generated by the USBFS customizer. A mismatch is logged with the endpoint
+*  address and its bInterval, rather than asserted, as the device still works
+*  with reports that wait for the longer interval.
+*
+*******************************************************************************/
+bool UsbSof_CheckInterval(void)
+{
+	uint8 configuration = USBFS_GetConfiguration();
+	const uint8 *descr;
+	uint32 totalLength;
+	uint32 pos;
+	bool isMatch = true;
+	
+	if(configuration == 0)
+	{
+		return true;
+	}
+	
+	descr = (const uint8 *)USBFS_GetConfigTablePtr(configuration - 1u)->p_list;
+	totalLength = ((uint32)descr[USBFS_CONFIG_DESCR_TOTAL_LENGTH_HI] << 8) | descr[USBFS_CONFIG_DESCR_TOTAL_LENGTH_LOW];
+	
+	for(pos = 0; (pos < totalLength) && (descr[pos + USB_DESCR_LENGTH] != 0); pos += descr[pos + USB_DESCR_LENGTH])
+	{
+		if((descr[pos + USB_DESCR_TYPE] == USBFS_DESCR_ENDPOINT) &&
+			((descr[pos + USB_EP_DESCR_ADDRESS] & USB_EP_DIR_IN) != 0) &&
+			((descr[pos + USB_EP_DESCR_ATTRIBUTES] & USB_EP_TYPE_MASK) == USB_EP_TYPE_INTERRUPT) &&
+			(descr[pos + USB_EP_DESCR_INTERVAL] != HID_POLL_INTERVAL_MS))
+		{
+			LOG_USB_ERROR(TELEMETRY_EVENT_POLL_INTERVAL, 
+				descr[pos + USB_EP_DESCR_ADDRESS] | ((uint16)descr[pos + USB_EP_DESCR_INTERVAL] << 8));
+			isMatch = false;
+		}
+	}
+	
+	return isMatch;
+}
+
+
+/* [] END OF FILE */
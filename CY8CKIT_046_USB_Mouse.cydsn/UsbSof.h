@@ -0,0 +1,88 @@
+/*****************************************************************************
+* File Name		: UsbSof.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the function prototypes and constants used in
+*  UsbSof.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef USB_SOF_H		/* Guard to prevent multiple inclusions */
+#define USB_SOF_H
+
+#include "cytypes.h"
+#include "main.h"
+#include "stdbool.h"
+
+
+/*******************************************************************************
+* 	Macro Definitions
+********************************************************************************/
+
+/* Enables the alignment of the HID reports to the USB start of frame. When 
+ * disabled, a frame is processed as soon as the scan completes and the 
+ * previous reports are sent.
+ */
+#define USB_SOF_SYNC_ENABLE				(ENABLED)
+
+/* Polling interval of the keyboard and mouse endpoints in ms. This must match
+ * the bInterval of both endpoint descriptors, which is set in the USBFS 
+ * component customizer and checked at enumeration, refer to 
+ * UsbSof_CheckInterval(). A full speed device is polled every 1 ms at most, 
+ * the 125 us microframe interval is only available to high speed devices.
+ */
+#define HID_POLL_INTERVAL_MS			(1u)
+
+/* Frames run without waiting for the start of frame when none was seen for 
+ * this time, e.g. while the host suspends the device.
+ */
+#define USB_SOF_TIMEOUT_MS				(3u)
+
+#if(HID_POLL_INTERVAL_MS < 1u)
+	#error "HID_POLL_INTERVAL_MS must be at least 1, the USBFS block is full speed"
+#endif /* #if(HID_POLL_INTERVAL_MS < 1u) */
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+bool UsbSof_IsReportDue(bool isConfigured);
+bool UsbSof_CheckInterval(void);
+
+
+#endif /* #ifndef USB_SOF_H */
+
+
+/* [] END OF FILE */
@@ -49,22 +49,39 @@
 #include "main.h"
 #include "Gesture.h"
 #include "HidReport.h"
+#include "HidSched.h"
 #include "LedControl.h"
+#include "LedAnim.h"
+#include "LedDriver.h"
+#include "LedStatus.h"
+#include "AdaptiveThreshold.h"
+#include "FrequencyHop.h"
+#include "SensorFilter.h"
+#include "SensorTrace.h"
+#include "GestureStats.h"
+#include "ReportDigest.h"
+#include "UsbSof.h"
+#include "Timebase.h"
+#include "Profile.h"
+#include "Latency.h"
+#include "Telemetry.h"
+#include "Log.h"
 #include "stdbool.h"
 
 /*******************************************************************************
-* 	External Variable Declarations
+* 	Local Macro Definitions
 *******************************************************************************/
 
-/* Keyboard and Mouse HID report arrays, declared in HidReport.c */
-extern uint8 keyboardReport[];
-extern int8 mouseReport[];
+/* Debug commands are read from the UART, unless it carries a replayed trace */
+#define DEBUG_CMD_ENABLE		(ENABLE_UART_DBG_OUTPUT && (SENSOR_TRACE_MODE != SENSOR_TRACE_REPLAY))
+
 
 /*******************************************************************************
 * 	Local Function Declarations
 *******************************************************************************/
 
 static void InitSystem(void);
+static void ProcessDebugCommand(void);
 
 
 /*******************************************************************************
@@ -86,7 +103,6 @@ int main()
 {
 	tGestureId gestureId;
 	uint32 isAnySensorActive, usbDeviceConfiguration = 0;
-	uint32 usbDataSentFlag = USB_HID_DATA_SENT;
 	bool usbDriverInstallationComplete = false;
 	
     CyGlobalIntEnable; /* Enable global interrupts. */
@@ -104,6 +120,10 @@ int main()
 	
 	for(;;)
 	{		
+		ProcessDebugCommand();
+		Latency_Poll();
+		LedStatus_Poll();
+		
 		/* Check if VBUS is detected on the USB, if not then reset the USB flags */
 		if(USBFS_VBusPresent() == true)
 		{
@@ -114,56 +134,96 @@ int main()
 		{
 			if(usbDeviceConfiguration == true)
 			{
-				PRINT("USB Disconnected \n\r");
+				LOG_USB_INFO(TELEMETRY_EVENT_USB_DISCONNECTED, 0);
 				
 				/* Turn the LED OFF, when USB is disconnected */
-				SetLedColor(COLOR_OFF, BRIGHT_LEVEL_9);
+				SetLedColor(COLOR_OFF, BRIGHT_LEVEL_MAX);
 			}
 			
 			/* Clear/reset the USB related flags */
 			usbDeviceConfiguration = false;
 			USBFS_configuration = false;
-			usbDataSentFlag = USB_HID_DATA_SENT;
+			HidSched_Reset();
 		}
 			
-		/* Wait until CapSense scan completes */
-		if((CapSense_IsBusy() == 0) && (usbDataSentFlag == USB_HID_DATA_SENT))
+		/* Wait until CapSense scan completes and the next polling interval starts */
+		if((CapSense_IsBusy() == 0) && HidSched_IsIdle() && SensorTrace_IsFrameReady() &&
+			UsbSof_IsReportDue(usbDeviceConfiguration != 0))
 		{
+			Latency_FrameStart();
+			LedStatus_FrameStart();
+			PROFILE_BEGIN(PROFILE_FRAME);
+			
+			/* Combine the sense clock channels when frequency hopping is enabled */
+			PROFILE_BEGIN(PROFILE_BASELINE);
+			FrequencyHop_ProcessScan();
+			
 			/* Update baseline and check if any sensor is active */
 		    CapSense_UpdateEnabledBaselines();	
+			PROFILE_END(PROFILE_BASELINE);
+			
+			PROFILE_BEGIN(PROFILE_SENSOR_FILTER);
+			SensorFilter_Process();
+			PROFILE_END(PROFILE_SENSOR_FILTER);
+			
+			PROFILE_BEGIN(PROFILE_THRESHOLD);
+			AdaptiveThreshold_Apply();
 			isAnySensorActive = CapSense_CheckIsAnyWidgetActive();	
 			
+			#if(SENSOR_TRACE_INJECT)
+				/* Replace the scan results with the next frame of the trace */
+				isAnySensorActive = SensorTrace_Replay();
+			#endif /* #if(SENSOR_TRACE_INJECT) */
+			
+			/* Track the idle noise and adapt the thresholds to it */
+			AdaptiveThreshold_Update(isAnySensorActive);
+			PROFILE_END(PROFILE_THRESHOLD);
+			
 			/* Initiate next scan of all the sensors */
+			FrequencyHop_NextChannel();
 			CapSense_ScanEnabledWidgets();
+			Latency_ScanStart();
 			
 			/* Decode gesture and process the gesture */
+			PROFILE_BEGIN(PROFILE_GESTURE);
 			gestureId = DetectGesture(isAnySensorActive); 
+			PROFILE_END(PROFILE_GESTURE);
+			SensorTrace_Record();
+			GestureStats_Update(gestureId);
+			PROFILE_BEGIN(PROFILE_LED);
 			UpdateLedColor(gestureId);	
+			PROFILE_END(PROFILE_LED);
             
 			/* Convert the gestures to HID report */
+			PROFILE_BEGIN(PROFILE_HID);
 			ConvertGestureToHidReport(gestureId);			
+			PROFILE_END(PROFILE_HID);
+			ReportDigest_Update();
+			PROFILE_END(PROFILE_FRAME);
+			LedStatus_FrameEnd();
+			Latency_Decision(isAnySensorActive);
 			
 			/* Process USB endpoint load tasks, if USB is connected */
 			if(usbDeviceConfiguration != 0)
 			{
-				if((USBFS_GetEPAckState(KEYBOARD_END_POINT) || USBFS_GetEPAckState(MOUSE_END_POINT)) && (usbDriverInstallationComplete == false))
+				if(HidSched_IsAcked() && (usbDriverInstallationComplete == false))
 				{
 					usbDriverInstallationComplete = true;					
 					
 					/* Turn the LED with BLUE after USB device drivers (first ack on the USB end points) are installed */
-					SetLedColor(COLOR_BLUE, BRIGHT_LEVEL_9);
-					PRINT("HID Drivers Installed \n\r");
+					SetLedColor(COLOR_BLUE, BRIGHT_LEVEL_MAX);
+					LOG_USB_INFO(TELEMETRY_EVENT_DRIVERS_INSTALLED, 0);
+					(void)UsbSof_CheckInterval();
 					
 				}
 				else if(usbDriverInstallationComplete == false)
 				{
 					/* Load initial data into the endpoints when device first enumerates */
-					USBFS_LoadInEP(KEYBOARD_END_POINT, (uint8 *)keyboardReport, KEY_RPT_SIZE);
-					USBFS_LoadInEP(MOUSE_END_POINT, (uint8 *)mouseReport, MOUSE_RPT_SIZE);
+					HidSched_LoadInitial();
 				}
 				else if(usbDriverInstallationComplete == true)
 				{
-					usbDataSentFlag = USB_HID_DATA_SENT_FLAG_CLEAR;
+					HidSched_Queue();
 				}			
 			}
 			else
@@ -173,21 +233,9 @@ int main()
 		}					
 			
 		/* Process USB HID report only when the drivers are installed and device acks on desired endpoints */
-		if((usbDriverInstallationComplete == true) && (usbDataSentFlag != USB_HID_DATA_SENT))
-		{					
-			/* Send Keyboard data to PC, if there is an USB keyboard endpoint event pending */
-			if(USBFS_GetEPState(KEYBOARD_END_POINT) == USBFS_EVENT_PENDING)
-			{
-				USBFS_LoadInEP(KEYBOARD_END_POINT, (uint8 *)keyboardReport, KEY_RPT_SIZE);
-				usbDataSentFlag |= KEYBOARD_DATA_SENT;
-			}
-			
-			/* Send Mouse data to PC, if there is an USB mouse endpoint event pending */
-			if(USBFS_GetEPState(MOUSE_END_POINT) == USBFS_EVENT_PENDING)
-			{
-				USBFS_LoadInEP(MOUSE_END_POINT, (uint8 *)mouseReport, MOUSE_RPT_SIZE);
-				usbDataSentFlag |= MOUSE_DATA_SENT;
-			}
+		if(usbDriverInstallationComplete == true)
+		{
+			HidSched_Service();
 		}
 	}
 				
@@ -212,12 +260,20 @@ void InitSystem(void)
 {	
 	#if(ENABLE_UART_DBG_OUTPUT)
 		UART_Start();
-		PRINT("Application Starts...\n\r");
+		Telemetry_Init();
+		Telemetry_Event(TELEMETRY_EVENT_APP_START, 0);
+	#elif(SENSOR_TRACE_MODE != SENSOR_TRACE_OFF)
+		UART_Start();
 	#endif /* #if(ENABLE_UART_DBG_OUTPUT) */
 	
+	/* Start the millisecond time base */
+	Timebase_Init();
+	
 	PWM_Red_Start();
 	PWM_Green_Start();
 	PWM_Blue_Start();
+	LedDriver_Init();
+	LedAnim_Init();
 	
 	/* Turn off the LED after USB is initialized */
 	SetLedColor(INIT_LED_COLOR, INIT_BRIGHT_LEVEL);
@@ -234,14 +290,115 @@ void InitSystem(void)
 	/* Initialize CapSense */
 	CapSense_Start();
 	CapSense_InitializeAllBaselines();
+	AdaptiveThreshold_Init();
+	FrequencyHop_Init();
+	SensorFilter_Init();
 
 	/* Initialize USB */
 	USBFS_Start(0, USBFS_5V_OPERATION);		
 	
 	/* Initiate the first scan of all the sensors */
 	CapSense_ScanEnabledWidgets();	
+	Latency_ScanStart();
 }
 
 
-/* [] END OF FILE */
+/*******************************************************************************
+* Function Name: ProcessDebugCommand
+********************************************************************************
+*
+* Summary:
+* Executes the single character debug commands received over UART, refer to 
+* main.h for the commands.
+*
+* Parameters:
+* None
+*
+* Return:
+* None
+*
+*******************************************************************************/
+static void ProcessDebugCommand(void)
+{
+	#if(DEBUG_CMD_ENABLE)
+		uint32 command;
+		
+		if(UART_SpiUartGetRxBufferSize() != 0)
+		{
+			command = UART_SpiUartReadRxData();
+			
+			/* The dumps write to the UART directly */
+			Telemetry_Flush();
+			
+			switch(command)
+			{
+				case DEBUG_CMD_PROFILE_DUMP:
+					Profile_Dump();
+				break;
+				
+				case DEBUG_CMD_PROFILE_CLEAR:
+					Profile_Clear();
+				break;
+				
+				case DEBUG_CMD_STATS_DUMP:
+					GestureStats_Dump();
+				break;
+				
+				case DEBUG_CMD_LATENCY_DUMP:
+					Latency_Dump();
+				break;
+				
+				case DEBUG_CMD_LATENCY_CLEAR:
+					Latency_Clear();
+				break;
+				
+				case DEBUG_CMD_LED_DUMP:
+					LedDriver_Dump();
+				break;
+				
+				default:
+					/* Digits toggle the trace of the modules, refer to Log.h */
+					if((command >= DEBUG_CMD_LOG_TOGGLE) && (command < (DEBUG_CMD_LOG_TOGGLE + LOG_MODULES)))
+					{
+						Log_ToggleModule(command - DEBUG_CMD_LOG_TOGGLE);
+					}
+				break;
+			}
+		}
+	#endif /* #if(DEBUG_CMD_ENABLE) */
+}
 
+
+/*******************************************************************************
+* Function Name: PrintField
+********************************************************************************
+*
+* Summary:
+* Prints a comma followed by the decimal value over UART. Used by the comma
+* separated debug dumps, which do not depend on TXDEBUG.
+*
+* Parameters:
+* value - value to print
+*
+* Return:
+* None
+*
+*******************************************************************************/
+void PrintField(uint32 value)
+{
+	char8 text[12];
+	uint32 index = sizeof(text) - 1;
+	
+	text[index] = '\0';
+	do
+	{
+		text[--index] = (char8)('0' + (value % 10));
+		value /= 10;
+	} while(value != 0);
+	text[--index] = ',';
+	
+	UART_UartPutString(&text[index]);
+}
+
+
+/* [] END OF FILE */
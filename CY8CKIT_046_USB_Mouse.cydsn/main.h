@@ -52,7 +52,8 @@
     #define DISABLED                    (0)    
     #define TUNER_ENABLE                (DISABLED) 
 
-    /* Enables or disables sending debug data over UART.     
+    /* Enables or disables the debug channel over UART. The events sent over 
+     * it are selected per module and level in Log.h.
      */
     #define TXDEBUG
     
@@ -61,12 +62,17 @@
     #else
         #define ENABLE_UART_DBG_OUTPUT			(0)
     #endif
-    	
-    #if(ENABLE_UART_DBG_OUTPUT)
-    	#define PRINT	UART_UartPutString
-    #else
-    	#define PRINT(x)	
-    #endif		
+
+    /* Debug commands, single characters received over UART when TXDEBUG is 
+     * defined.
+     */
+    #define DEBUG_CMD_PROFILE_DUMP			('p')
+    #define DEBUG_CMD_PROFILE_CLEAR			('P')
+    #define DEBUG_CMD_STATS_DUMP			('g')
+    #define DEBUG_CMD_LATENCY_DUMP			('l')
+    #define DEBUG_CMD_LATENCY_CLEAR			('L')
+    #define DEBUG_CMD_LED_DUMP				('w')
+    #define DEBUG_CMD_LOG_TOGGLE			('0')	/* '0' + LOG_MODULE_x */
 
     /* Defines the IN end point number for the keyboard interface. */
     #define KEYBOARD_END_POINT				(1)
@@ -81,9 +87,50 @@
     /* Defines the number of bytes used to report mouse data over USB. */
     #define MOUSE_RPT_SIZE					(4)
 
+    /* Enables the consumer control report, which carries the media keys. The
+     * USBFS customizer must then describe a consumer control interface with
+     * CONSUMER_END_POINT, or the report ID HID_REPORT_ID_CONSUMER on the 
+     * single interface. The host build enables it per target.
+     */
+    #ifndef CONSUMER_REPORT_ENABLE
+        #define CONSUMER_REPORT_ENABLE		(DISABLED)
+    #endif /* #ifndef CONSUMER_REPORT_ENABLE */
+
+    /* Defines the IN end point number for the consumer control interface. */
+    #define CONSUMER_END_POINT				(3)
+
+    /* Defines the number of bytes used to report consumer control data over 
+     * USB, one 16 bit usage.
+     */
+    #define CONSUMER_RPT_SIZE				(2)
+
+    /* Enables the single interface mode. The keyboard, mouse and consumer 
+     * control reports share one IN end point of one HID interface and start 
+     * with their report ID. The USBFS customizer must then describe a single
+     * interface, with HID_END_POINT and a report descriptor with the report
+     * IDs below. The host build enables it per target.
+     */
+    #ifndef HID_SINGLE_INTERFACE_ENABLE
+        #define HID_SINGLE_INTERFACE_ENABLE	(DISABLED)
+    #endif /* #ifndef HID_SINGLE_INTERFACE_ENABLE */
+
+    /* Defines the IN end point number of the single interface. */
+    #define HID_END_POINT					(1)
+
+    /* Report IDs and size of the report ID prefix on the single interface */
+    #define HID_REPORT_ID_KEYBOARD			(1)
+    #define HID_REPORT_ID_MOUSE				(2)
+    #define HID_REPORT_ID_CONSUMER			(3)
+    #define HID_REPORT_ID_SIZE				(1)
+
     #define MOUSE_DATA_SENT					(1)
     #define KEYBOARD_DATA_SENT				(2)
-    #define USB_HID_DATA_SENT				(MOUSE_DATA_SENT | KEYBOARD_DATA_SENT)
+    #define CONSUMER_DATA_SENT				(4)
+    #if(CONSUMER_REPORT_ENABLE)
+        #define USB_HID_DATA_SENT			(MOUSE_DATA_SENT | KEYBOARD_DATA_SENT | CONSUMER_DATA_SENT)
+    #else
+        #define USB_HID_DATA_SENT			(MOUSE_DATA_SENT | KEYBOARD_DATA_SENT)
+    #endif /* #if(CONSUMER_REPORT_ENABLE) */
     #define USB_HID_DATA_SENT_FLAG_CLEAR	(0)
 
 
@@ -92,6 +139,7 @@
     *******************************************************************************/
 
     void Print(const char8 string[]);
+    void PrintField(uint32 value);
 
 #endif /* #ifndef MAIN_H */
 
@@ -0,0 +1,402 @@
+/*******************************************************************************
+* File Name: ThresholdBench.c
+*
+* Version 1.0
+*
+* Description: Replay benchmark of the CapSense thresholds: false triggers and missed
+*               touches of the adaptive and the static thresholds on a clean and a noisy
+*               recording.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostMock.h"
+#include "main.h"
+#include "AdaptiveThreshold.h"
+#include "stdlib.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Idle frames at the start of a recording, long enough for the noise estimate
+ * of the adaptive thresholds to become valid.
+ */
+#define BENCH_LEAD_IN_FRAMES				(500u)
+
+/* Touches of a recording, each on the next button, and the frames of a touch
+ * and of the idle gap after it.
+ */
+#define BENCH_TOUCHES						(200u)
+#define BENCH_TOUCH_FRAMES					(30u)
+#define BENCH_GAP_FRAMES					(100u)
+#define BENCH_FRAMES						(BENCH_LEAD_IN_FRAMES + (BENCH_TOUCHES * (BENCH_TOUCH_FRAMES + BENCH_GAP_FRAMES)))
+
+/* Signal of a finger on a button, 80% of which is the component finger 
+ * threshold.
+ */
+#define BENCH_TOUCH_SIGNAL					(250)
+
+/* Buttons are the first sensors of the component */
+#define BENCH_BUTTONS						(CapSense_CENTRE__BTN + 1u)
+
+/* Seed of the noise generator, the recordings are the same on every run */
+#define BENCH_SEED							(0x2545F491u)
+
+
+/*******************************************************************************
+*	Data Type Definitions
+********************************************************************************/
+
+/* Noise of a recording: white noise on all the sensors, and bursts of a few 
+ * frames on a random button, such as those coupled in by a charger. 
+ * isRiseExpected is set when the noise is well above the noise threshold, and
+ * the adaptive finger threshold must rise above the configuration.
+ */
+typedef struct
+{
+	const char8 *name;
+	uint32 noiseSigma;
+	uint32 burstsPer1000Frames;
+	int32 burstSignal;
+	uint32 burstFrames;
+	bool isRiseExpected;
+} tBenchRecording;
+
+/* Result of a replay, with the finger threshold of the buttons at the end */
+typedef struct
+{
+	uint32 missedTouches;
+	uint32 falseTriggers;
+	uint32 fingerThreshold;
+} tBenchResult;
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* The hub recording has little white noise but frequent bursts above the noise
+ * threshold and well below a finger, which the finger threshold must clear.
+ */
+static const tBenchRecording benchRecordings[] =
+{
+	{"clean",	2u,		0u,		0,		0u,		false},
+	{"noisy",	10u,	5u,		230,	3u,		false},
+	{"hub",		3u,		100u,	45,		1u,		true},
+};
+
+/* Raw counts of the recording being replayed */
+static uint16 benchRaw[BENCH_FRAMES][CapSense_TOTAL_SENSOR_COUNT];
+
+/* Touched button of each frame, BENCH_BUTTONS when no button is touched */
+static uint8 benchTouch[BENCH_FRAMES];
+
+static uint32 benchRandom;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static uint32 Bench_Random(void);
+static int32 Bench_Gaussian(uint32 sigma);
+static void Bench_Record(const tBenchRecording *recording);
+static tBenchResult Bench_Replay(bool isAdaptive);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Replays each recording with the static and with the adaptive thresholds and
+*  prints the missed touches, the false triggers and the final finger 
+*  threshold of the buttons.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_FAILURE if the adaptive thresholds do worse than the static 
+*        thresholds on a recording, or do not rise on a recording that
+*        expects it
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 i;
+	tBenchResult staticResult, adaptiveResult;
+	int result = EXIT_SUCCESS;
+	
+	benchRandom = BENCH_SEED;
+	
+	printf("%-10s%-12s%10s%10s%16s%11s\n", "recording", "thresholds", "touches", "missed", "false triggers", "finger th");
+	
+	for(i = 0; i < (sizeof(benchRecordings) / sizeof(benchRecordings[0])); i++)
+	{
+		Bench_Record(&benchRecordings[i]);
+		
+		staticResult = Bench_Replay(false);
+		adaptiveResult = Bench_Replay(true);
+		
+		printf("%-10s%-12s%10u%10u%16u%11u\n", benchRecordings[i].name, "static", 
+			BENCH_TOUCHES, (unsigned)staticResult.missedTouches, (unsigned)staticResult.falseTriggers,
+			(unsigned)staticResult.fingerThreshold);
+		printf("%-10s%-12s%10u%10u%16u%11u\n", benchRecordings[i].name, "adaptive", 
+			BENCH_TOUCHES, (unsigned)adaptiveResult.missedTouches, (unsigned)adaptiveResult.falseTriggers,
+			(unsigned)adaptiveResult.fingerThreshold);
+		
+		if((adaptiveResult.missedTouches + adaptiveResult.falseTriggers) > 
+			(staticResult.missedTouches + staticResult.falseTriggers))
+		{
+			result = EXIT_FAILURE;
+		}
+		
+		if(benchRecordings[i].isRiseExpected && (adaptiveResult.fingerThreshold <= staticResult.fingerThreshold))
+		{
+			result = EXIT_FAILURE;
+		}
+	}
+	
+	return result;
+}
+
+
+/*******************************************************************************
+* Function Name: Bench_Random
+********************************************************************************
+* Summary:
+*  Returns the next value of a xorshift generator, the same on every host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - pseudo random value
+*
+*******************************************************************************/
+static uint32 Bench_Random(void)
+{
+	benchRandom ^= benchRandom << 13;
+	benchRandom ^= benchRandom >> 17;
+	benchRandom ^= benchRandom << 5;
+	
+	return benchRandom;
+}
+
+
+/*******************************************************************************
+* Function Name: Bench_Gaussian
+********************************************************************************
+* Summary:
+*  Returns a normally distributed value of zero mean.
+*
+* Parameters:
+*  sigma - standard deviation
+*
+* Return:
+*  int32 - random value
+*
+* Theory:
+*  The sum of twelve uniform values of 12 bits has a mean of 12 * 2048 and a
+*  standard deviation of 4096, and is close to a normal distribution.
+*
+*******************************************************************************/
+static int32 Bench_Gaussian(uint32 sigma)
+{
+	uint32 i;
+	int32 sum = 0;
+	
+	for(i = 0; i < 12u; i++)
+	{
+		sum += (int32)(Bench_Random() & 0x0FFFu);
+	}
+	
+	return ((sum - (12 * 2048)) * (int32)sigma) / 4096;
+}
+
+
+/*******************************************************************************
+* Function Name: Bench_Record
+********************************************************************************
+* Summary:
+*  Generates the raw counts of a recording: BENCH_LEAD_IN_FRAMES idle frames,
+*  then BENCH_TOUCHES touches going round the buttons, with the noise of the
+*  recording on top.
+*
+* Parameters:
+*  recording - noise of the recording
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Bench_Record(const tBenchRecording *recording)
+{
+	uint32 frame, sensor, touch, burstSensor = 0, burstLeft = 0;
+	int32 raw;
+	
+	for(frame = 0; frame < BENCH_FRAMES; frame++)
+	{
+		benchTouch[frame] = BENCH_BUTTONS;
+		if(frame >= BENCH_LEAD_IN_FRAMES)
+		{
+			touch = (frame - BENCH_LEAD_IN_FRAMES) / (BENCH_TOUCH_FRAMES + BENCH_GAP_FRAMES);
+			if(((frame - BENCH_LEAD_IN_FRAMES) % (BENCH_TOUCH_FRAMES + BENCH_GAP_FRAMES)) < BENCH_TOUCH_FRAMES)
+			{
+				benchTouch[frame] = (uint8)(touch % BENCH_BUTTONS);
+			}
+		}
+		
+		if((burstLeft == 0) && ((Bench_Random() % 1000u) < recording->burstsPer1000Frames))
+		{
+			burstSensor = Bench_Random() % BENCH_BUTTONS;
+			burstLeft = recording->burstFrames;
+		}
+		
+		for(sensor = 0; sensor < CapSense_TOTAL_SENSOR_COUNT; sensor++)
+		{
+			raw = (int32)MOCK_CAPSENSE_IDLE_RAW + Bench_Gaussian(recording->noiseSigma);
+			
+			if((benchTouch[frame] != BENCH_BUTTONS) && (sensor == benchTouch[frame]))
+			{
+				raw += BENCH_TOUCH_SIGNAL;
+			}
+			if((burstLeft != 0) && (sensor == burstSensor))
+			{
+				raw += recording->burstSignal;
+			}
+			
+			benchRaw[frame][sensor] = (uint16)raw;
+		}
+		
+		if(burstLeft != 0)
+		{
+			burstLeft--;
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: Bench_Replay
+********************************************************************************
+* Summary:
+*  Replays the recording through the CapSense processing of the main loop and 
+*  counts the missed touches and the false triggers of the buttons.
+*
+* Parameters:
+*  isAdaptive - true to adapt the thresholds, false to keep the thresholds of 
+*               the component configuration
+*
+* Return:
+*  tBenchResult - missed touches and false triggers
+*
+* Theory:
+*  A touch is missed when the touched button does not turn on during the 
+*  touch. A false trigger is a button turning on while it is not touched.
+*
+*******************************************************************************/
+static tBenchResult Bench_Replay(bool isAdaptive)
+{
+	uint32 frame, sensor, isAnySensorActive;
+	uint8 isOn, wasOn = 0;
+	bool isDetected = false;
+	tBenchResult result = {0u, 0u, 0u};
+	
+	/* The component configuration thresholds and idle baselines */
+	MockCapSense_Reset();
+	AdaptiveThreshold_Init();
+	
+	for(frame = 0; frame < BENCH_FRAMES; frame++)
+	{
+		for(sensor = 0; sensor < CapSense_TOTAL_SENSOR_COUNT; sensor++)
+		{
+			MockCapSense_scanRaw[sensor] = benchRaw[frame][sensor];
+		}
+		
+		CapSense_ScanEnabledWidgets();
+		CapSense_UpdateEnabledBaselines();
+		if(isAdaptive)
+		{
+			AdaptiveThreshold_Apply();
+		}
+		isAnySensorActive = CapSense_CheckIsAnyWidgetActive();
+		if(isAdaptive)
+		{
+			AdaptiveThreshold_Update(isAnySensorActive);
+		}
+		
+		isOn = CapSense_sensorOnMask[0] & ((1u << BENCH_BUTTONS) - 1u);
+		for(sensor = 0; sensor < BENCH_BUTTONS; sensor++)
+		{
+			if((isOn & ~wasOn & (1u << sensor)) != 0)
+			{
+				if(sensor == benchTouch[frame])
+				{
+					isDetected = true;
+				}
+				else
+				{
+					result.falseTriggers++;
+				}
+			}
+		}
+		
+		/* A touch held on from the previous frame of the same touch */
+		if((benchTouch[frame] != BENCH_BUTTONS) && ((isOn & (1u << benchTouch[frame])) != 0))
+		{
+			isDetected = true;
+		}
+		
+		/* Last frame of a touch */
+		if((benchTouch[frame] != BENCH_BUTTONS) && 
+			(((frame + 1u) == BENCH_FRAMES) || (benchTouch[frame + 1u] != benchTouch[frame])))
+		{
+			if(!isDetected)
+			{
+				result.missedTouches++;
+			}
+			isDetected = false;
+		}
+		
+		wasOn = isOn;
+	}
+	
+	result.fingerThreshold = CapSense_fingerThreshold[CapSense_LEFT__BTN];
+	
+	return result;
+}
+
+
+/* [] END OF FILE */
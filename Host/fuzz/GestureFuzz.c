@@ -0,0 +1,307 @@
+/*******************************************************************************
+* File Name: GestureFuzz.c
+*
+* Version 1.0
+*
+* Description: Fuzz harness of the gesture engine: arbitrary sensor frames are replayed
+*               through the firmware built with SENSOR_TRACE_REPLAY on the mock hardware. Provides
+*               LLVMFuzzerTestOneInput() for libFuzzer, and a standalone driver for compilers
+*               without it.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "SensorTrace.h"
+#include "stdlib.h"
+#include "string.h"
+#include "stdint.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Fuzz input format, one record per frame: the difference count of every 
+ * sensor, the sensor on mask and the label. The rest of the trace frame is
+ * filled in by the harness, so that every input reaches the gesture engine.
+ */
+#define FUZZ_MASK_POS						(CapSense_TOTAL_SENSOR_COUNT)
+#define FUZZ_LABEL_POS						(FUZZ_MASK_POS + 1)
+#define FUZZ_FRAME_SIZE						(FUZZ_LABEL_POS + 1)
+
+/* Standalone driver: frames of a random input, default number of frames of a
+ * run and the seed of the xorshift generator.
+ */
+#define FUZZ_INPUT_FRAMES					(256u)
+#define FUZZ_DEFAULT_FRAMES					(100000u)
+#define FUZZ_SEED							(0x5EED1234u)
+
+
+/*******************************************************************************
+*	Function Prototypes
+********************************************************************************/
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#ifndef FUZZ_LIBFUZZER
+	static uint32 Fuzz_Random(void);
+	static bool Fuzz_RunFile(const char8 path[]);
+#endif /* #ifndef FUZZ_LIBFUZZER */
+
+
+/*******************************************************************************
+*	Local Variables
+********************************************************************************/
+
+#ifndef FUZZ_LIBFUZZER
+	static uint32 fuzzRandom = FUZZ_SEED;
+#endif /* #ifndef FUZZ_LIBFUZZER */
+
+
+/*******************************************************************************
+* Function Name: LLVMFuzzerTestOneInput
+********************************************************************************
+* Summary:
+*  libFuzzer entry point. Replays one input, a sequence of fuzz records, from
+*  a reset of the firmware.
+*
+* Parameters:
+*  data - input
+*  size - size of the input in bytes, an incomplete last record is ignored
+*
+* Return:
+*  int - 0, the input is always accepted
+*
+* Theory:
+*  Every record becomes a trace frame with a valid sync, timestamp and 
+*  checksum and the centroid left to the engine. The main loop processes it 
+*  like a frame replayed over UART: DetectGesture(), ConvertGestureToHidReport(),
+*  the LED, the benchmark and the report digest. A failed CYASSERT aborts, 
+*  the sanitizers report the rest.
+*
+*******************************************************************************/
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	uint8 frame[TRACE_FRAME_SIZE];
+	uint32 i, record, sent;
+	uint8 sum;
+	
+	HostLoop_Init();
+	
+	for(record = 0; ((record + 1u) * FUZZ_FRAME_SIZE) <= size; record++)
+	{
+		const uint8_t *fuzz = &data[record * FUZZ_FRAME_SIZE];
+		
+		frame[0] = TRACE_SYNC_0;
+		frame[1] = TRACE_SYNC_1;
+		frame[TRACE_TIMESTAMP_POS] = (uint8)record;
+		frame[TRACE_TIMESTAMP_POS + 1] = (uint8)(record >> 8);
+		(void)memcpy(&frame[TRACE_SIGNAL_POS], fuzz, CapSense_TOTAL_SENSOR_COUNT);
+		frame[TRACE_CENTROID_POS] = 0xFFu;
+		frame[TRACE_CENTROID_POS + 1] = 0xFFu;
+		frame[TRACE_MASK_POS] = fuzz[FUZZ_MASK_POS];
+		frame[TRACE_LABEL_POS] = fuzz[FUZZ_LABEL_POS];
+		
+		sum = 0;
+		for(i = TRACE_TIMESTAMP_POS; i < TRACE_CHECKSUM_POS; i++)
+		{
+			sum += frame[i];
+		}
+		frame[TRACE_CHECKSUM_POS] = sum;
+		
+		sent = 0;
+		while(sent < TRACE_FRAME_SIZE)
+		{
+			sent += MockUart_Receive(&frame[sent], TRACE_FRAME_SIZE - sent);
+			(void)HostLoop_Frame();
+			MockUart_ClearOutput();
+		}
+	}
+	
+	return 0;
+}
+
+
+#ifndef FUZZ_LIBFUZZER
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Standalone driver, for compilers without libFuzzer. Replays the given input
+*  files, e.g. a libFuzzer corpus or crash, or random inputs.
+*
+*  Usage: GestureFuzz [--frames N] [file ...]
+*   --frames - number of random frames, FUZZ_DEFAULT_FRAMES without files
+*
+* Parameters:
+*  argc, argv - command line
+*
+* Return:
+*  int - EXIT_SUCCESS if all the inputs were replayed
+*
+* Theory:
+*  Random inputs of FUZZ_INPUT_FRAMES frames are drawn from a fixed seed, so
+*  that a failure repeats. Each input has its own signal range and share of 
+*  frames without touch, so that the engine sees touches of every strength,
+*  including ones near the thresholds, and the releases between them.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+	static uint8 input[FUZZ_INPUT_FRAMES * FUZZ_FRAME_SIZE];
+	uint32 frames = 0, done, i, range, quiet;
+	int arg = 1;
+	bool hasFiles = false;
+	char *end;
+	
+	if((argc > 2) && (strcmp(argv[1], "--frames") == 0))
+	{
+		frames = (uint32)strtoul(argv[2], &end, 0);
+		if((*end != '\0') || (frames == 0))
+		{
+			fprintf(stderr, "usage: %s [--frames N] [file ...]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+		arg = 3;
+	}
+	
+	for(; arg < argc; arg++)
+	{
+		hasFiles = true;
+		if(!Fuzz_RunFile(argv[arg]))
+		{
+			fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[arg]);
+			return EXIT_FAILURE;
+		}
+	}
+	
+	if((frames == 0) && !hasFiles)
+	{
+		frames = FUZZ_DEFAULT_FRAMES;
+	}
+	
+	for(done = 0; done < frames; done += FUZZ_INPUT_FRAMES)
+	{
+		range = (Fuzz_Random() & 1u) ? 0x100u : 0x40u;
+		quiet = Fuzz_Random() % 4u;
+		
+		for(i = 0; i < (FUZZ_INPUT_FRAMES * FUZZ_FRAME_SIZE); i++)
+		{
+			input[i] = (uint8)(Fuzz_Random() % range);
+			
+			/* Frames without touch */
+			if(((i / FUZZ_FRAME_SIZE) % 4u) < quiet)
+			{
+				input[i] = ((i % FUZZ_FRAME_SIZE) == FUZZ_LABEL_POS) ? input[i] : 0u;
+			}
+		}
+		
+		(void)LLVMFuzzerTestOneInput(input, sizeof(input));
+	}
+	
+	printf("frames %u, files %d\n", (unsigned)frames, hasFiles);
+	
+	return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: Fuzz_Random
+********************************************************************************
+* Summary:
+*  Returns the next value of a xorshift generator, the same on every host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - random value
+*
+*******************************************************************************/
+static uint32 Fuzz_Random(void)
+{
+	fuzzRandom ^= fuzzRandom << 13;
+	fuzzRandom ^= fuzzRandom >> 17;
+	fuzzRandom ^= fuzzRandom << 5;
+	
+	return fuzzRandom;
+}
+
+
+/*******************************************************************************
+* Function Name: Fuzz_RunFile
+********************************************************************************
+* Summary:
+*  Replays one input file.
+*
+* Parameters:
+*  path - file name
+*
+* Return:
+*  bool - false if the file cannot be read
+*
+*******************************************************************************/
+static bool Fuzz_RunFile(const char8 path[])
+{
+	FILE *file = fopen(path, "rb");
+	uint8 *data;
+	long length;
+	bool isRead = false;
+	
+	if(file == NULL)
+	{
+		return false;
+	}
+	
+	if((fseek(file, 0, SEEK_END) == 0) && ((length = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+	{
+		data = malloc((size_t)length + 1u);
+		if((data != NULL) && (fread(data, 1u, (size_t)length, file) == (size_t)length))
+		{
+			(void)LLVMFuzzerTestOneInput(data, (size_t)length);
+			isRead = true;
+		}
+		free(data);
+	}
+	
+	(void)fclose(file);
+	
+	return isRead;
+}
+
+#endif /* #ifndef FUZZ_LIBFUZZER */
+
+
+/* [] END OF FILE */
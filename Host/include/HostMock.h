@@ -0,0 +1,137 @@
+/*****************************************************************************
+* File Name		: HostMock.h
+* Version		: 1.0 
+*
+* Description:
+*  Controls the mock hardware layer of the host build: the sensor raw
+*  counts, the USB host, the UART and the SysTick timer.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_MOCK_H		/* Guard to prevent multiple inclusions */
+#define HOST_MOCK_H
+
+#include "cytypes.h"
+#include "PlatformHost.h"
+#include "stdbool.h"
+#include "stdio.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Raw count of an untouched sensor and sense clock divider of the component
+ * configuration. The raw count of a scan scales with the sense clock divider.
+ */
+#define MOCK_CAPSENSE_IDLE_RAW				(1000u)
+#define MOCK_CAPSENSE_DIVIDER				(4u)
+
+/* Weight of the raw count in the baseline, as a right shift, and the 
+ * fractional bits of the baseline.
+ */
+#define MOCK_CAPSENSE_BASELINE_SHIFT		(4)
+#define MOCK_CAPSENSE_BASELINE_FRAC_BITS	(8)
+
+/* SysTick period of 1 ms */
+#define MOCK_SYSTICK_RELOAD					((CYDEV_BCLK__SYSCLK__HZ / 1000u) - 1u)
+#define MOCK_SYSTICK_PENDSTSET				(0x04000000u)
+
+/* Endpoints of the mock USB device */
+#define MOCK_USBFS_ENDPOINTS				(9u)
+#define MOCK_USBFS_EP_SIZE					(64u)
+
+/* Polling interval of the interrupt IN endpoints in the descriptors of the 
+ * mock device after the reset, in ms
+ */
+#define MOCK_USBFS_INTERVAL					(1u)
+
+/* Size of the UART receive FIFO of the mock, large enough to queue a few 
+ * trace frames 
+ */
+#define MOCK_UART_RX_SIZE					(256u)
+
+/* Channels of the mock PWM */
+#define MOCK_PWM_RED						(0u)
+#define MOCK_PWM_GREEN						(1u)
+#define MOCK_PWM_BLUE						(2u)
+#define MOCK_PWM_CHANNELS					(3u)
+
+
+/*******************************************************************************
+*   External Variable Declarations
+*******************************************************************************/
+
+/* Raw counts measured by the next scan at MOCK_CAPSENSE_DIVIDER */
+extern uint16 MockCapSense_scanRaw[CapSense_TOTAL_SENSOR_COUNT];
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void Mock_Reset(void);
+
+void MockCapSense_Reset(void);
+void MockCapSense_SetSignal(uint32 sensor, uint32 signal);
+uint32 MockCapSense_GetScans(void);
+
+void MockSysTick_Reset(void);
+void MockSysTick_Advance(uint32 cycles);
+void MockSysTick_AdvanceMs(uint32 ms);
+void MockSysTick_SetInterruptsEnabled(bool isEnabled);
+
+void MockUsbfs_Reset(void);
+void MockUsbfs_SetAttached(bool attached);
+void MockUsbfs_SetPollPeriod(uint32 frames);
+void MockUsbfs_SetInterval(uint8 interval);
+void MockUsbfs_SetSofStall(bool stalled);
+void MockUsbfs_Frame(void);
+uint32 MockUsbfs_GetInCount(uint32 epNumber);
+const uint8 *MockUsbfs_GetInData(uint32 epNumber, uint32 *length);
+
+void MockUart_Reset(void);
+uint32 MockUart_Receive(const uint8 data[], uint32 count);
+uint32 MockUart_GetRxFree(void);
+const char8 *MockUart_GetOutput(uint32 *length);
+void MockUart_ClearOutput(void);
+void MockUart_SetEcho(FILE *stream);
+
+void MockPwm_Reset(void);
+uint32 MockPwm_GetCompare(uint32 channel);
+
+
+#endif /* #ifndef HOST_MOCK_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,218 @@
+/*****************************************************************************
+* File Name		: PlatformHost.h
+* Version		: 1.0 
+*
+* Description:
+*  Declares the subset of the PSoC Creator generated APIs used by the
+*  application modules, for the host build. Included by Platform.h when
+*  PLATFORM_HOST is defined; the functions are implemented by the mock
+*  hardware layer in Host/mock, which is controlled through HostMock.h.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PLATFORM_HOST_H		/* Guard to prevent multiple inclusions */
+#define PLATFORM_HOST_H
+
+#include "cytypes.h"
+
+
+/*******************************************************************************
+*	cy_boot (CyLib.h, cydevice_trm.h)
+*******************************************************************************/
+
+#define CYDEV_BCLK__SYSCLK__HZ				(48000000u)
+
+/* Assertions are always checked on the host */
+#define CYASSERT(x)							do { if(!(x)) { CyHalt_Assert(__FILE__, __LINE__); } } while(0)
+
+#define CY_SYS_SYST_NUM_OF_CALLBACKS		(5u)
+
+/* Interrupt control and state register of the Cortex-M0 */
+#define CYREG_CM0_ICSR						(&MockSysTick_icsr)
+
+typedef void (*cySysTickCallback)(void);
+
+extern reg32 MockSysTick_icsr;
+
+void CyHalt_Assert(const char8 file[], uint32 line);
+uint8 CyEnterCriticalSection(void);
+void CyExitCriticalSection(uint8 savedIntrStatus);
+
+void CySysTickStart(void);
+void CySysTickSetReload(uint32 value);
+uint32 CySysTickGetReload(void);
+uint32 CySysTickGetValue(void);
+uint32 CySysTickGetCountFlag(void);
+void CySysTickClear(void);
+cySysTickCallback CySysTickSetCallback(uint32 number, cySysTickCallback function);
+
+
+/*******************************************************************************
+*	CapSense_CSD
+*******************************************************************************/
+
+#define CapSense_TOTAL_SENSOR_COUNT			(13u)
+#define CapSense_TOTAL_WIDGET_COUNT			(6u)
+
+/* Widgets */
+#define CapSense_LEFT__BTN					(0u)
+#define CapSense_RIGHT__BTN					(1u)
+#define CapSense_UP__BTN					(2u)
+#define CapSense_DOWN__BTN					(3u)
+#define CapSense_CENTRE__BTN				(4u)
+#define CapSense_RADIALSLIDER0__RS			(5u)
+
+/* First sensor of each widget */
+#define CapSense_SENSOR_LEFT__BTN			(0u)
+#define CapSense_SENSOR_RIGHT__BTN			(1u)
+#define CapSense_SENSOR_UP__BTN				(2u)
+#define CapSense_SENSOR_DOWN__BTN			(3u)
+#define CapSense_SENSOR_CENTRE__BTN			(4u)
+#define CapSense_SENSOR_RADIALSLIDER0_E0__RS	(5u)
+
+extern uint8 CapSense_sensorOnMask[(((CapSense_TOTAL_SENSOR_COUNT - 1u) / 8u) + 1u)];
+extern uint16 CapSense_sensorRaw[CapSense_TOTAL_SENSOR_COUNT];
+extern uint16 CapSense_sensorBaseline[CapSense_TOTAL_SENSOR_COUNT];
+extern uint8 CapSense_sensorSignal[CapSense_TOTAL_SENSOR_COUNT];
+extern uint8 CapSense_fingerThreshold[CapSense_TOTAL_WIDGET_COUNT];
+extern uint8 CapSense_noiseThreshold[CapSense_TOTAL_WIDGET_COUNT];
+extern uint8 CapSense_hysteresis[CapSense_TOTAL_WIDGET_COUNT];
+
+void CapSense_Start(void);
+void CapSense_ScanEnabledWidgets(void);
+uint32 CapSense_IsBusy(void);
+void CapSense_InitializeAllBaselines(void);
+void CapSense_UpdateEnabledBaselines(void);
+uint32 CapSense_CheckIsAnyWidgetActive(void);
+uint16 CapSense_GetDiffCountData(uint32 sensor);
+uint16 CapSense_GetRadialCentroidPos(uint32 widget);
+void CapSense_TunerStart(void);
+void CapSense_TunerComm(void);
+uint8 CapSense_SenseClk_GetDividerRegister(void);
+void CapSense_SenseClk_SetDividerValue(uint16 clkDivider);
+
+
+/*******************************************************************************
+*	USBFS
+*******************************************************************************/
+
+#define USBFS_3V_OPERATION					(0x00u)
+#define USBFS_5V_OPERATION					(0x01u)
+
+#define USBFS_NO_EVENT_PENDING				(0u)
+#define USBFS_EVENT_PENDING					(1u)
+#define USBFS_IN_BUFFER_FULL				(USBFS_NO_EVENT_PENDING)
+#define USBFS_IN_BUFFER_EMPTY				(USBFS_EVENT_PENDING)
+
+/* Frame number register, incremented by the mock host */
+#define USBFS_SOF0_REG						(MockUsbfs_sof0)
+
+extern reg32 MockUsbfs_sof0;
+extern volatile uint8 USBFS_configuration;
+
+void USBFS_Start(uint8 device, uint8 mode);
+uint8 USBFS_VBusPresent(void);
+uint8 USBFS_GetConfiguration(void);
+uint8 USBFS_CheckActivity(void);
+uint8 USBFS_GetEPState(uint8 epNumber);
+uint8 USBFS_GetEPAckState(uint8 epNumber);
+void USBFS_LoadInEP(uint8 epNumber, const uint8 pData[], uint16 length);
+
+/* Descriptor tables. Entry 0 of the table of a configuration points to its
+ * configuration descriptor, followed by its interface and endpoint 
+ * descriptors.
+ */
+#define USBFS_DESCR_CONFIG					(2u)
+#define USBFS_DESCR_ENDPOINT				(5u)
+#define USBFS_CONFIG_DESCR_TOTAL_LENGTH_LOW	(2u)
+#define USBFS_CONFIG_DESCR_TOTAL_LENGTH_HI	(3u)
+
+typedef struct
+{
+	uint8 c;
+	const void *p_list;
+}T_USBFS_LUT;
+
+const T_USBFS_LUT *USBFS_GetConfigTablePtr(uint8 confIndex);
+
+
+/*******************************************************************************
+*	SCB UART
+*******************************************************************************/
+
+#define UART_INTR_TX_NOT_FULL				((uint32) 0x02u)
+#define UART_SPI_UART_FIFO_SIZE				(8u)
+
+void UART_Start(void);
+void UART_UartPutString(const char8 string[]);
+void UART_UartPutChar(uint32 txDataByte);
+void UART_SpiUartWriteTxData(uint32 txData);
+void UART_SpiUartPutArray(const uint8 wrBuf[], uint32 count);
+uint32 UART_SpiUartGetTxBufferSize(void);
+uint32 UART_SpiUartReadRxData(void);
+uint32 UART_SpiUartGetRxBufferSize(void);
+void UART_SetTxInterruptMode(uint32 interruptMask);
+void UART_ClearTxInterruptSource(uint32 interruptMask);
+void UART_SetCustomInterruptHandler(cyisraddress func);
+
+
+/*******************************************************************************
+*	TCPWM PWM_Red, PWM_Green, PWM_Blue
+*******************************************************************************/
+
+#define PWM_Red_MASK						(0x01u)
+#define PWM_Green_MASK						(0x02u)
+#define PWM_Blue_MASK						(0x04u)
+
+#define PWM_Red_CMD_CAPTURE					(0u)
+
+void PWM_Red_Start(void);
+void PWM_Red_WriteCompare(uint32 compare);
+void PWM_Red_WriteCompareBuf(uint32 compareBuf);
+void PWM_Red_SetCompareSwap(uint32 swapEnable);
+void PWM_Red_TriggerCommand(uint32 mask, uint32 command);
+
+void PWM_Green_Start(void);
+void PWM_Green_WriteCompare(uint32 compare);
+void PWM_Green_WriteCompareBuf(uint32 compareBuf);
+void PWM_Green_SetCompareSwap(uint32 swapEnable);
+
+void PWM_Blue_Start(void);
+void PWM_Blue_WriteCompare(uint32 compare);
+void PWM_Blue_WriteCompareBuf(uint32 compareBuf);
+void PWM_Blue_SetCompareSwap(uint32 swapEnable);
+
+#endif /* #ifndef PLATFORM_HOST_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/*****************************************************************************
+* File Name		: cytypes.h
+* Version		: 1.0 
+*
+* Description:
+*  Host build replacement of the PSoC Creator cytypes.h. Provides the basic
+*  types and macros of the generated code on a desktop compiler.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_BOOT_CYTYPES_H		/* Guard to prevent multiple inclusions */
+#define CY_BOOT_CYTYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/*******************************************************************************
+*	Types
+*******************************************************************************/
+
+typedef uint8_t		uint8;
+typedef uint16_t	uint16;
+typedef uint32_t	uint32;
+typedef uint64_t	uint64;
+typedef int8_t		int8;
+typedef int16_t		int16;
+typedef int32_t		int32;
+typedef int64_t		int64;
+typedef char		char8;
+typedef float		float32;
+
+typedef volatile uint8	reg8;
+typedef volatile uint16	reg16;
+typedef volatile uint32	reg32;
+
+typedef void (*cyisraddress)(void);
+
+
+/*******************************************************************************
+*	Macro Definitions
+*******************************************************************************/
+
+/* Interrupt service routines are ordinary functions on the host */
+#define CY_ISR(FuncName)					void FuncName (void)
+#define CY_ISR_PROTO(FuncName)				void FuncName (void)
+
+#define LO8(x)								((uint8) ((x) & 0xFFu))
+#define HI8(x)								((uint8) ((uint16)(x) >> 8))
+#define LO16(x)								((uint16) ((x) & 0xFFFFu))
+#define HI16(x)								((uint16) ((uint32)(x) >> 16))
+
+/* Registers are plain variables of the mock hardware layer, the addresses
+ * are pointers to them.
+ */
+#define CY_GET_REG8(addr)					(*((reg8 *)(addr)))
+#define CY_SET_REG8(addr, value)			(*((reg8 *)(addr)) = (uint8)(value))
+#define CY_GET_REG32(addr)					(*((reg32 *)(addr)))
+#define CY_SET_REG32(addr, value)			(*((reg32 *)(addr)) = (uint32)(value))
+
+#endif /* #ifndef CY_BOOT_CYTYPES_H */
+
+
+/* [] END OF FILE */
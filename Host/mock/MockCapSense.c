@@ -0,0 +1,454 @@
+/*******************************************************************************
+* File Name: MockCapSense.c
+*
+* Version 1.0
+*
+* Description: Mock of the CapSense_CSD component for the host build. A scan
+*               returns the raw counts set by the test, the baseline, signal and
+*               sensor on mask are processed as the component does.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "PlatformHost.h"
+#include "HostMock.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Maximum of an 8 bit signal */
+#define MOCK_CAPSENSE_SIGNAL_MAX			(0xFFu)
+
+/* Sensor on mask byte and bit of a sensor */
+#define MOCK_CAPSENSE_MASK_BYTE(sensor)		((sensor) >> 3)
+#define MOCK_CAPSENSE_MASK_BIT(sensor)		((uint8)(1u << ((sensor) & 7u)))
+
+
+/*******************************************************************************
+*	Component Variables
+********************************************************************************/
+
+uint8 CapSense_sensorOnMask[(((CapSense_TOTAL_SENSOR_COUNT - 1u) / 8u) + 1u)];
+uint16 CapSense_sensorRaw[CapSense_TOTAL_SENSOR_COUNT];
+uint16 CapSense_sensorBaseline[CapSense_TOTAL_SENSOR_COUNT];
+uint8 CapSense_sensorSignal[CapSense_TOTAL_SENSOR_COUNT];
+uint8 CapSense_fingerThreshold[CapSense_TOTAL_WIDGET_COUNT];
+uint8 CapSense_noiseThreshold[CapSense_TOTAL_WIDGET_COUNT];
+uint8 CapSense_hysteresis[CapSense_TOTAL_WIDGET_COUNT];
+
+uint16 MockCapSense_scanRaw[CapSense_TOTAL_SENSOR_COUNT];
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Thresholds and debounce of the component configuration, per widget */
+static const uint8 configFingerThreshold[CapSense_TOTAL_WIDGET_COUNT] = {200, 200, 200, 200, 100, 100};
+static const uint8 configNoiseThreshold[CapSense_TOTAL_WIDGET_COUNT] = {20, 20, 20, 20, 20, 20};
+static const uint8 configHysteresis[CapSense_TOTAL_WIDGET_COUNT] = {10, 10, 10, 10, 10, 0};
+static const uint8 configDebounce[CapSense_TOTAL_WIDGET_COUNT] = {2, 2, 2, 2, 1, 1};
+
+/* Widget of each sensor */
+static const uint8 widgetOfSensor[CapSense_TOTAL_SENSOR_COUNT] =
+{
+	CapSense_LEFT__BTN, CapSense_RIGHT__BTN, CapSense_UP__BTN, CapSense_DOWN__BTN, CapSense_CENTRE__BTN,
+	CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS,
+	CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS, CapSense_RADIALSLIDER0__RS
+};
+
+/* Baseline with MOCK_CAPSENSE_BASELINE_FRAC_BITS fractional bits */
+static uint32 baselineFine[CapSense_TOTAL_SENSOR_COUNT];
+
+/* Scans above the on threshold, for the debounce */
+static uint8 debounceCount[CapSense_TOTAL_SENSOR_COUNT];
+
+static uint32 senseClkDivider;
+static uint32 scanCount;
+
+
+/*******************************************************************************
+* Function Name: MockCapSense_Reset
+********************************************************************************
+* Summary:
+*  Restores the thresholds of the component configuration, sets all the 
+*  sensors to the untouched raw count and clears the processing state.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockCapSense_Reset(void)
+{
+	uint32 i;
+	
+	for(i = 0; i < CapSense_TOTAL_WIDGET_COUNT; i++)
+	{
+		CapSense_fingerThreshold[i] = configFingerThreshold[i];
+		CapSense_noiseThreshold[i] = configNoiseThreshold[i];
+		CapSense_hysteresis[i] = configHysteresis[i];
+	}
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		MockCapSense_scanRaw[i] = MOCK_CAPSENSE_IDLE_RAW;
+		CapSense_sensorRaw[i] = MOCK_CAPSENSE_IDLE_RAW;
+		CapSense_sensorBaseline[i] = MOCK_CAPSENSE_IDLE_RAW;
+		CapSense_sensorSignal[i] = 0;
+		baselineFine[i] = MOCK_CAPSENSE_IDLE_RAW << MOCK_CAPSENSE_BASELINE_FRAC_BITS;
+		debounceCount[i] = 0;
+	}
+	
+	for(i = 0; i < sizeof(CapSense_sensorOnMask); i++)
+	{
+		CapSense_sensorOnMask[i] = 0;
+	}
+	
+	senseClkDivider = MOCK_CAPSENSE_DIVIDER;
+	scanCount = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: MockCapSense_SetSignal
+********************************************************************************
+* Summary:
+*  Sets the raw count of the next scan of a sensor to the untouched raw count 
+*  plus a signal.
+*
+* Parameters:
+*  sensor - sensor index
+*  signal - difference count added by the finger
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockCapSense_SetSignal(uint32 sensor, uint32 signal)
+{
+	MockCapSense_scanRaw[sensor] = (uint16)(MOCK_CAPSENSE_IDLE_RAW + signal);
+}
+
+
+/*******************************************************************************
+* Function Name: MockCapSense_GetScans
+********************************************************************************
+* Summary:
+*  Returns the number of scans started since the reset.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - number of scans
+*
+*******************************************************************************/
+uint32 MockCapSense_GetScans(void)
+{
+	return scanCount;
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_Start
+********************************************************************************
+* Summary:
+*  Mock of the component API, see MockCapSense_Reset().
+*
+*******************************************************************************/
+void CapSense_Start(void)
+{
+	MockCapSense_Reset();
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_ScanEnabledWidgets
+********************************************************************************
+* Summary:
+*  Mock of the component API. The scan completes immediately with the raw 
+*  counts of MockCapSense_scanRaw, scaled with the sense clock divider.
+*
+*******************************************************************************/
+void CapSense_ScanEnabledWidgets(void)
+{
+	uint32 i, raw;
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		raw = ((uint32)MockCapSense_scanRaw[i] * senseClkDivider) / MOCK_CAPSENSE_DIVIDER;
+		CapSense_sensorRaw[i] = (uint16)((raw > 0xFFFFu) ? 0xFFFFu : raw);
+	}
+	
+	scanCount++;
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_IsBusy
+********************************************************************************
+* Summary:
+*  Mock of the component API, the scans complete immediately.
+*
+*******************************************************************************/
+uint32 CapSense_IsBusy(void)
+{
+	return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_InitializeAllBaselines
+********************************************************************************
+* Summary:
+*  Mock of the component API. Scans the sensors and sets the baselines to the
+*  raw counts.
+*
+*******************************************************************************/
+void CapSense_InitializeAllBaselines(void)
+{
+	uint32 i;
+	
+	CapSense_ScanEnabledWidgets();
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		CapSense_sensorBaseline[i] = CapSense_sensorRaw[i];
+		baselineFine[i] = (uint32)CapSense_sensorRaw[i] << MOCK_CAPSENSE_BASELINE_FRAC_BITS;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_UpdateEnabledBaselines
+********************************************************************************
+* Summary:
+*  Mock of the component API. Updates the baselines and the signals from the
+*  raw counts of the last scan.
+*
+* Theory:
+*  As in the component, the baseline only follows the raw count while the 
+*  difference stays within the noise threshold, and the signal is the 
+*  difference above the noise threshold, limited to 8 bits. A raw count below
+*  the baseline pulls the baseline down.
+*
+*******************************************************************************/
+void CapSense_UpdateEnabledBaselines(void)
+{
+	uint32 i, raw;
+	int32 diff;
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		raw = (uint32)CapSense_sensorRaw[i] << MOCK_CAPSENSE_BASELINE_FRAC_BITS;
+		diff = (int32)CapSense_sensorRaw[i] - (int32)CapSense_sensorBaseline[i];
+		
+		if(diff <= (int32)CapSense_noiseThreshold[widgetOfSensor[i]])
+		{
+			if(raw > baselineFine[i])
+			{
+				baselineFine[i] += (raw - baselineFine[i]) >> MOCK_CAPSENSE_BASELINE_SHIFT;
+			}
+			else
+			{
+				baselineFine[i] -= (baselineFine[i] - raw) >> MOCK_CAPSENSE_BASELINE_SHIFT;
+			}
+		}
+		
+		if(diff > (int32)CapSense_noiseThreshold[widgetOfSensor[i]])
+		{
+			CapSense_sensorSignal[i] = (uint8)((diff > (int32)MOCK_CAPSENSE_SIGNAL_MAX) ? MOCK_CAPSENSE_SIGNAL_MAX : (uint32)diff);
+		}
+		else
+		{
+			CapSense_sensorSignal[i] = 0;
+		}
+		
+		CapSense_sensorBaseline[i] = (uint16)(baselineFine[i] >> MOCK_CAPSENSE_BASELINE_FRAC_BITS);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_CheckIsAnyWidgetActive
+********************************************************************************
+* Summary:
+*  Mock of the component API. Updates the sensor on mask from the signals.
+*
+* Return:
+*  uint32 - 1 if any sensor is on, 0 otherwise
+*
+* Theory:
+*  A sensor turns on once its signal has been at or above the finger threshold
+*  plus the hysteresis for the debounce number of scans, and turns off below
+*  the finger threshold minus the hysteresis.
+*
+*******************************************************************************/
+uint32 CapSense_CheckIsAnyWidgetActive(void)
+{
+	uint32 i, widget, signal, isActive = 0;
+	
+	for(i = 0; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		widget = widgetOfSensor[i];
+		signal = CapSense_sensorSignal[i];
+		
+		if(signal >= ((uint32)CapSense_fingerThreshold[widget] + CapSense_hysteresis[widget]))
+		{
+			if(debounceCount[i] < configDebounce[widget])
+			{
+				debounceCount[i]++;
+			}
+			if(debounceCount[i] >= configDebounce[widget])
+			{
+				CapSense_sensorOnMask[MOCK_CAPSENSE_MASK_BYTE(i)] |= MOCK_CAPSENSE_MASK_BIT(i);
+			}
+		}
+		else
+		{
+			debounceCount[i] = 0;
+			
+			if((signal + CapSense_hysteresis[widget]) < CapSense_fingerThreshold[widget])
+			{
+				CapSense_sensorOnMask[MOCK_CAPSENSE_MASK_BYTE(i)] &= (uint8)~MOCK_CAPSENSE_MASK_BIT(i);
+			}
+		}
+		
+		if((CapSense_sensorOnMask[MOCK_CAPSENSE_MASK_BYTE(i)] & MOCK_CAPSENSE_MASK_BIT(i)) != 0)
+		{
+			isActive = 1;
+		}
+	}
+	
+	return isActive;
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_GetDiffCountData
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+uint16 CapSense_GetDiffCountData(uint32 sensor)
+{
+	return CapSense_sensorSignal[sensor];
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_GetRadialCentroidPos
+********************************************************************************
+* Summary:
+*  Mock of the component API. Returns the centre of the strongest segment, 
+*  without interpolation.
+*
+*******************************************************************************/
+uint16 CapSense_GetRadialCentroidPos(uint32 widget)
+{
+	uint32 i, maxSensor = CapSense_SENSOR_RADIALSLIDER0_E0__RS;
+	uint32 segments = CapSense_TOTAL_SENSOR_COUNT - CapSense_SENSOR_RADIALSLIDER0_E0__RS;
+	
+	for(i = CapSense_SENSOR_RADIALSLIDER0_E0__RS; i < CapSense_TOTAL_SENSOR_COUNT; i++)
+	{
+		if(CapSense_sensorSignal[i] > CapSense_sensorSignal[maxSensor])
+		{
+			maxSensor = i;
+		}
+	}
+	
+	if(CapSense_sensorSignal[maxSensor] < CapSense_fingerThreshold[widget])
+	{
+		return 0xFFFFu;
+	}
+	
+	return (uint16)(((maxSensor - CapSense_SENSOR_RADIALSLIDER0_E0__RS) * 180u) / segments);
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_TunerStart
+********************************************************************************
+* Summary:
+*  Mock of the component API, there is no tuner on the host.
+*
+*******************************************************************************/
+void CapSense_TunerStart(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_TunerComm
+********************************************************************************
+* Summary:
+*  Mock of the component API, there is no tuner on the host.
+*
+*******************************************************************************/
+void CapSense_TunerComm(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_SenseClk_GetDividerRegister
+********************************************************************************
+* Summary:
+*  Mock of the clock API. Returns the divider minus one, as the register holds.
+*
+*******************************************************************************/
+uint8 CapSense_SenseClk_GetDividerRegister(void)
+{
+	return (uint8)(senseClkDivider - 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: CapSense_SenseClk_SetDividerValue
+********************************************************************************
+* Summary:
+*  Mock of the clock API. Takes effect with the next scan.
+*
+*******************************************************************************/
+void CapSense_SenseClk_SetDividerValue(uint16 clkDivider)
+{
+	senseClkDivider = clkDivider;
+}
+
+
+/* [] END OF FILE */
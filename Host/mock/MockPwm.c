@@ -0,0 +1,289 @@
+/*******************************************************************************
+* File Name: MockPwm.c
+*
+* Version 1.0
+*
+* Description: Mock of the TCPWM PWM_Red, PWM_Green and PWM_Blue components for the
+*               host build. Records the compare values driving the LED.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "PlatformHost.h"
+#include "HostMock.h"
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Compare and compare buffer value of each channel, and whether a capture
+ * command swaps them.
+ */
+static uint32 compare[MOCK_PWM_CHANNELS];
+static uint32 compareBuf[MOCK_PWM_CHANNELS];
+static bool isSwapEnabled[MOCK_PWM_CHANNELS];
+
+/* Counter mask of each channel */
+static const uint32 counterMask[MOCK_PWM_CHANNELS] = 
+{
+	PWM_Red_MASK, PWM_Green_MASK, PWM_Blue_MASK
+};
+
+
+/*******************************************************************************
+* Function Name: MockPwm_Reset
+********************************************************************************
+* Summary:
+*  Clears the compare values.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockPwm_Reset(void)
+{
+	uint32 i;
+	
+	for(i = 0; i < MOCK_PWM_CHANNELS; i++)
+	{
+		compare[i] = 0;
+		compareBuf[i] = 0;
+		isSwapEnabled[i] = false;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockPwm_GetCompare
+********************************************************************************
+* Summary:
+*  Returns the compare value in use by a channel.
+*
+* Parameters:
+*  channel - MOCK_PWM_RED, MOCK_PWM_GREEN or MOCK_PWM_BLUE
+*
+* Return:
+*  uint32 - compare value
+*
+*******************************************************************************/
+uint32 MockPwm_GetCompare(uint32 channel)
+{
+	return compare[channel];
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Red_Start
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Red_Start(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Red_WriteCompare
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Red_WriteCompare(uint32 value)
+{
+	compare[MOCK_PWM_RED] = value;
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Red_WriteCompareBuf
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Red_WriteCompareBuf(uint32 value)
+{
+	compareBuf[MOCK_PWM_RED] = value;
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Red_SetCompareSwap
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Red_SetCompareSwap(uint32 swapEnable)
+{
+	isSwapEnabled[MOCK_PWM_RED] = (swapEnable != 0);
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Red_TriggerCommand
+********************************************************************************
+* Summary:
+*  Mock of the component API. A capture command swaps the compare and the 
+*  compare buffer of the selected channels that have the swap enabled, as the
+*  terminal count would.
+*
+*******************************************************************************/
+void PWM_Red_TriggerCommand(uint32 mask, uint32 command)
+{
+	uint32 i, value;
+	
+	if(command == PWM_Red_CMD_CAPTURE)
+	{
+		for(i = 0; i < MOCK_PWM_CHANNELS; i++)
+		{
+			if(((mask & counterMask[i]) != 0) && isSwapEnabled[i])
+			{
+				value = compare[i];
+				compare[i] = compareBuf[i];
+				compareBuf[i] = value;
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Green_Start
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Green_Start(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Green_WriteCompare
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Green_WriteCompare(uint32 value)
+{
+	compare[MOCK_PWM_GREEN] = value;
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Green_WriteCompareBuf
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Green_WriteCompareBuf(uint32 value)
+{
+	compareBuf[MOCK_PWM_GREEN] = value;
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Green_SetCompareSwap
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Green_SetCompareSwap(uint32 swapEnable)
+{
+	isSwapEnabled[MOCK_PWM_GREEN] = (swapEnable != 0);
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Blue_Start
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Blue_Start(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Blue_WriteCompare
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Blue_WriteCompare(uint32 value)
+{
+	compare[MOCK_PWM_BLUE] = value;
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Blue_WriteCompareBuf
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Blue_WriteCompareBuf(uint32 value)
+{
+	compareBuf[MOCK_PWM_BLUE] = value;
+}
+
+
+/*******************************************************************************
+* Function Name: PWM_Blue_SetCompareSwap
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void PWM_Blue_SetCompareSwap(uint32 swapEnable)
+{
+	isSwapEnabled[MOCK_PWM_BLUE] = (swapEnable != 0);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,358 @@
+/*******************************************************************************
+* File Name: MockSysTick.c
+*
+* Version 1.0
+*
+* Description: Mock of the SysTick timer, the interrupt state and the assertion
+*               handler of cy_boot for the host build. Time only advances when the test
+*               calls MockSysTick_Advance().
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "PlatformHost.h"
+#include "HostMock.h"
+#include "stdlib.h"
+
+
+/*******************************************************************************
+*	Register Variables
+********************************************************************************/
+
+/* Interrupt control and state register, only the SysTick pending bit */
+reg32 MockSysTick_icsr;
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+static uint32 reload;
+static uint32 value;
+static bool isCountFlag;
+static bool isInterruptEnabled;
+static cySysTickCallback callbacks[CY_SYS_SYST_NUM_OF_CALLBACKS];
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void MockSysTick_Service(void);
+
+
+/*******************************************************************************
+* Function Name: MockSysTick_Reset
+********************************************************************************
+* Summary:
+*  Stops the timer, clears the callbacks and enables the interrupts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockSysTick_Reset(void)
+{
+	uint32 i;
+	
+	reload = MOCK_SYSTICK_RELOAD;
+	value = MOCK_SYSTICK_RELOAD;
+	isCountFlag = false;
+	isInterruptEnabled = true;
+	MockSysTick_icsr = 0;
+	
+	for(i = 0; i < CY_SYS_SYST_NUM_OF_CALLBACKS; i++)
+	{
+		callbacks[i] = NULL;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockSysTick_Advance
+********************************************************************************
+* Summary:
+*  Lets the system clock run for a number of cycles. The SysTick interrupt is
+*  serviced at every reload, unless the interrupts are disabled.
+*
+* Parameters:
+*  cycles - number of system clock cycles
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockSysTick_Advance(uint32 cycles)
+{
+	while(cycles != 0)
+	{
+		if(cycles <= value)
+		{
+			value -= cycles;
+			cycles = 0;
+		}
+		else
+		{
+			/* Count down to 0 and reload on the next cycle */
+			cycles -= value + 1u;
+			value = reload;
+			isCountFlag = true;
+			MockSysTick_icsr |= MOCK_SYSTICK_PENDSTSET;
+			MockSysTick_Service();
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockSysTick_AdvanceMs
+********************************************************************************
+* Summary:
+*  Lets the system clock run for a number of SysTick periods.
+*
+* Parameters:
+*  ms - number of milliseconds
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockSysTick_AdvanceMs(uint32 ms)
+{
+	while(ms != 0)
+	{
+		MockSysTick_Advance(reload + 1u);
+		ms--;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockSysTick_SetInterruptsEnabled
+********************************************************************************
+* Summary:
+*  Enables or disables the interrupts. A SysTick interrupt that became 
+*  pending while disabled is serviced when they are enabled again.
+*
+* Parameters:
+*  isEnabled - true to enable the interrupts
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockSysTick_SetInterruptsEnabled(bool isEnabled)
+{
+	isInterruptEnabled = isEnabled;
+	MockSysTick_Service();
+}
+
+
+/*******************************************************************************
+* Function Name: MockSysTick_Service
+********************************************************************************
+* Summary:
+*  Runs the callbacks if the SysTick interrupt is pending and enabled.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void MockSysTick_Service(void)
+{
+	uint32 i;
+	
+	if(isInterruptEnabled && ((MockSysTick_icsr & MOCK_SYSTICK_PENDSTSET) != 0))
+	{
+		MockSysTick_icsr &= ~MOCK_SYSTICK_PENDSTSET;
+		
+		for(i = 0; i < CY_SYS_SYST_NUM_OF_CALLBACKS; i++)
+		{
+			if(callbacks[i] != NULL)
+			{
+				callbacks[i]();
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickStart
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API, the timer always runs.
+*
+*******************************************************************************/
+void CySysTickStart(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickSetReload
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API.
+*
+*******************************************************************************/
+void CySysTickSetReload(uint32 newReload)
+{
+	reload = newReload;
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickGetReload
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API.
+*
+*******************************************************************************/
+uint32 CySysTickGetReload(void)
+{
+	return reload;
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickGetValue
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API.
+*
+*******************************************************************************/
+uint32 CySysTickGetValue(void)
+{
+	return value;
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickGetCountFlag
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API. As on the device, reading the flag clears it.
+*
+*******************************************************************************/
+uint32 CySysTickGetCountFlag(void)
+{
+	uint32 flag = isCountFlag ? 1u : 0u;
+	
+	isCountFlag = false;
+	
+	return flag;
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickClear
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API.
+*
+*******************************************************************************/
+void CySysTickClear(void)
+{
+	value = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: CySysTickSetCallback
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API.
+*
+*******************************************************************************/
+cySysTickCallback CySysTickSetCallback(uint32 number, cySysTickCallback function)
+{
+	cySysTickCallback previous = callbacks[number];
+	
+	callbacks[number] = function;
+	
+	return previous;
+}
+
+
+/*******************************************************************************
+* Function Name: CyEnterCriticalSection
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API, disables the interrupts.
+*
+*******************************************************************************/
+uint8 CyEnterCriticalSection(void)
+{
+	uint8 savedIntrStatus = isInterruptEnabled ? 0u : 1u;
+	
+	isInterruptEnabled = false;
+	
+	return savedIntrStatus;
+}
+
+
+/*******************************************************************************
+* Function Name: CyExitCriticalSection
+********************************************************************************
+* Summary:
+*  Mock of the cy_boot API, restores the interrupts.
+*
+*******************************************************************************/
+void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+	MockSysTick_SetInterruptsEnabled(savedIntrStatus == 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: CyHalt_Assert
+********************************************************************************
+* Summary:
+*  Called by CYASSERT() on the host. Reports the failed assertion and aborts,
+*  so that the test fails and a sanitizer or debugger shows the stack.
+*
+*******************************************************************************/
+void CyHalt_Assert(const char8 file[], uint32 line)
+{
+	fprintf(stderr, "CYASSERT failed at %s:%u\n", file, (unsigned)line);
+	abort();
+}
+
+
+/* [] END OF FILE */
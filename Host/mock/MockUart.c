@@ -0,0 +1,467 @@
+/*******************************************************************************
+* File Name: MockUart.c
+*
+* Version 1.0
+*
+* Description: Mock of the SCB UART component for the host build. Received bytes are
+*               queued by the test, transmitted bytes are collected in a buffer and
+*               optionally echoed to a stream. Also provides PrintField() of main.c.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "PlatformHost.h"
+#include "HostMock.h"
+#include "main.h"
+#include "stdlib.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Initial size of the output buffer, it grows as needed */
+#define MOCK_UART_OUTPUT_SIZE				(4096u)
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+static uint8 rxFifo[MOCK_UART_RX_SIZE];
+static uint32 rxHead, rxCount;
+
+static char8 *output;
+static uint32 outputLength, outputSize;
+static FILE *echo;
+
+/* TX interrupt: the handler runs whenever the TX FIFO not full interrupt is 
+ * enabled, as the FIFO of the mock is always empty 
+ */
+static cyisraddress txIsr;
+static uint32 txInterruptMask;
+static bool isInTxIsr;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void MockUart_Transmit(uint8 data);
+static void MockUart_ServiceTx(void);
+
+
+/*******************************************************************************
+* Function Name: MockUart_Reset
+********************************************************************************
+* Summary:
+*  Clears the receive FIFO, the output and the interrupt handler. The echo 
+*  stream is kept.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUart_Reset(void)
+{
+	rxHead = 0;
+	rxCount = 0;
+	outputLength = 0;
+	txIsr = NULL;
+	txInterruptMask = 0;
+	isInTxIsr = false;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_Receive
+********************************************************************************
+* Summary:
+*  Queues bytes in the receive FIFO, as far as they fit.
+*
+* Parameters:
+*  data - bytes received
+*  count - number of bytes
+*
+* Return:
+*  uint32 - number of bytes queued
+*
+*******************************************************************************/
+uint32 MockUart_Receive(const uint8 data[], uint32 count)
+{
+	uint32 i;
+	
+	for(i = 0; (i < count) && (rxCount < MOCK_UART_RX_SIZE); i++)
+	{
+		rxFifo[(rxHead + rxCount) % MOCK_UART_RX_SIZE] = data[i];
+		rxCount++;
+	}
+	
+	return i;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_GetRxFree
+********************************************************************************
+* Summary:
+*  Returns the free space of the receive FIFO.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 - number of bytes
+*
+*******************************************************************************/
+uint32 MockUart_GetRxFree(void)
+{
+	return MOCK_UART_RX_SIZE - rxCount;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_GetOutput
+********************************************************************************
+* Summary:
+*  Returns the bytes transmitted since the last MockUart_ClearOutput(). The
+*  text is zero terminated.
+*
+* Parameters:
+*  length - pointer to store the number of bytes, may be NULL
+*
+* Return:
+*  const char8 * - transmitted bytes
+*
+*******************************************************************************/
+const char8 *MockUart_GetOutput(uint32 *length)
+{
+	if(length != NULL)
+	{
+		*length = outputLength;
+	}
+	
+	if(output == NULL)
+	{
+		return "";
+	}
+	
+	output[outputLength] = '\0';
+	
+	return output;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_ClearOutput
+********************************************************************************
+* Summary:
+*  Clears the transmitted bytes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUart_ClearOutput(void)
+{
+	outputLength = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_SetEcho
+********************************************************************************
+* Summary:
+*  Selects a stream that receives a copy of every transmitted byte.
+*
+* Parameters:
+*  stream - output stream, NULL for none
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUart_SetEcho(FILE *stream)
+{
+	echo = stream;
+}
+
+
+/*******************************************************************************
+* Function Name: UART_Start
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void UART_Start(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: UART_UartPutString
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void UART_UartPutString(const char8 string[])
+{
+	while(*string != '\0')
+	{
+		MockUart_Transmit((uint8)*string);
+		string++;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: UART_UartPutChar
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void UART_UartPutChar(uint32 txDataByte)
+{
+	MockUart_Transmit((uint8)txDataByte);
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SpiUartWriteTxData
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void UART_SpiUartWriteTxData(uint32 txData)
+{
+	MockUart_Transmit((uint8)txData);
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SpiUartPutArray
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void UART_SpiUartPutArray(const uint8 wrBuf[], uint32 count)
+{
+	uint32 i;
+	
+	for(i = 0; i < count; i++)
+	{
+		MockUart_Transmit(wrBuf[i]);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SpiUartGetTxBufferSize
+********************************************************************************
+* Summary:
+*  Mock of the component API, the bytes are transmitted immediately.
+*
+*******************************************************************************/
+uint32 UART_SpiUartGetTxBufferSize(void)
+{
+	return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SpiUartReadRxData
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+uint32 UART_SpiUartReadRxData(void)
+{
+	uint32 data = 0;
+	
+	if(rxCount != 0)
+	{
+		data = rxFifo[rxHead];
+		rxHead = (rxHead + 1u) % MOCK_UART_RX_SIZE;
+		rxCount--;
+	}
+	
+	return data;
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SpiUartGetRxBufferSize
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+uint32 UART_SpiUartGetRxBufferSize(void)
+{
+	return rxCount;
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SetTxInterruptMode
+********************************************************************************
+* Summary:
+*  Mock of the component API. Enabling the TX FIFO not full interrupt runs
+*  the handler until it disables the interrupt again.
+*
+*******************************************************************************/
+void UART_SetTxInterruptMode(uint32 interruptMask)
+{
+	txInterruptMask = interruptMask;
+	MockUart_ServiceTx();
+}
+
+
+/*******************************************************************************
+* Function Name: UART_ClearTxInterruptSource
+********************************************************************************
+* Summary:
+*  Mock of the component API, the TX FIFO not full source is always set.
+*
+*******************************************************************************/
+void UART_ClearTxInterruptSource(uint32 interruptMask)
+{
+	(void)interruptMask;
+}
+
+
+/*******************************************************************************
+* Function Name: UART_SetCustomInterruptHandler
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+void UART_SetCustomInterruptHandler(cyisraddress func)
+{
+	txIsr = func;
+}
+
+
+/*******************************************************************************
+* Function Name: PrintField
+********************************************************************************
+* Summary:
+*  Host implementation of the function in main.c: prints a comma followed by
+*  the decimal value over UART.
+*
+*******************************************************************************/
+void PrintField(uint32 value)
+{
+	char8 text[12];
+	
+	(void)snprintf(text, sizeof(text), ",%u", (unsigned)value);
+	UART_UartPutString(text);
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_Transmit
+********************************************************************************
+* Summary:
+*  Appends a byte to the output and to the echo stream.
+*
+* Parameters:
+*  data - transmitted byte
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void MockUart_Transmit(uint8 data)
+{
+	/* Keep room for the terminating zero of MockUart_GetOutput() */
+	if((outputLength + 1u) >= outputSize)
+	{
+		outputSize = (outputSize == 0) ? MOCK_UART_OUTPUT_SIZE : (outputSize * 2u);
+		output = realloc(output, outputSize);
+		CYASSERT(output != NULL);
+	}
+	
+	output[outputLength++] = (char8)data;
+	
+	if(echo != NULL)
+	{
+		(void)fputc(data, echo);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockUart_ServiceTx
+********************************************************************************
+* Summary:
+*  Runs the TX interrupt handler while the TX FIFO not full interrupt is 
+*  enabled. The handler itself changes the mode, so it is not re-entered.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void MockUart_ServiceTx(void)
+{
+	if(isInTxIsr || (txIsr == NULL))
+	{
+		return;
+	}
+	
+	isInTxIsr = true;
+	while((txInterruptMask & UART_INTR_TX_NOT_FULL) != 0)
+	{
+		txIsr();
+	}
+	isInTxIsr = false;
+}
+
+
+/* [] END OF FILE */
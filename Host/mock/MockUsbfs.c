@@ -0,0 +1,447 @@
+/*******************************************************************************
+* File Name: MockUsbfs.c
+*
+* Version 1.0
+*
+* Description: Mock of the USBFS component for the host build. A mock USB host reads
+*               every loaded IN endpoint once per frame, see MockUsbfs_Frame().
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "PlatformHost.h"
+#include "HostMock.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Component Variables
+********************************************************************************/
+
+volatile uint8 USBFS_configuration;
+reg32 MockUsbfs_sof0;
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* State of each IN endpoint: the data loaded by the firmware, the data last 
+ * read by the host, and the number of reads.
+ */
+typedef struct
+{
+	bool isFull;
+	bool isAcked;
+	uint32 length;
+	uint8 loaded[MOCK_USBFS_EP_SIZE];
+	uint32 readLength;
+	uint8 read[MOCK_USBFS_EP_SIZE];
+	uint32 readCount;
+} tMockEndpoint;
+
+static tMockEndpoint endpoint[MOCK_USBFS_ENDPOINTS];
+
+static bool isAttached;
+static bool isStarted;
+
+/* The host reads the IN endpoints every pollPeriod frames, in the frames 
+ * where frameCount is a multiple of it
+ */
+static uint32 pollPeriod;
+static uint32 frameCount;
+
+/* The frame number register keeps its value while set */
+static bool isSofStalled;
+
+/* Configuration descriptor of the mock device: the keyboard, mouse and 
+ * consumer control interfaces, each with an interrupt IN endpoint. The 
+ * bInterval fields are set by MockUsbfs_SetInterval().
+ */
+static uint8 configDescr[] = 
+{
+	9u, USBFS_DESCR_CONFIG, 84u, 0u, 3u, 1u, 0u, 0x80u, 50u,
+	
+	9u, 4u, 0u, 0u, 1u, 3u, 1u, 1u, 0u,				/* Keyboard interface */
+	9u, 0x21u, 0x11u, 0x01u, 0u, 1u, 0x22u, 63u, 0u,
+	7u, USBFS_DESCR_ENDPOINT, 0x81u, 3u, 8u, 0u, MOCK_USBFS_INTERVAL,
+	
+	9u, 4u, 1u, 0u, 1u, 3u, 1u, 2u, 0u,				/* Mouse interface */
+	9u, 0x21u, 0x11u, 0x01u, 0u, 1u, 0x22u, 52u, 0u,
+	7u, USBFS_DESCR_ENDPOINT, 0x82u, 3u, 8u, 0u, MOCK_USBFS_INTERVAL,
+	
+	9u, 4u, 2u, 0u, 1u, 3u, 0u, 0u, 0u,				/* Consumer control interface */
+	9u, 0x21u, 0x11u, 0x01u, 0u, 1u, 0x22u, 25u, 0u,
+	7u, USBFS_DESCR_ENDPOINT, 0x83u, 3u, 8u, 0u, MOCK_USBFS_INTERVAL
+};
+
+/* Descriptor table of the single configuration */
+static const T_USBFS_LUT configTable[] = 
+{
+	{1u, configDescr}
+};
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_Reset
+********************************************************************************
+* Summary:
+*  Detaches the device and clears all the endpoints.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUsbfs_Reset(void)
+{
+	memset(endpoint, 0, sizeof(endpoint));
+	USBFS_configuration = 0;
+	MockUsbfs_sof0 = 0;
+	isAttached = true;
+	isStarted = false;
+	pollPeriod = 1;
+	frameCount = 0;
+	isSofStalled = false;
+	MockUsbfs_SetInterval(MOCK_USBFS_INTERVAL);
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_SetAttached
+********************************************************************************
+* Summary:
+*  Attaches or detaches the USB cable. The host configures the device on the
+*  next frame after the attach.
+*
+* Parameters:
+*  attached - true if VBUS is present
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUsbfs_SetAttached(bool attached)
+{
+	isAttached = attached;
+	
+	if(!attached)
+	{
+		memset(endpoint, 0, sizeof(endpoint));
+		USBFS_configuration = 0;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_SetPollPeriod
+********************************************************************************
+* Summary:
+*  Sets the number of frames between two reads of the IN endpoints by the 
+*  host, 1 after the reset. The start of frame is still sent every frame, so 
+*  the reports loaded in between wait for the next read, as with a host that
+*  polls at a longer interval than the endpoint descriptor asks for.
+*
+* Parameters:
+*  frames - frames between two reads, not 0. The next read is in the next 
+*           frame whose number since the reset is a multiple of it.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUsbfs_SetPollPeriod(uint32 frames)
+{
+	CYASSERT(frames != 0);
+	
+	pollPeriod = frames;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_SetInterval
+********************************************************************************
+* Summary:
+*  Sets the bInterval of every endpoint descriptor, MOCK_USBFS_INTERVAL after
+*  the reset. The host still reads the endpoints as set by 
+*  MockUsbfs_SetPollPeriod().
+*
+* Parameters:
+*  interval - polling interval in ms
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUsbfs_SetInterval(uint8 interval)
+{
+	uint32 pos;
+	
+	for(pos = 0; pos < sizeof(configDescr); pos += configDescr[pos])
+	{
+		if(configDescr[pos + 1u] == USBFS_DESCR_ENDPOINT)
+		{
+			configDescr[pos + 6u] = interval;
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_SetSofStall
+********************************************************************************
+* Summary:
+*  Stops or resumes the update of the frame number register, as if the start
+*  of frame packets were lost. The host still reads the endpoints.
+*
+* Parameters:
+*  stalled - true to keep the frame number
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUsbfs_SetSofStall(bool stalled)
+{
+	isSofStalled = stalled;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_Frame
+********************************************************************************
+* Summary:
+*  One USB frame of the mock host: sends the start of frame, configures the
+*  device once started, and reads every full IN endpoint if a read is due, 
+*  refer to MockUsbfs_SetPollPeriod().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void MockUsbfs_Frame(void)
+{
+	uint32 ep;
+	
+	if(!isAttached || !isStarted)
+	{
+		return;
+	}
+	
+	if(!isSofStalled)
+	{
+		MockUsbfs_sof0 = (MockUsbfs_sof0 + 1u) & 0xFFu;
+	}
+	USBFS_configuration = 1;
+	
+	frameCount++;
+	if((frameCount % pollPeriod) != 0)
+	{
+		return;
+	}
+	
+	for(ep = 0; ep < MOCK_USBFS_ENDPOINTS; ep++)
+	{
+		if(endpoint[ep].isFull)
+		{
+			memcpy(endpoint[ep].read, endpoint[ep].loaded, endpoint[ep].length);
+			endpoint[ep].readLength = endpoint[ep].length;
+			endpoint[ep].readCount++;
+			endpoint[ep].isFull = false;
+			endpoint[ep].isAcked = true;
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_GetInCount
+********************************************************************************
+* Summary:
+*  Returns the number of packets the host read from an IN endpoint.
+*
+* Parameters:
+*  epNumber - endpoint number
+*
+* Return:
+*  uint32 - number of packets
+*
+*******************************************************************************/
+uint32 MockUsbfs_GetInCount(uint32 epNumber)
+{
+	return endpoint[epNumber].readCount;
+}
+
+
+/*******************************************************************************
+* Function Name: MockUsbfs_GetInData
+********************************************************************************
+* Summary:
+*  Returns the last packet the host read from an IN endpoint.
+*
+* Parameters:
+*  epNumber - endpoint number
+*  length - pointer to store the length of the packet
+*
+* Return:
+*  const uint8 * - packet data
+*
+*******************************************************************************/
+const uint8 *MockUsbfs_GetInData(uint32 epNumber, uint32 *length)
+{
+	*length = endpoint[epNumber].readLength;
+	
+	return endpoint[epNumber].read;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_Start
+********************************************************************************
+* Summary:
+*  Mock of the component API. The device enumerates on the next frame.
+*
+*******************************************************************************/
+void USBFS_Start(uint8 device, uint8 mode)
+{
+	(void)device;
+	(void)mode;
+	
+	isStarted = true;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_VBusPresent
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+uint8 USBFS_VBusPresent(void)
+{
+	return isAttached ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_GetConfiguration
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+uint8 USBFS_GetConfiguration(void)
+{
+	return USBFS_configuration;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_GetConfigTablePtr
+********************************************************************************
+* Summary:
+*  Mock of the component API, the device has a single configuration.
+*
+*******************************************************************************/
+const T_USBFS_LUT *USBFS_GetConfigTablePtr(uint8 confIndex)
+{
+	CYASSERT(confIndex == 0);
+	
+	return configTable;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_CheckActivity
+********************************************************************************
+* Summary:
+*  Mock of the component API, the bus is active while the device is attached.
+*
+*******************************************************************************/
+uint8 USBFS_CheckActivity(void)
+{
+	return isAttached ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_GetEPState
+********************************************************************************
+* Summary:
+*  Mock of the component API.
+*
+*******************************************************************************/
+uint8 USBFS_GetEPState(uint8 epNumber)
+{
+	return endpoint[epNumber].isFull ? USBFS_IN_BUFFER_FULL : USBFS_IN_BUFFER_EMPTY;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_GetEPAckState
+********************************************************************************
+* Summary:
+*  Mock of the component API. The acknowledge stays set until the endpoint 
+*  is loaded again.
+*
+*******************************************************************************/
+uint8 USBFS_GetEPAckState(uint8 epNumber)
+{
+	return endpoint[epNumber].isAcked ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: USBFS_LoadInEP
+********************************************************************************
+* Summary:
+*  Mock of the component API. The host reads the data on the next frame.
+*
+*******************************************************************************/
+void USBFS_LoadInEP(uint8 epNumber, const uint8 pData[], uint16 length)
+{
+	CYASSERT(length <= MOCK_USBFS_EP_SIZE);
+	
+	memcpy(endpoint[epNumber].loaded, pData, length);
+	endpoint[epNumber].length = length;
+	endpoint[epNumber].isFull = true;
+	endpoint[epNumber].isAcked = false;
+}
+
+
+/* [] END OF FILE */
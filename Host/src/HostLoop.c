@@ -0,0 +1,281 @@
+/*******************************************************************************
+* File Name: HostLoop.c
+*
+* Version 1.0
+*
+* Description: Runs the application on the mock hardware layer of the host build.
+*               HostLoop_Init() and HostLoop_Iterate() follow InitSystem() and the
+*               main loop of main.c, which must be kept in step with them.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostLoop.h"
+#include "HostMock.h"
+#include "main.h"
+#include "Gesture.h"
+#include "HidReport.h"
+#include "HidSched.h"
+#include "LedControl.h"
+#include "LedAnim.h"
+#include "LedDriver.h"
+#include "LedStatus.h"
+#include "AdaptiveThreshold.h"
+#include "FrequencyHop.h"
+#include "SensorFilter.h"
+#include "SensorTrace.h"
+#include "GestureStats.h"
+#include "ReportDigest.h"
+#include "UsbSof.h"
+#include "Timebase.h"
+#include "Profile.h"
+#include "Latency.h"
+#include "Telemetry.h"
+#include "Log.h"
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Local variables of main() */
+static uint32 usbDeviceConfiguration;
+static bool usbDriverInstallationComplete;
+
+
+/*******************************************************************************
+* Function Name: HostLoop_Init
+********************************************************************************
+* Summary:
+*  Resets the mock hardware and initializes the application as InitSystem()
+*  does. The pin drive modes are not modelled.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostLoop_Init(void)
+{
+	Mock_Reset();
+	
+	usbDeviceConfiguration = 0;
+	usbDriverInstallationComplete = false;
+	
+	#if(ENABLE_UART_DBG_OUTPUT)
+		UART_Start();
+		Telemetry_Init();
+		Telemetry_Event(TELEMETRY_EVENT_APP_START, 0);
+	#elif(SENSOR_TRACE_MODE != SENSOR_TRACE_OFF)
+		UART_Start();
+	#endif /* #if(ENABLE_UART_DBG_OUTPUT) */
+	
+	Timebase_Init();
+	
+	PWM_Red_Start();
+	PWM_Green_Start();
+	PWM_Blue_Start();
+	LedDriver_Init();
+	LedAnim_Init();
+	SetLedColor(INIT_LED_COLOR, INIT_BRIGHT_LEVEL);
+	
+	CapSense_Start();
+	CapSense_InitializeAllBaselines();
+	AdaptiveThreshold_Init();
+	FrequencyHop_Init();
+	SensorFilter_Init();
+	
+	USBFS_Start(0, USBFS_5V_OPERATION);
+	
+	CapSense_ScanEnabledWidgets();
+	Latency_ScanStart();
+}
+
+
+/*******************************************************************************
+* Function Name: HostLoop_Iterate
+********************************************************************************
+* Summary:
+*  Runs one iteration of the main loop of main(). The debug commands are not
+*  processed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true if a frame was processed
+*
+*******************************************************************************/
+bool HostLoop_Iterate(void)
+{
+	tGestureId gestureId;
+	uint32 isAnySensorActive;
+	bool isFrame = false;
+	
+	Latency_Poll();
+	LedStatus_Poll();
+	
+	if(USBFS_VBusPresent() == true)
+	{
+		usbDeviceConfiguration = USBFS_GetConfiguration();
+	}
+	else
+	{
+		if(usbDeviceConfiguration == true)
+		{
+			LOG_USB_INFO(TELEMETRY_EVENT_USB_DISCONNECTED, 0);
+			SetLedColor(COLOR_OFF, BRIGHT_LEVEL_MAX);
+		}
+		
+		usbDeviceConfiguration = false;
+		USBFS_configuration = false;
+		HidSched_Reset();
+	}
+	
+	if((CapSense_IsBusy() == 0) && HidSched_IsIdle() && SensorTrace_IsFrameReady() &&
+		UsbSof_IsReportDue(usbDeviceConfiguration != 0))
+	{
+		isFrame = true;
+		
+		Latency_FrameStart();
+		LedStatus_FrameStart();
+		PROFILE_BEGIN(PROFILE_FRAME);
+		
+		PROFILE_BEGIN(PROFILE_BASELINE);
+		FrequencyHop_ProcessScan();
+		CapSense_UpdateEnabledBaselines();
+		PROFILE_END(PROFILE_BASELINE);
+		
+		PROFILE_BEGIN(PROFILE_SENSOR_FILTER);
+		SensorFilter_Process();
+		PROFILE_END(PROFILE_SENSOR_FILTER);
+		
+		PROFILE_BEGIN(PROFILE_THRESHOLD);
+		AdaptiveThreshold_Apply();
+		isAnySensorActive = CapSense_CheckIsAnyWidgetActive();
+		#if(SENSOR_TRACE_INJECT)
+			isAnySensorActive = SensorTrace_Replay();
+		#endif /* #if(SENSOR_TRACE_INJECT) */
+		AdaptiveThreshold_Update(isAnySensorActive);
+		PROFILE_END(PROFILE_THRESHOLD);
+		
+		FrequencyHop_NextChannel();
+		CapSense_ScanEnabledWidgets();
+		Latency_ScanStart();
+		
+		PROFILE_BEGIN(PROFILE_GESTURE);
+		gestureId = DetectGesture(isAnySensorActive);
+		PROFILE_END(PROFILE_GESTURE);
+		SensorTrace_Record();
+		GestureStats_Update(gestureId);
+		PROFILE_BEGIN(PROFILE_LED);
+		UpdateLedColor(gestureId);
+		PROFILE_END(PROFILE_LED);
+		
+		PROFILE_BEGIN(PROFILE_HID);
+		ConvertGestureToHidReport(gestureId);
+		PROFILE_END(PROFILE_HID);
+		ReportDigest_Update();
+		PROFILE_END(PROFILE_FRAME);
+		LedStatus_FrameEnd();
+		Latency_Decision(isAnySensorActive);
+		
+		if(usbDeviceConfiguration != 0)
+		{
+			if(HidSched_IsAcked() && (usbDriverInstallationComplete == false))
+			{
+				usbDriverInstallationComplete = true;
+				SetLedColor(COLOR_BLUE, BRIGHT_LEVEL_MAX);
+				LOG_USB_INFO(TELEMETRY_EVENT_DRIVERS_INSTALLED, 0);
+				(void)UsbSof_CheckInterval();
+			}
+			else if(usbDriverInstallationComplete == false)
+			{
+				HidSched_LoadInitial();
+			}
+			else if(usbDriverInstallationComplete == true)
+			{
+				HidSched_Queue();
+			}
+		}
+		else
+		{
+			usbDriverInstallationComplete = false;
+		}
+	}
+	
+	if(usbDriverInstallationComplete == true)
+	{
+		HidSched_Service();
+	}
+	
+	return isFrame;
+}
+
+
+/*******************************************************************************
+* Function Name: HostLoop_Frame
+********************************************************************************
+* Summary:
+*  Runs the main loop until a frame is processed. Every iteration takes one
+*  millisecond and one USB frame of the mock host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  bool - true if a frame was processed, false if none was processed within 
+*         HOST_LOOP_TIMEOUT_MS
+*
+*******************************************************************************/
+bool HostLoop_Frame(void)
+{
+	uint32 ms;
+	
+	for(ms = 0; ms < HOST_LOOP_TIMEOUT_MS; ms++)
+	{
+		MockSysTick_AdvanceMs(1u);
+		MockUsbfs_Frame();
+		
+		if(HostLoop_Iterate())
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,225 @@
+/*******************************************************************************
+* File Name: ArbitrationTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the button arbitration: the elements accepted from the
+*               touched buttons and slider, and the confidence of the result.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Strength of an element, as calculated by the arbitration */
+#define TEST_STRENGTH(signal, widget)		(((signal) * ARBITRATION_UNITY) / (CapSense_fingerThreshold[widget] + 1u))
+
+/* Confidence of a result, from the weakest accepted and the strongest
+ * rejected strength 
+ */
+#define TEST_CONFIDENCE(accepted, rejected)	((((accepted) - (rejected)) * CONFIDENCE_MAX) / (accepted))
+
+/* Slider segment touched in the checks, its sector points at no button */
+#define TEST_SLIDER_SEGMENT					(1u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void ArbitrationTest_Touch(uint32 left, uint32 right, uint32 up, uint32 centre, uint32 slider);
+static void ArbitrationTest_Release(void);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 left, right, centre, slider;
+	
+	HostLoop_Init();
+	
+	/* Opposite buttons: a single finger cannot touch both, the stronger one
+	 * is accepted 
+	 */
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(240u, 180u, 0, 0, 0);
+	left = TEST_STRENGTH(240u, CapSense_LEFT__BTN);
+	right = TEST_STRENGTH(180u, CapSense_RIGHT__BTN);
+	HOST_TEST_CHECK(arbitratedButtonStatus == LEFT_BTN_MASK);
+	HOST_TEST_CHECK(buttonConfidence == TEST_CONFIDENCE(left, right));
+	
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(180u, 240u, 0, 0, 0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == RIGHT_BTN_MASK);
+	HOST_TEST_CHECK(buttonConfidence == TEST_CONFIDENCE(left, right));
+	
+	/* Adjacent buttons: both are accepted, nothing is rejected */
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(240u, 0, 220u, 0, 0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == (LEFT_BTN_MASK | UP_BTN_MASK));
+	HOST_TEST_CHECK(buttonConfidence == CONFIDENCE_MAX);
+	
+	/* Centre button and slider: they are not adjacent, the stronger one 
+	 * relative to its finger threshold is accepted 
+	 */
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(0, 0, 0, 120u, 150u);
+	centre = TEST_STRENGTH(120u, CapSense_CENTRE__BTN);
+	slider = TEST_STRENGTH(150u, CapSense_RADIALSLIDER0__RS);
+	HOST_TEST_CHECK(slider > centre);
+	HOST_TEST_CHECK(arbitratedButtonStatus == SLIDER_ACT_MASK);
+	HOST_TEST_CHECK(buttonConfidence == TEST_CONFIDENCE(slider, centre));
+	
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(0, 0, 0, 200u, 110u);
+	centre = TEST_STRENGTH(200u, CapSense_CENTRE__BTN);
+	slider = TEST_STRENGTH(110u, CapSense_RADIALSLIDER0__RS);
+	HOST_TEST_CHECK(centre > slider);
+	HOST_TEST_CHECK(arbitratedButtonStatus == CENTRE_BTN_MASK);
+	HOST_TEST_CHECK(buttonConfidence == TEST_CONFIDENCE(centre, slider));
+	
+	/* Exact tie of opposite buttons: without history the result has no 
+	 * confidence. The button held on the previous scan wins by the hold bonus,
+	 * whichever it is.
+	 */
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(240u, 240u, 0, 0, 0);
+	HOST_TEST_CHECK((arbitratedButtonStatus == LEFT_BTN_MASK) || (arbitratedButtonStatus == RIGHT_BTN_MASK));
+	HOST_TEST_CHECK(buttonConfidence == 0);
+	
+	left = TEST_STRENGTH(240u, CapSense_LEFT__BTN);
+	right = TEST_STRENGTH(240u, CapSense_RIGHT__BTN);
+	
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(240u, 0, 0, 0, 0);
+	ArbitrationTest_Touch(240u, 240u, 0, 0, 0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == LEFT_BTN_MASK);
+	HOST_TEST_CHECK(buttonConfidence == TEST_CONFIDENCE(left + ARBITRATION_HOLD_BONUS, right));
+	
+	ArbitrationTest_Release();
+	ArbitrationTest_Touch(0, 240u, 0, 0, 0);
+	ArbitrationTest_Touch(240u, 240u, 0, 0, 0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == RIGHT_BTN_MASK);
+	HOST_TEST_CHECK(buttonConfidence == TEST_CONFIDENCE(right + ARBITRATION_HOLD_BONUS, left));
+	
+	/* The hold bonus keeps the held button until the other one is stronger by
+	 * more than the bonus 
+	 */
+	ArbitrationTest_Touch(250u, 240u, 0, 0, 0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == RIGHT_BTN_MASK);
+	ArbitrationTest_Touch(255u, 220u, 0, 0, 0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == LEFT_BTN_MASK);
+	
+	return HostTest_Result("ArbitrationTest");
+}
+
+
+/*******************************************************************************
+* Function Name: ArbitrationTest_Touch
+********************************************************************************
+* Summary:
+*  Runs the gesture detection on a scan with the given signals. The buttons 
+*  with a signal are reported active.
+*
+* Parameters:
+*  left, right, up, centre - signals of the buttons
+*  slider - signal of TEST_SLIDER_SEGMENT
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ArbitrationTest_Touch(uint32 left, uint32 right, uint32 up, uint32 centre, uint32 slider)
+{
+	memset(CapSense_sensorSignal, 0, sizeof(CapSense_sensorSignal));
+	memset(CapSense_sensorOnMask, 0, sizeof(CapSense_sensorOnMask));
+	
+	CapSense_sensorSignal[LEFT_BTN_ID] = (uint8)left;
+	CapSense_sensorSignal[RIGHT_BTN_ID] = (uint8)right;
+	CapSense_sensorSignal[UP_BTN_ID] = (uint8)up;
+	CapSense_sensorSignal[CENTRE_BTN_ID] = (uint8)centre;
+	CapSense_sensorSignal[SLIDER_ID + TEST_SLIDER_SEGMENT] = (uint8)slider;
+	
+	CapSense_sensorOnMask[0] = (uint8)(((left != 0) ? LEFT_BTN_MASK : 0) | ((right != 0) ? RIGHT_BTN_MASK : 0) |
+		((up != 0) ? UP_BTN_MASK : 0) | ((centre != 0) ? CENTRE_BTN_MASK : 0));
+	
+	(void)DetectGesture(1u);
+}
+
+
+/*******************************************************************************
+* Function Name: ArbitrationTest_Release
+********************************************************************************
+* Summary:
+*  Runs the gesture detection on an untouched scan, which clears the history 
+*  of the arbitration.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ArbitrationTest_Release(void)
+{
+	memset(CapSense_sensorSignal, 0, sizeof(CapSense_sensorSignal));
+	memset(CapSense_sensorOnMask, 0, sizeof(CapSense_sensorOnMask));
+	
+	(void)DetectGesture(0);
+	HOST_TEST_CHECK(arbitratedButtonStatus == 0);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/*******************************************************************************
+* File Name: ConsumerTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the consumer control report: inner rotations at two speeds
+*               send one volume step per CONSUMER_VOLUME_STEP_ANGLE of rotation.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "HidReport.h"
+#include "stdio.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Signal of a finger on a button, above the finger threshold and hysteresis */
+#define TEST_FINGER_SIGNAL					(240u)
+
+/* A button is touched while the finger is within this angle of its centre, 
+ * in degrees. Above 45 degrees, the finger touches two buttons between them.
+ */
+#define TEST_BUTTON_REACH					(50)
+
+/* Frames of the release after a rotation */
+#define TEST_RELEASE_FRAMES					(20u)
+
+/* Rotations: three turns at a slow and at a fast speed, in frames per turn */
+#define TEST_TURNS							(3)
+#define TEST_SLOW_TURN_FRAMES				(360)
+#define TEST_FAST_TURN_FRAMES				(90)
+
+/* Steps of TEST_TURNS turns. The first step is sent at the first inner
+ * rotation gesture, after the finger crossed the first sectors, and each
+ * further CONSUMER_VOLUME_STEP_ANGLE one more.
+ */
+#define TEST_STEPS_PER_TURN					((2 * ANGLE_180) / CONSUMER_VOLUME_STEP_ANGLE)
+#define TEST_MIN_STEPS						((TEST_TURNS * TEST_STEPS_PER_TURN) - 4)
+#define TEST_MAX_STEPS						(TEST_TURNS * TEST_STEPS_PER_TURN)
+
+
+/*******************************************************************************
+*	Local Data Type Definitions
+********************************************************************************/
+
+/* Volume keys sent to the host */
+typedef struct
+{
+	uint32 up;
+	uint32 down;
+}tTestSteps;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void ConsumerTest_Frame(tTestSteps *steps);
+static void ConsumerTest_Rotate(int32 startDegrees, int32 degrees, uint32 frames, tTestSteps *steps);
+static void ConsumerTest_Release(tTestSteps *steps);
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+/* Sensor and angle of the centre of each button, in degrees counter 
+ * clockwise from the positive x axis between the right and the up button
+ */
+static const uint8 testButtonSensor[] = {UP_BTN_ID, LEFT_BTN_ID, DOWN_BTN_ID, RIGHT_BTN_ID};
+static const int32 testButtonAngle[] = {45, 135, 225, 315};
+
+/* Reads of the consumer control endpoint counted so far */
+static uint32 testInCount;
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	tTestSteps slow = {0, 0}, fast = {0, 0}, counter = {0, 0}, reverse = {0, 0};
+	tTestSteps idle = {0, 0};
+	uint32 frame;
+	
+	HostLoop_Init();
+	
+	/* The device enumerates and the drivers install on the first frames */
+	ConsumerTest_Release(&idle);
+	
+	/* Clockwise is decreasing angle, volume up */
+	ConsumerTest_Rotate(0, -360 * TEST_TURNS, TEST_TURNS * TEST_SLOW_TURN_FRAMES, &slow);
+	ConsumerTest_Release(&slow);
+	ConsumerTest_Rotate(0, -360 * TEST_TURNS, TEST_TURNS * TEST_FAST_TURN_FRAMES, &fast);
+	ConsumerTest_Release(&fast);
+	printf("clockwise slow: %u up, %u down, fast: %u up, %u down\n", 
+		(unsigned)slow.up, (unsigned)slow.down, (unsigned)fast.up, (unsigned)fast.down);
+	
+	/* The step count follows the angle, so the step rate follows the speed */
+	HOST_TEST_CHECK((slow.up >= TEST_MIN_STEPS) && (slow.up <= TEST_MAX_STEPS));
+	HOST_TEST_CHECK((fast.up >= TEST_MIN_STEPS) && (fast.up <= TEST_MAX_STEPS));
+	HOST_TEST_CHECK((slow.down == 0) && (fast.down == 0));
+	
+	ConsumerTest_Rotate(0, 360 * TEST_TURNS, TEST_TURNS * TEST_FAST_TURN_FRAMES, &counter);
+	ConsumerTest_Release(&counter);
+	printf("counter clockwise fast: %u up, %u down\n", (unsigned)counter.up, (unsigned)counter.down);
+	HOST_TEST_CHECK((counter.down >= TEST_MIN_STEPS) && (counter.down <= TEST_MAX_STEPS));
+	HOST_TEST_CHECK(counter.up == 0);
+	
+	/* A reversal in the same touch drops the rest of the first direction */
+	ConsumerTest_Rotate(0, -360, TEST_SLOW_TURN_FRAMES, &reverse);
+	ConsumerTest_Rotate(-360, 360, TEST_SLOW_TURN_FRAMES, &reverse);
+	ConsumerTest_Release(&reverse);
+	printf("one turn each way: %u up, %u down\n", (unsigned)reverse.up, (unsigned)reverse.down);
+	HOST_TEST_CHECK((reverse.up >= (TEST_STEPS_PER_TURN - 3)) && (reverse.up <= TEST_STEPS_PER_TURN));
+	HOST_TEST_CHECK((reverse.down >= (TEST_STEPS_PER_TURN - 4)) && (reverse.down <= TEST_STEPS_PER_TURN));
+	
+	/* No steps without a rotation */
+	for(frame = 0; frame < TEST_RELEASE_FRAMES; frame++)
+	{
+		ConsumerTest_Frame(&idle);
+	}
+	HOST_TEST_CHECK((idle.up == 0) && (idle.down == 0));
+	
+	return HostTest_Result("ConsumerTest");
+}
+
+
+/*******************************************************************************
+* Function Name: ConsumerTest_Frame
+********************************************************************************
+* Summary:
+*  Processes a frame with the current raw counts and counts the volume keys 
+*  the host read.
+*
+* Parameters:
+*  steps - volume key counts to update
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConsumerTest_Frame(tTestSteps *steps)
+{
+	const uint8 *data;
+	uint32 length, usage;
+	
+	HOST_TEST_CHECK(HostLoop_Frame());
+	
+	if(MockUsbfs_GetInCount(CONSUMER_END_POINT) != testInCount)
+	{
+		testInCount = MockUsbfs_GetInCount(CONSUMER_END_POINT);
+		data = MockUsbfs_GetInData(CONSUMER_END_POINT, &length);
+		HOST_TEST_CHECK(length == CONSUMER_RPT_SIZE);
+		
+		usage = data[CONSUMER_RPT_USAGE_LSB_POS] | ((uint32)data[CONSUMER_RPT_USAGE_MSB_POS] << 8);
+		if(usage == CONSUMER_USAGE_VOLUME_UP)
+		{
+			steps->up++;
+		}
+		else if(usage == CONSUMER_USAGE_VOLUME_DOWN)
+		{
+			steps->down++;
+		}
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: ConsumerTest_Rotate
+********************************************************************************
+* Summary:
+*  Moves the finger around the inner buttons at a constant speed.
+*
+* Parameters:
+*  startDegrees - angle of the finger at the start
+*  degrees - rotation, positive counter clockwise
+*  frames - frames of the rotation
+*  steps - volume key counts to update
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConsumerTest_Rotate(int32 startDegrees, int32 degrees, uint32 frames, tTestSteps *steps)
+{
+	uint32 frame, i;
+	int32 angle, distance;
+	
+	for(frame = 0; frame <= frames; frame++)
+	{
+		angle = startDegrees + ((degrees * (int32)frame) / (int32)frames);
+		
+		for(i = 0; i < sizeof(testButtonSensor); i++)
+		{
+			distance = (((angle - testButtonAngle[i]) % 360) + 360) % 360;
+			if(distance > 180)
+			{
+				distance = 360 - distance;
+			}
+			MockCapSense_SetSignal(testButtonSensor[i], (distance <= TEST_BUTTON_REACH) ? TEST_FINGER_SIGNAL : 0u);
+		}
+		
+		ConsumerTest_Frame(steps);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: ConsumerTest_Release
+********************************************************************************
+* Summary:
+*  Lifts the finger for TEST_RELEASE_FRAMES, so that the pending steps are sent.
+*
+* Parameters:
+*  steps - volume key counts to update
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConsumerTest_Release(tTestSteps *steps)
+{
+	uint32 frame, i;
+	
+	for(i = 0; i < sizeof(testButtonSensor); i++)
+	{
+		MockCapSense_SetSignal(testButtonSensor[i], 0);
+	}
+	
+	for(frame = 0; frame < TEST_RELEASE_FRAMES; frame++)
+	{
+		ConsumerTest_Frame(steps);
+	}
+}
+
+
+/* [] END OF FILE */
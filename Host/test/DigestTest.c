@@ -0,0 +1,292 @@
+/*******************************************************************************
+* File Name: DigestTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the HID reports: the firmware built with SENSOR_TRACE_SYNTH, or
+*               with SENSOR_TRACE_REPLAY and given a trace, must reproduce its golden report
+*               stream frame by frame.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "ReportDigest.h"
+#include "stdlib.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Frames after which the run gives up, the digest is completed before */
+#define TEST_MAX_FRAMES						(REPORT_DIGEST_FRAMES + 100u)
+
+/* Longest line of a report stream */
+#define TEST_LINE_SIZE						(128u)
+
+
+/*******************************************************************************
+* 	External Variable Declarations
+*******************************************************************************/
+
+/* Keyboard, Mouse and Consumer control HID report arrays, declared in 
+ * HidReport.c 
+ */
+extern uint8 keyboardReport[];
+extern int8 mouseReport[];
+#if(CONSUMER_REPORT_ENABLE)
+	extern uint8 consumerReport[];
+#endif /* #if(CONSUMER_REPORT_ENABLE) */
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void DigestTest_FormatReports(char8 line[], uint32 frame);
+static void DigestTest_PrintDigest(void);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the firmware until the digest is completed and compares the reports of
+*  every frame with the golden report stream. The first frame that differs is
+*  printed. With --accept, the golden report stream is written instead, to 
+*  accept a new output after an intended change of behavior.
+*
+*  Usage: DigestTest [--accept] <reports>            (SENSOR_TRACE_SYNTH)
+*         DigestTest [--accept] <reports> <trace>    (SENSOR_TRACE_REPLAY)
+*
+* Parameters:
+*  argc, argv - command line
+*
+* Return:
+*  int - EXIT_SUCCESS if the golden report stream was reproduced or written
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+	FILE *trace = NULL;
+	FILE *golden;
+	uint8 buffer[TRACE_FRAME_SIZE];
+	char8 actual[TEST_LINE_SIZE], expected[TEST_LINE_SIZE];
+	uint32 frames, buffered = 0, sent = 0, mismatchFrame = 0;
+	bool isAccept = false;
+	int arg = 1;
+	
+	if((argc > arg) && (strcmp(argv[arg], "--accept") == 0))
+	{
+		isAccept = true;
+		arg++;
+	}
+	
+	#if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY)
+		if(argc != (arg + 2))
+		{
+			fprintf(stderr, "usage: %s [--accept] <reports> <trace file>\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+		trace = fopen(argv[arg + 1], "rb");
+		if(trace == NULL)
+		{
+			fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[arg + 1]);
+			return EXIT_FAILURE;
+		}
+	#else
+		if(argc != (arg + 1))
+		{
+			fprintf(stderr, "usage: %s [--accept] <reports>\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	#endif /* #if(SENSOR_TRACE_MODE == SENSOR_TRACE_REPLAY) */
+	
+	golden = fopen(argv[arg], isAccept ? "w" : "r");
+	if(golden == NULL)
+	{
+		fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[arg]);
+		return EXIT_FAILURE;
+	}
+	
+	HostLoop_Init();
+	
+	for(frames = 0; (frames < TEST_MAX_FRAMES) && !ReportDigest_IsComplete(); )
+	{
+		/* Feed the trace as the receive buffer accepts it */
+		if(trace != NULL)
+		{
+			if(sent == buffered)
+			{
+				buffered = (uint32)fread(buffer, 1u, sizeof(buffer), trace);
+				sent = 0;
+			}
+			sent += MockUart_Receive(&buffer[sent], buffered - sent);
+		}
+		
+		if(HostLoop_Frame())
+		{
+			frames++;
+			DigestTest_FormatReports(actual, frames);
+			
+			if(isAccept)
+			{
+				(void)fputs(actual, golden);
+			}
+			else if(mismatchFrame == 0)
+			{
+				if(fgets(expected, (int)sizeof(expected), golden) == NULL)
+				{
+					(void)strcpy(expected, "(end of the golden reports)\n");
+				}
+				if(strcmp(actual, expected) != 0)
+				{
+					mismatchFrame = frames;
+					printf("first mismatch in frame %u\n  golden: %s  actual: %s", (unsigned)frames, expected, actual);
+				}
+			}
+			
+			DigestTest_PrintDigest();
+		}
+		else if((trace != NULL) && (buffered == 0))
+		{
+			/* End of the trace */
+			break;
+		}
+		
+		MockUart_ClearOutput();
+	}
+	
+	/* The golden stream must not go on after the run */
+	if(!isAccept && (mismatchFrame == 0) && (fgets(expected, (int)sizeof(expected), golden) != NULL))
+	{
+		mismatchFrame = frames + 1u;
+		printf("first mismatch in frame %u\n  golden: %s  actual: (end of the run)\n", (unsigned)mismatchFrame, expected);
+	}
+	
+	if(trace != NULL)
+	{
+		(void)fclose(trace);
+	}
+	HOST_TEST_CHECK(fclose(golden) == 0);
+	HOST_TEST_CHECK(ReportDigest_IsComplete());
+	HOST_TEST_CHECK(mismatchFrame == 0);
+	
+	if(isAccept)
+	{
+		printf("%u frames written to %s\n", (unsigned)frames, argv[arg]);
+	}
+	
+	return HostTest_Result("DigestTest");
+}
+
+
+/*******************************************************************************
+* Function Name: DigestTest_FormatReports
+********************************************************************************
+* Summary:
+*  Formats the reports of a frame as a line of the report stream, in the 
+*  format of REPORT_DIGEST_PRINT_REPORTS: 
+*  report,<frame>,<keyboard bytes>,<mouse bytes>[,<consumer bytes>]
+*
+* Parameters:
+*  line - TEST_LINE_SIZE characters, receives the line with its newline
+*  frame - frame number, from 1
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void DigestTest_FormatReports(char8 line[], uint32 frame)
+{
+	uint32 i, length;
+	
+	length = (uint32)snprintf(line, TEST_LINE_SIZE, "report,%u", (unsigned)frame);
+	for(i = 0; i < KEY_RPT_SIZE; i++)
+	{
+		length += (uint32)snprintf(&line[length], TEST_LINE_SIZE - length, ",%u", keyboardReport[i]);
+	}
+	for(i = 0; i < MOUSE_RPT_SIZE; i++)
+	{
+		length += (uint32)snprintf(&line[length], TEST_LINE_SIZE - length, ",%u", (uint8)mouseReport[i]);
+	}
+	#if(CONSUMER_REPORT_ENABLE)
+		for(i = 0; i < CONSUMER_RPT_SIZE; i++)
+		{
+			length += (uint32)snprintf(&line[length], TEST_LINE_SIZE - length, ",%u", consumerReport[i]);
+		}
+	#endif /* #if(CONSUMER_REPORT_ENABLE) */
+	(void)snprintf(&line[length], TEST_LINE_SIZE - length, "\n");
+}
+
+
+/*******************************************************************************
+* Function Name: DigestTest_PrintDigest
+********************************************************************************
+* Summary:
+*  Prints the digest line of the UART output of the frame, if any, so that the
+*  digest of a device run can be compared with the test log.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void DigestTest_PrintDigest(void)
+{
+	const char8 *output;
+	uint32 length, i, start;
+	
+	output = MockUart_GetOutput(&length);
+	
+	for(start = 0; (start + 6u) <= length; start++)
+	{
+		if(memcmp(&output[start], "digest", 6u) == 0)
+		{
+			for(i = start; (i < length) && (output[i] != '\n'); i++)
+			{
+				(void)putchar(output[i]);
+			}
+			(void)putchar('\n');
+			return;
+		}
+	}
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* File Name: FrequencyHopTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the frequency hopping scan: the channels of a sensor scanned
+*               at different sense clock gains are combined by their median.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "FrequencyHop.h"
+#include "stdio.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Signal of a finger on a button, at the gain of the component divider */
+#define TEST_FINGER_SIGNAL					(100u)
+
+/* Signal of an interference that only hits one channel */
+#define TEST_INTERFERENCE_SIGNAL			(200u)
+
+/* Frames for the sensor to settle, every channel is scanned in each of them */
+#define TEST_SETTLE_FRAMES					(2u * FREQ_HOP_CHANNELS)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static uint32 FrequencyHopTest_RunFrames(uint32 frames, uint32 signal);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 channel, frame;
+	
+	HostLoop_Init();
+	
+	HOST_TEST_CHECK(FrequencyHopTest_RunFrames(TEST_SETTLE_FRAMES, 0) == 0);
+	
+	/* The raw count of the finger scales with the sense clock divider of each
+	 * channel. The combined signal is the signal at the component divider.
+	 */
+	(void)FrequencyHopTest_RunFrames(TEST_SETTLE_FRAMES, TEST_FINGER_SIGNAL);
+	for(frame = 0; frame < TEST_SETTLE_FRAMES; frame++)
+	{
+		HOST_TEST_CHECK(FrequencyHopTest_RunFrames(1u, TEST_FINGER_SIGNAL) == TEST_FINGER_SIGNAL);
+	}
+	
+	/* Interference on the scan of a single channel is rejected by the median.
+	 * The next interference hits the next channel. 
+	 */
+	for(channel = 0; channel < FREQ_HOP_CHANNELS; channel++)
+	{
+		HOST_TEST_CHECK(FrequencyHopTest_RunFrames(1u, TEST_INTERFERENCE_SIGNAL) == TEST_FINGER_SIGNAL);
+		for(frame = 0; frame < FREQ_HOP_CHANNELS; frame++)
+		{
+			HOST_TEST_CHECK(FrequencyHopTest_RunFrames(1u, TEST_FINGER_SIGNAL) == TEST_FINGER_SIGNAL);
+		}
+	}
+	
+	/* The release is reported once two of the channels are released */
+	HOST_TEST_CHECK(FrequencyHopTest_RunFrames(1u, 0) == TEST_FINGER_SIGNAL);
+	HOST_TEST_CHECK(FrequencyHopTest_RunFrames(1u, 0) == TEST_FINGER_SIGNAL);
+	HOST_TEST_CHECK(FrequencyHopTest_RunFrames(1u, 0) == 0);
+	
+	return HostTest_Result("FrequencyHopTest");
+}
+
+
+/*******************************************************************************
+* Function Name: FrequencyHopTest_RunFrames
+********************************************************************************
+* Summary:
+*  Processes a number of frames, with a signal on the left button in the scans
+*  started by them.
+*
+* Parameters:
+*  frames - number of frames
+*  signal - signal of the left button at the component divider
+*
+* Return:
+*  uint32 - signal of the left button in the last frame
+*
+*******************************************************************************/
+static uint32 FrequencyHopTest_RunFrames(uint32 frames, uint32 signal)
+{
+	MockCapSense_SetSignal(LEFT_BTN_ID, signal);
+	
+	while(frames != 0)
+	{
+		HOST_TEST_CHECK(HostLoop_Frame());
+		frames--;
+	}
+	
+	return CapSense_sensorSignal[LEFT_BTN_ID];
+}
+
+
+/* [] END OF FILE */
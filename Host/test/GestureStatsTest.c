@@ -0,0 +1,216 @@
+/*******************************************************************************
+* File Name: GestureStatsTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the gesture benchmark: labeled taps replayed through the
+*               firmware are counted in the confusion matrix, summary and latency lines
+*               of the dump.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "GestureStats.h"
+#include "SensorTrace.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Signal of a finger on a button */
+#define TEST_FINGER_SIGNAL					(240u)
+
+/* Frames of the enumeration, of a button press and of the release after it */
+#define TEST_ENUM_FRAMES					(20u)
+#define TEST_PRESS_FRAMES					(10u)
+#define TEST_RELEASE_FRAMES					(20u)
+
+/* Length of an expected dump line */
+#define TEST_LINE_SIZE						(64u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void GestureStatsTest_Send(uint32 sensor, uint32 label);
+static void GestureStatsTest_Tap(uint32 sensor, uint32 label);
+static void GestureStatsTest_Expect(const char8 record[], uint32 a, uint32 b, uint32 c);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 i;
+	char8 line[TEST_LINE_SIZE];
+	
+	HostLoop_Init();
+	
+	for(i = 0; i < TEST_ENUM_FRAMES; i++)
+	{
+		GestureStatsTest_Send(CapSense_TOTAL_SENSOR_COUNT, TRACE_LABEL_NONE);
+	}
+	GestureStats_Clear();
+	
+	/* Two left clicks recognized as such, one recognized as a right click, 
+	 * and one unlabeled right click
+	 */
+	GestureStatsTest_Tap(LEFT_BTN_ID, GESTURE_LEFT_CLICK);
+	GestureStatsTest_Tap(LEFT_BTN_ID, GESTURE_LEFT_CLICK);
+	GestureStatsTest_Tap(RIGHT_BTN_ID, GESTURE_LEFT_CLICK);
+	GestureStatsTest_Tap(RIGHT_BTN_ID, TRACE_LABEL_NONE);
+	
+	MockUart_ClearOutput();
+	GestureStatsTest_Send(CapSense_TOTAL_SENSOR_COUNT, GESTURE_STATS_LABEL_DUMP);
+	
+	HOST_TEST_CHECK(HostTest_IsInOutput("\n\rthroughput,"));
+	GestureStatsTest_Expect("confusion", GESTURE_LEFT_CLICK, GESTURE_LEFT_CLICK, 2u);
+	GestureStatsTest_Expect("confusion", GESTURE_LEFT_CLICK, GESTURE_RIGHT_CLICK, 1u);
+	GestureStatsTest_Expect("confusion", GESTURE_NONE, GESTURE_RIGHT_CLICK, 1u);
+	
+	/* Left: 2 true positives, no false positive, 1 false negative. Right: the
+	 * unlabeled click is not a false positive.
+	 */
+	(void)snprintf(line, sizeof(line), "summary,%u,2,0,1,100,66\n\r", GESTURE_LEFT_CLICK);
+	HOST_TEST_CHECK(HostTest_IsInOutput(line));
+	(void)snprintf(line, sizeof(line), "summary,%u,0,1,0,0,0\n\r", GESTURE_RIGHT_CLICK);
+	HOST_TEST_CHECK(HostTest_IsInOutput(line));
+	
+	/* The clicks are recognized on the release, after TEST_PRESS_FRAMES */
+	GestureStatsTest_Expect("latency", GESTURE_LEFT_CLICK, TEST_PRESS_FRAMES / GESTURE_STATS_BUCKET_FRAMES, 2u);
+	GestureStatsTest_Expect("latency", GESTURE_RIGHT_CLICK, TEST_PRESS_FRAMES / GESTURE_STATS_BUCKET_FRAMES, 2u);
+	
+	/* The dump clears the results */
+	MockUart_ClearOutput();
+	GestureStats_Dump();
+	HOST_TEST_CHECK(!HostTest_IsInOutput("confusion,"));
+	HOST_TEST_CHECK(!HostTest_IsInOutput("latency,"));
+	
+	return HostTest_Result("GestureStatsTest");
+}
+
+
+/*******************************************************************************
+* Function Name: GestureStatsTest_Send
+********************************************************************************
+* Summary:
+*  Sends a trace frame and processes it.
+*
+* Parameters:
+*  sensor - touched button, CapSense_TOTAL_SENSOR_COUNT for none
+*  label - label of the frame
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void GestureStatsTest_Send(uint32 sensor, uint32 label)
+{
+	uint8 frame[TRACE_FRAME_SIZE];
+	
+	HostTest_BuildFrame(frame, sensor, TEST_FINGER_SIGNAL, label);
+	HOST_TEST_CHECK(MockUart_Receive(frame, TRACE_FRAME_SIZE) == TRACE_FRAME_SIZE);
+	HOST_TEST_CHECK(HostLoop_Frame());
+}
+
+
+/*******************************************************************************
+* Function Name: GestureStatsTest_Tap
+********************************************************************************
+* Summary:
+*  Sends the frames of a tap on a button.
+*
+* Parameters:
+*  sensor - touched button
+*  label - label of the touch frames
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void GestureStatsTest_Tap(uint32 sensor, uint32 label)
+{
+	uint32 i;
+	
+	for(i = 0; i < TEST_PRESS_FRAMES; i++)
+	{
+		GestureStatsTest_Send(sensor, label);
+	}
+	for(i = 0; i < TEST_RELEASE_FRAMES; i++)
+	{
+		GestureStatsTest_Send(CapSense_TOTAL_SENSOR_COUNT, TRACE_LABEL_NONE);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: GestureStatsTest_Expect
+********************************************************************************
+* Summary:
+*  Checks that the dump contains a record with three fields.
+*
+* Parameters:
+*  record - name of the record
+*  a, b, c - fields of the record
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void GestureStatsTest_Expect(const char8 record[], uint32 a, uint32 b, uint32 c)
+{
+	char8 line[TEST_LINE_SIZE];
+	
+	(void)snprintf(line, sizeof(line), "%s,%u,%u,%u\n\r", record, (unsigned)a, (unsigned)b, (unsigned)c);
+	HOST_TEST_CHECK(HostTest_IsInOutput(line));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+/*******************************************************************************
+* File Name: GestureTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the CapSense to USB path: button clicks through the
+*               gesture engine and the HID reports, and the radial slider centroid.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "Centroid.h"
+#include "HidReport.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Signal of a finger on a button, above the finger threshold and hysteresis */
+#define TEST_FINGER_SIGNAL					(240u)
+
+/* Frames of a button press and of the release after it */
+#define TEST_PRESS_FRAMES					(10u)
+#define TEST_RELEASE_FRAMES					(20u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void GestureTest_RunFrames(uint32 frames);
+static uint8 GestureTest_PressButton(uint32 sensor);
+static void GestureTest_Centroid(void);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 length;
+	
+	HostLoop_Init();
+	
+	/* The device enumerates and the drivers install on the first frames */
+	GestureTest_RunFrames(TEST_RELEASE_FRAMES);
+	HOST_TEST_CHECK(MockUsbfs_GetInCount(MOUSE_END_POINT) != 0);
+	HOST_TEST_CHECK(MockUsbfs_GetInData(MOUSE_END_POINT, &length)[MOUSE_RPT_BTN_POS] == 0);
+	HOST_TEST_CHECK(length == MOUSE_RPT_SIZE);
+	
+	HOST_TEST_CHECK(GestureTest_PressButton(LEFT_BTN_ID) == MOUSE_RPT_LEFT_BTN_MASK);
+	HOST_TEST_CHECK(GestureTest_PressButton(RIGHT_BTN_ID) == MOUSE_RPT_RIGHT_BTN_MASK);
+	HOST_TEST_CHECK(GestureTest_PressButton(CENTRE_BTN_ID) == MOUSE_RPT_MIDDLE_BTN_MASK);
+	HOST_TEST_CHECK(MockUsbfs_GetInData(MOUSE_END_POINT, &length)[MOUSE_RPT_BTN_POS] == 0);
+	
+	GestureTest_Centroid();
+	
+	return HostTest_Result("GestureTest");
+}
+
+
+/*******************************************************************************
+* Function Name: GestureTest_RunFrames
+********************************************************************************
+* Summary:
+*  Processes a number of frames with the current raw counts.
+*
+* Parameters:
+*  frames - number of frames
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void GestureTest_RunFrames(uint32 frames)
+{
+	while(frames != 0)
+	{
+		HOST_TEST_CHECK(HostLoop_Frame());
+		frames--;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: GestureTest_PressButton
+********************************************************************************
+* Summary:
+*  Taps a button: presses it for TEST_PRESS_FRAMES and releases it for
+*  TEST_RELEASE_FRAMES.
+*
+* Parameters:
+*  sensor - sensor of the button
+*
+* Return:
+*  uint8 - mouse buttons reported to the host during the tap
+*
+*******************************************************************************/
+static uint8 GestureTest_PressButton(uint32 sensor)
+{
+	uint32 frame, length;
+	uint8 buttons = 0;
+	
+	MockCapSense_SetSignal(sensor, TEST_FINGER_SIGNAL);
+	for(frame = 0; frame < TEST_PRESS_FRAMES; frame++)
+	{
+		GestureTest_RunFrames(1u);
+		buttons |= MockUsbfs_GetInData(MOUSE_END_POINT, &length)[MOUSE_RPT_BTN_POS];
+	}
+	
+	/* A tap is reported on the frame the finger is released */
+	MockCapSense_SetSignal(sensor, 0);
+	for(frame = 0; frame < TEST_RELEASE_FRAMES; frame++)
+	{
+		GestureTest_RunFrames(1u);
+		buttons |= MockUsbfs_GetInData(MOUSE_END_POINT, &length)[MOUSE_RPT_BTN_POS];
+	}
+	
+	return buttons;
+}
+
+
+/*******************************************************************************
+* Function Name: GestureTest_Centroid
+********************************************************************************
+* Summary:
+*  Checks the centroid of the radial slider on a symmetric and an asymmetric
+*  finger, and on an untouched slider.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void GestureTest_Centroid(void)
+{
+	uint32 i, confidence = 0;
+	
+	for(i = 0; i < RADIAL_SLIDER_SEGMENTS; i++)
+	{
+		CapSense_sensorSignal[SLIDER_ID + i] = 0;
+	}
+	HOST_TEST_CHECK(Centroid_GetRadialPos(&confidence) == CENTROID_INVALID);
+	
+	/* Finger centred on segment 2 */
+	CapSense_sensorSignal[SLIDER_ID + 1] = 100;
+	CapSense_sensorSignal[SLIDER_ID + 2] = 200;
+	CapSense_sensorSignal[SLIDER_ID + 3] = 100;
+	HOST_TEST_CHECK(Centroid_GetRadialPos(&confidence) == (((2u << CENTROID_FRAC_BITS) * SLIDER_RESOLUTION) / RADIAL_SLIDER_SEGMENTS));
+	HOST_TEST_CHECK(confidence == CONFIDENCE_MAX);
+	
+	/* Finger between segment 2 and 3: (130 - 80) / (80 + 180 + 130) of a 
+	 * segment past segment 2, after the noise threshold is subtracted 
+	 */
+	CapSense_sensorSignal[SLIDER_ID + 3] = 150;
+	HOST_TEST_CHECK(Centroid_GetRadialPos(&confidence) == ((((2u << CENTROID_FRAC_BITS) + ((50u << CENTROID_FRAC_BITS) / 390u)) * SLIDER_RESOLUTION) / RADIAL_SLIDER_SEGMENTS));
+	
+	/* Finger between the last and the first segment wraps around */
+	for(i = 0; i < RADIAL_SLIDER_SEGMENTS; i++)
+	{
+		CapSense_sensorSignal[SLIDER_ID + i] = 0;
+	}
+	CapSense_sensorSignal[SLIDER_ID + RADIAL_SLIDER_SEGMENTS - 1] = 150;
+	CapSense_sensorSignal[SLIDER_ID] = 200;
+	HOST_TEST_CHECK(Centroid_GetRadialPos(&confidence) > (((RADIAL_SLIDER_SEGMENTS - 1u) << CENTROID_FRAC_BITS) * SLIDER_RESOLUTION / RADIAL_SLIDER_SEGMENTS));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,221 @@
+/*******************************************************************************
+* File Name: HidSchedTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the single interface HID scheduler: the report IDs and the
+*               priority order of the pending reports on the shared endpoint.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "HidReport.h"
+#include "HidSched.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Frames for the device to enumerate and the drivers to install */
+#define TEST_ENUMERATION_FRAMES				(20u)
+
+/* Report data of the checks */
+#define TEST_KEY_CODE						(KEY_RPT_TAB_CODE)
+#define TEST_MOUSE_X						(5)
+#define TEST_CONSUMER_USAGE					(CONSUMER_USAGE_PLAY_PAUSE)
+
+
+/*******************************************************************************
+* 	External Variable Declarations
+*******************************************************************************/
+
+/* Keyboard, Mouse and Consumer control HID report arrays, declared in 
+ * HidReport.c 
+ */
+extern uint8 keyboardReport[];
+extern int8 mouseReport[];
+extern uint8 consumerReport[];
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void HidSchedTest_Expect(uint8 reportId, const uint8 report[], uint32 size);
+static void HidSchedTest_ExpectIdle(void);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 frame, count;
+	
+	HostLoop_Init();
+	
+	for(frame = 0; frame < TEST_ENUMERATION_FRAMES; frame++)
+	{
+		HOST_TEST_CHECK(HostLoop_Frame());
+	}
+	HOST_TEST_CHECK(MockUsbfs_GetInCount(HID_END_POINT) != 0);
+	
+	/* Frames without new data do not use the endpoint */
+	count = MockUsbfs_GetInCount(HID_END_POINT);
+	for(frame = 0; frame < TEST_ENUMERATION_FRAMES; frame++)
+	{
+		HOST_TEST_CHECK(HostLoop_Frame());
+	}
+	HOST_TEST_CHECK(MockUsbfs_GetInCount(HID_END_POINT) == count);
+	HOST_TEST_CHECK(HidSched_IsIdle());
+	
+	/* New data in the three reports of a frame: one report per endpoint 
+	 * transfer, the keyboard first, then the consumer control, then the mouse
+	 */
+	keyboardReport[KEY_RPT_KEY1_POS] = TEST_KEY_CODE;
+	mouseReport[MOUSE_RPT_X_POS] = TEST_MOUSE_X;
+	consumerReport[CONSUMER_RPT_USAGE_LSB_POS] = LO8(TEST_CONSUMER_USAGE);
+	consumerReport[CONSUMER_RPT_USAGE_MSB_POS] = HI8(TEST_CONSUMER_USAGE);
+	HidSched_Queue();
+	
+	HidSchedTest_Expect(HID_REPORT_ID_KEYBOARD, keyboardReport, KEY_RPT_SIZE);
+	HOST_TEST_CHECK(!HidSched_IsIdle());
+	HidSchedTest_Expect(HID_REPORT_ID_CONSUMER, consumerReport, CONSUMER_RPT_SIZE);
+	HOST_TEST_CHECK(!HidSched_IsIdle());
+	HidSchedTest_Expect(HID_REPORT_ID_MOUSE, (const uint8 *)mouseReport, MOUSE_RPT_SIZE);
+	HidSchedTest_ExpectIdle();
+	
+	/* A key release queued while the mouse report is pending overtakes it */
+	HidSched_Queue();
+	HOST_TEST_CHECK(!HidSched_IsIdle());
+	keyboardReport[KEY_RPT_KEY1_POS] = 0;
+	HidSched_Queue();
+	HidSchedTest_Expect(HID_REPORT_ID_KEYBOARD, keyboardReport, KEY_RPT_SIZE);
+	HidSchedTest_Expect(HID_REPORT_ID_MOUSE, (const uint8 *)mouseReport, MOUSE_RPT_SIZE);
+	HidSchedTest_ExpectIdle();
+	
+	/* The relative mouse movement is sent again while it is not zero, the 
+	 * unchanged consumer control report is not 
+	 */
+	HidSched_Queue();
+	HidSchedTest_Expect(HID_REPORT_ID_MOUSE, (const uint8 *)mouseReport, MOUSE_RPT_SIZE);
+	HidSchedTest_ExpectIdle();
+	
+	/* The end of the movement is sent once */
+	mouseReport[MOUSE_RPT_X_POS] = 0;
+	HidSched_Queue();
+	HidSchedTest_Expect(HID_REPORT_ID_MOUSE, (const uint8 *)mouseReport, MOUSE_RPT_SIZE);
+	HidSchedTest_ExpectIdle();
+	
+	HidSched_Queue();
+	HidSchedTest_ExpectIdle();
+	
+	return HostTest_Result("HidSchedTest");
+}
+
+
+/*******************************************************************************
+* Function Name: HidSchedTest_Expect
+********************************************************************************
+* Summary:
+*  Services the scheduler and checks the packet the host reads on the next 
+*  frame.
+*
+* Parameters:
+*  reportId - expected report ID
+*  report - expected report, after the report ID
+*  size - size of the report
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HidSchedTest_Expect(uint8 reportId, const uint8 report[], uint32 size)
+{
+	const uint8 *data;
+	uint32 count, length, i;
+	
+	count = MockUsbfs_GetInCount(HID_END_POINT);
+	HidSched_Service();
+	MockUsbfs_Frame();
+	HOST_TEST_CHECK(MockUsbfs_GetInCount(HID_END_POINT) == (count + 1u));
+	
+	data = MockUsbfs_GetInData(HID_END_POINT, &length);
+	HOST_TEST_CHECK(length == (HID_REPORT_ID_SIZE + size));
+	HOST_TEST_CHECK(data[0] == reportId);
+	for(i = 0; i < size; i++)
+	{
+		HOST_TEST_CHECK(data[HID_REPORT_ID_SIZE + i] == report[i]);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: HidSchedTest_ExpectIdle
+********************************************************************************
+* Summary:
+*  Checks that no report is pending and that the scheduler loads nothing.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HidSchedTest_ExpectIdle(void)
+{
+	uint32 count = MockUsbfs_GetInCount(HID_END_POINT);
+	
+	HOST_TEST_CHECK(HidSched_IsIdle());
+	HidSched_Service();
+	MockUsbfs_Frame();
+	HOST_TEST_CHECK(MockUsbfs_GetInCount(HID_END_POINT) == count);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,187 @@
+/*******************************************************************************
+* File Name: HostTest.c
+*
+* Version 1.0
+*
+* Description: Checks shared by the host tests. A test records its failures with
+*               HOST_TEST_CHECK() and returns HostTest_Result() from main().
+*               Also searches the UART output and builds trace frames.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "SensorTrace.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Static Variable Declarations
+********************************************************************************/
+
+static uint32 checks;
+static uint32 failures;
+
+
+/*******************************************************************************
+* Function Name: HostTest_Check
+********************************************************************************
+* Summary:
+*  Counts a check and prints it if it failed.
+*
+* Parameters:
+*  isPassed - result of the check
+*  condition - text of the checked condition
+*  file - source file of the check
+*  line - source line of the check
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostTest_Check(int isPassed, const char8 condition[], const char8 file[], uint32 line)
+{
+	checks++;
+	
+	if(!isPassed)
+	{
+		failures++;
+		fprintf(stderr, "%s:%u: check failed: %s\n", file, (unsigned)line, condition);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: HostTest_Result
+********************************************************************************
+* Summary:
+*  Prints the summary of the checks.
+*
+* Parameters:
+*  name - name of the test
+*
+* Return:
+*  int - exit code of the test, EXIT_FAILURE if any check failed
+*
+*******************************************************************************/
+int HostTest_Result(const char8 name[])
+{
+	printf("%s: %u checks, %u failed\n", name, (unsigned)checks, (unsigned)failures);
+	
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/*******************************************************************************
+* Function Name: HostTest_IsInOutput
+********************************************************************************
+* Summary:
+*  Searches the UART output of the mock for a text.
+*
+* Parameters:
+*  text - text to search for
+*
+* Return:
+*  bool - true if the output contains the text
+*
+* Theory:
+*  The output mixes binary telemetry records, which may contain zero bytes, 
+*  with the text lines, so it is searched by length rather than as a string.
+*
+*******************************************************************************/
+bool HostTest_IsInOutput(const char8 text[])
+{
+	uint32 length, i, textLength = (uint32)strlen(text);
+	const char8 *output = MockUart_GetOutput(&length);
+	
+	for(i = 0; (i + textLength) <= length; i++)
+	{
+		if(memcmp(&output[i], text, textLength) == 0)
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+
+/*******************************************************************************
+* Function Name: HostTest_BuildFrame
+********************************************************************************
+* Summary:
+*  Builds a trace frame with at most one touched button.
+*
+* Parameters:
+*  frame - frame to build, TRACE_FRAME_SIZE bytes
+*  sensor - touched button, CapSense_TOTAL_SENSOR_COUNT for none
+*  signal - difference count of the touched button
+*  label - label of the frame
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HostTest_BuildFrame(uint8 frame[], uint32 sensor, uint32 signal, uint32 label)
+{
+	uint32 i;
+	uint8 sum = 0;
+	
+	for(i = 0; i < TRACE_FRAME_SIZE; i++)
+	{
+		frame[i] = 0;
+	}
+	
+	frame[0] = TRACE_SYNC_0;
+	frame[1] = TRACE_SYNC_1;
+	frame[TRACE_CENTROID_POS] = 0xFFu;
+	frame[TRACE_CENTROID_POS + 1] = 0xFFu;
+	frame[TRACE_LABEL_POS] = (uint8)label;
+	
+	if(sensor < CapSense_TOTAL_SENSOR_COUNT)
+	{
+		frame[TRACE_SIGNAL_POS + sensor] = (uint8)signal;
+		frame[TRACE_MASK_POS] = (uint8)(1u << sensor);
+	}
+	
+	for(i = TRACE_TIMESTAMP_POS; i < TRACE_CHECKSUM_POS; i++)
+	{
+		sum += frame[i];
+	}
+	frame[TRACE_CHECKSUM_POS] = sum;
+}
+
+
+/* [] END OF FILE */
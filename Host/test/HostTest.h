@@ -0,0 +1,69 @@
+/*****************************************************************************
+* File Name		: HostTest.h
+* Version		: 1.0 
+*
+* Description:
+*  This file contains the checks and helpers shared by the host tests, refer to
+*  HostTest.c
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_TEST_H		/* Guard to prevent multiple inclusions */
+#define HOST_TEST_H
+
+#include "cytypes.h"
+#include "stdbool.h"
+
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+
+/* Records a failure if the condition is false, the test continues */
+#define HOST_TEST_CHECK(condition)			HostTest_Check((condition), #condition, __FILE__, __LINE__)
+
+
+/*******************************************************************************
+*   Function Prototypes
+*******************************************************************************/
+
+void HostTest_Check(int isPassed, const char8 condition[], const char8 file[], uint32 line);
+int HostTest_Result(const char8 name[]);
+bool HostTest_IsInOutput(const char8 text[]);
+void HostTest_BuildFrame(uint8 frame[], uint32 sensor, uint32 signal, uint32 label);
+
+
+#endif /* #ifndef HOST_TEST_H */
+
+
+/* [] END OF FILE */
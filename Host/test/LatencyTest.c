@@ -0,0 +1,314 @@
+/*******************************************************************************
+* File Name: LatencyTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the latency measurement: the segments of frames driven with a
+*               known scan, poll and ACK timing of the mock hardware land in the expected
+*               histogram buckets.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Latency.h"
+#include "Profile.h"
+#include "stdio.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Main loop iterations per millisecond, and their period in cycles */
+#define TEST_ITERATIONS_PER_MS				(4u)
+#define TEST_ITERATION_CYCLES				(CYDEV_BCLK__SYSCLK__HZ / 1000u / TEST_ITERATIONS_PER_MS)
+#define TEST_MS_CYCLES						(CYDEV_BCLK__SYSCLK__HZ / 1000u)
+
+/* Milliseconds of each run, fewer frames than LATENCY_WINDOW */
+#define TEST_RUN_MS							(200u)
+
+/* Longest line of the dump */
+#define TEST_LINE_SIZE						(128u)
+
+
+/*******************************************************************************
+*	Local Data Type Definitions
+********************************************************************************/
+
+/* Statistics of a segment, as printed by Latency_Dump() */
+typedef struct
+{
+	uint32 count;
+	uint32 min;
+	uint32 max;
+	uint32 mean;
+}tTestStat;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void LatencyTest_Run(uint32 ms, uint32 pollPeriod);
+static void LatencyTest_GetStat(const char8 name[], tTestStat *stat);
+static uint32 LatencyTest_GetBucketCount(const char8 name[], uint32 bucket);
+static uint32 LatencyTest_Bucket(uint32 cycles);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	tTestStat scan, process, queue, usb, total;
+	uint32 frames;
+	
+	HostLoop_Init();
+	
+	/* The device enumerates and the drivers install on the first frames */
+	LatencyTest_Run(20u, 1u);
+	
+	/* The host reads the reports every frame. The frame is processed at the
+	 * start of frame, right after the read of the previous reports, and the
+	 * reports are loaded at once. The scan started by the frame completes at
+	 * the next iteration, and the reports are read at the next start of frame.
+	 */
+	Latency_Clear();
+	LatencyTest_Run(TEST_RUN_MS, 1u);
+	MockUart_ClearOutput();
+	Latency_Dump();
+	
+	LatencyTest_GetStat("latency_scan", &scan);
+	LatencyTest_GetStat("latency_process", &process);
+	LatencyTest_GetStat("latency_queue", &queue);
+	LatencyTest_GetStat("latency_usb", &usb);
+	LatencyTest_GetStat("latency_total", &total);
+	frames = total.count;
+	printf("every frame: %u frames, scan %u, process %u, queue %u, usb %u, total %u cycles\n", (unsigned)frames,
+		(unsigned)scan.max, (unsigned)process.max, (unsigned)queue.max, (unsigned)usb.max, (unsigned)total.max);
+	
+	HOST_TEST_CHECK(frames >= (TEST_RUN_MS - 2u));
+	HOST_TEST_CHECK((scan.count == frames) && (process.count == frames) && (queue.count == frames) && (usb.count == frames));
+	HOST_TEST_CHECK((scan.min == TEST_ITERATION_CYCLES) && (scan.max == TEST_ITERATION_CYCLES));
+	HOST_TEST_CHECK((process.min == (TEST_MS_CYCLES - TEST_ITERATION_CYCLES)) && (process.max == process.min));
+	HOST_TEST_CHECK((queue.min == 0) && (queue.max == 0));
+	HOST_TEST_CHECK((usb.min == TEST_MS_CYCLES) && (usb.max == TEST_MS_CYCLES));
+	HOST_TEST_CHECK((total.min == (2u * TEST_MS_CYCLES)) && (total.max == total.min));
+	
+	/* Every frame is counted in the bucket of its duration */
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_scan", LatencyTest_Bucket(TEST_ITERATION_CYCLES)) == frames);
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_process", LatencyTest_Bucket(TEST_MS_CYCLES - TEST_ITERATION_CYCLES)) == frames);
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_queue", 0u) == frames);
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_usb", LatencyTest_Bucket(TEST_MS_CYCLES)) == frames);
+	
+	/* The host reads the reports every second frame only, a frame is processed
+	 * every second millisecond. The completed scan waits for the reports of 
+	 * the previous frame to be loaded at the read, the reports of the frame
+	 * wait for the next read to be loaded and for the read after it to be 
+	 * acknowledged. The frame processed meanwhile is not measured.
+	 */
+	LatencyTest_Run(20u, 2u);
+	Latency_Clear();
+	LatencyTest_Run(TEST_RUN_MS, 2u);
+	MockUart_ClearOutput();
+	Latency_Dump();
+	
+	LatencyTest_GetStat("latency_scan", &scan);
+	LatencyTest_GetStat("latency_process", &process);
+	LatencyTest_GetStat("latency_queue", &queue);
+	LatencyTest_GetStat("latency_usb", &usb);
+	LatencyTest_GetStat("latency_total", &total);
+	frames = total.count;
+	printf("every second frame: %u frames, scan %u, process %u, queue %u, usb %u, total %u cycles\n", (unsigned)frames,
+		(unsigned)scan.max, (unsigned)process.max, (unsigned)queue.max, (unsigned)usb.max, (unsigned)total.max);
+	
+	HOST_TEST_CHECK(frames >= ((TEST_RUN_MS / 4u) - 1u));
+	HOST_TEST_CHECK((scan.min == TEST_ITERATION_CYCLES) && (scan.max == TEST_ITERATION_CYCLES));
+	HOST_TEST_CHECK((process.min == ((2u * TEST_MS_CYCLES) - TEST_ITERATION_CYCLES)) && (process.max == process.min));
+	HOST_TEST_CHECK((queue.min == ((2u * TEST_MS_CYCLES) - TEST_ITERATION_CYCLES)) && (queue.max == queue.min));
+	HOST_TEST_CHECK((usb.min == (2u * TEST_MS_CYCLES)) && (usb.max == (2u * TEST_MS_CYCLES)));
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_process", LatencyTest_Bucket(process.min)) == frames);
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_queue", LatencyTest_Bucket(queue.min)) == frames);
+	HOST_TEST_CHECK(LatencyTest_GetBucketCount("latency_usb", LatencyTest_Bucket(2u * TEST_MS_CYCLES)) == frames);
+	HOST_TEST_CHECK(total.min == (scan.min + process.min + queue.min + usb.min));
+	
+	return HostTest_Result("LatencyTest");
+}
+
+
+/*******************************************************************************
+* Function Name: LatencyTest_Run
+********************************************************************************
+* Summary:
+*  Runs the main loop TEST_ITERATIONS_PER_MS times per millisecond. The mock 
+*  host sends the start of frame before the first iteration of each 
+*  millisecond.
+*
+* Parameters:
+*  ms - milliseconds to run
+*  pollPeriod - frames between two reads of the reports by the host
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LatencyTest_Run(uint32 ms, uint32 pollPeriod)
+{
+	uint32 iteration;
+	
+	MockUsbfs_SetPollPeriod(pollPeriod);
+	
+	while(ms != 0)
+	{
+		for(iteration = 0; iteration < TEST_ITERATIONS_PER_MS; iteration++)
+		{
+			MockSysTick_Advance(TEST_ITERATION_CYCLES);
+			if(iteration == 0)
+			{
+				MockUsbfs_Frame();
+			}
+			(void)HostLoop_Iterate();
+		}
+		ms--;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LatencyTest_GetStat
+********************************************************************************
+* Summary:
+*  Reads the statistics of a segment from the dump in the UART output.
+*
+* Parameters:
+*  name - name of the segment in the dump
+*  stat - receives the statistics, all 0 if the segment is not in the dump
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LatencyTest_GetStat(const char8 name[], tTestStat *stat)
+{
+	char8 text[TEST_LINE_SIZE];
+	const char8 *line;
+	unsigned count, min, max, mean;
+	
+	memset(stat, 0, sizeof(*stat));
+	
+	(void)snprintf(text, sizeof(text), "profile,%s,", name);
+	line = strstr(MockUart_GetOutput(NULL), text);
+	
+	if((line != NULL) && (sscanf(&line[strlen(text)], "%u,%u,%u,%u", &count, &min, &max, &mean) == 4))
+	{
+		stat->count = count;
+		stat->min = min;
+		stat->max = max;
+		stat->mean = mean;
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LatencyTest_GetBucketCount
+********************************************************************************
+* Summary:
+*  Reads a histogram bucket of a segment from the dump in the UART output.
+*
+* Parameters:
+*  name - name of the segment in the dump
+*  bucket - histogram bucket, refer to PROFILE_BUCKETS
+*
+* Return:
+*  uint32 - count of the bucket, 0 if it is not in the dump
+*
+*******************************************************************************/
+static uint32 LatencyTest_GetBucketCount(const char8 name[], uint32 bucket)
+{
+	char8 text[TEST_LINE_SIZE];
+	uint32 count;
+	
+	for(count = 1; count <= LATENCY_WINDOW; count++)
+	{
+		(void)snprintf(text, sizeof(text), "histogram,%s,%u,%u\n\r", name, (unsigned)bucket, (unsigned)count);
+		if(HostTest_IsInOutput(text))
+		{
+			return count;
+		}
+	}
+	
+	return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: LatencyTest_Bucket
+********************************************************************************
+* Summary:
+*  Returns the histogram bucket of a duration, refer to PROFILE_BUCKETS.
+*
+* Parameters:
+*  cycles - duration
+*
+* Return:
+*  uint32 - bucket
+*
+*******************************************************************************/
+static uint32 LatencyTest_Bucket(uint32 cycles)
+{
+	uint32 bucket = 0;
+	
+	while((cycles >>= 1) != 0)
+	{
+		bucket++;
+	}
+	
+	return bucket;
+}
+
+
+/* [] END OF FILE */
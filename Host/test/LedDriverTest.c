@@ -0,0 +1,198 @@
+/*******************************************************************************
+* File Name: LedDriverTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the synchronized LED driver: the compare values in use and the
+*               write counters.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "LedDriver.h"
+#include "stdio.h"
+
+
+/*******************************************************************************
+*	Local Data Type Definitions
+********************************************************************************/
+
+/* Write counters, as printed by LedDriver_Dump() */
+typedef struct
+{
+	unsigned requested;
+	unsigned done;
+}tTestCounters;
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void LedDriverTest_Write(uint16 red, uint16 green, uint16 blue);
+static void LedDriverTest_Expect(uint32 red, uint32 green, uint32 blue, uint32 requested, uint32 done);
+static void LedDriverTest_GetCounters(tTestCounters *counters);
+
+
+/*******************************************************************************
+*	Local Data
+********************************************************************************/
+
+/* Counters before the checks */
+static tTestCounters start;
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	HostLoop_Init();
+	LedDriver_Init();
+	LedDriverTest_GetCounters(&start);
+	
+	/* The first write after the initialization writes every channel */
+	LedDriverTest_Write(100u, 200u, 300u);
+	LedDriverTest_Expect(100u, 200u, 300u, LED_CHANNELS, LED_CHANNELS);
+	
+	/* An unchanged color writes no register */
+	LedDriverTest_Write(100u, 200u, 300u);
+	LedDriverTest_Expect(100u, 200u, 300u, 2u * LED_CHANNELS, LED_CHANNELS);
+	
+	/* Only the changed channel is written and swapped in, the others keep 
+	 * their compare value rather than the stale content of their buffer
+	 */
+	LedDriverTest_Write(100u, 250u, 300u);
+	LedDriverTest_Expect(100u, 250u, 300u, 3u * LED_CHANNELS, LED_CHANNELS + 1u);
+	
+	LedDriverTest_Write(0, 250u, 0);
+	LedDriverTest_Expect(0, 250u, 0, 4u * LED_CHANNELS, LED_CHANNELS + 3u);
+	
+	/* A channel set back to a value its buffer still holds is written too */
+	LedDriverTest_Write(0, 200u, 0);
+	LedDriverTest_Expect(0, 200u, 0, 5u * LED_CHANNELS, LED_CHANNELS + 4u);
+	
+	return HostTest_Result("LedDriverTest");
+}
+
+
+/*******************************************************************************
+* Function Name: LedDriverTest_Write
+********************************************************************************
+* Summary:
+*  Writes the compare values of the channels.
+*
+* Parameters:
+*  red, green, blue - compare values
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedDriverTest_Write(uint16 red, uint16 green, uint16 blue)
+{
+	uint16 compare[LED_CHANNELS];
+	
+	compare[LED_RED] = red;
+	compare[LED_GREEN] = green;
+	compare[LED_BLUE] = blue;
+	
+	LedDriver_Write(compare);
+}
+
+
+/*******************************************************************************
+* Function Name: LedDriverTest_Expect
+********************************************************************************
+* Summary:
+*  Checks the compare values in use by the PWMs and the write counters.
+*
+* Parameters:
+*  red, green, blue - expected compare values
+*  requested - expected channel writes requested since the start of the test
+*  done - expected compare registers written since the start of the test
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedDriverTest_Expect(uint32 red, uint32 green, uint32 blue, uint32 requested, uint32 done)
+{
+	tTestCounters counters;
+	
+	HOST_TEST_CHECK(MockPwm_GetCompare(MOCK_PWM_RED) == red);
+	HOST_TEST_CHECK(MockPwm_GetCompare(MOCK_PWM_GREEN) == green);
+	HOST_TEST_CHECK(MockPwm_GetCompare(MOCK_PWM_BLUE) == blue);
+	
+	LedDriverTest_GetCounters(&counters);
+	HOST_TEST_CHECK((counters.requested - start.requested) == requested);
+	HOST_TEST_CHECK((counters.done - start.done) == done);
+}
+
+
+/*******************************************************************************
+* Function Name: LedDriverTest_GetCounters
+********************************************************************************
+* Summary:
+*  Reads the write counters from LedDriver_Dump().
+*
+* Parameters:
+*  counters - receives the counters
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedDriverTest_GetCounters(tTestCounters *counters)
+{
+	MockUart_ClearOutput();
+	LedDriver_Dump();
+	
+	HOST_TEST_CHECK(sscanf(MockUart_GetOutput(NULL), "leddriver,%u,%u", &counters->requested, &counters->done) == 2);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,193 @@
+/*******************************************************************************
+* File Name: LedHueTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the hue mode of the LED: the hue dialed on the outer ring and
+*               its wrap around the color wheel.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "Centroid.h"
+#include "LedControl.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* One turn of the finger on the outer ring, in thetaFine counts */
+#define TEST_TURN							((int32)(SLIDER_RESOLUTION << CENTROID_FRAC_BITS))
+
+/* Frames of a turn, the rotation of a frame is less than a turn */
+#define TEST_TURN_FRAMES					(16)
+
+/* Radius of a finger on the outer ring */
+#define TEST_RING_RADIUS					(4u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void LedHueTest_Turn(int32 rotation);
+static void LedHueTest_Expect(uint32 red, uint32 green, uint32 blue);
+
+
+/*******************************************************************************
+*	Local Data
+********************************************************************************/
+
+/* PWM compare value of a full channel at BRIGHT_LEVEL_MAX */
+static uint32 fullCompare;
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint16 compare[LED_CHANNELS];
+	uint32 turn;
+	
+	HostLoop_Init();
+	
+	LedControl_GetCompare(COLOR_HUE, BRIGHT_LEVEL_MAX, compare);
+	fullCompare = compare[LED_RED];
+	HOST_TEST_CHECK(fullCompare != 0);
+	
+	/* Red at hue 0 */
+	LedHueTest_Expect(LED_RATIO_FULL, 0, 0);
+	
+	/* The finger touches the ring with the LED on */
+	SetLedColor(COLOR_RED, BRIGHT_LEVEL_MAX);
+	capsenseButtonStatus = 0;
+	radius = TEST_RING_RADIUS;
+	accThetaFine = 0;
+	UpdateLedColor(GESTURE_NONE);
+	
+	/* A sixth of a turn: yellow */
+	LedHueTest_Turn(TEST_TURN / 6);
+	LedHueTest_Expect(LED_RATIO_FULL, LED_RATIO_FULL, 0);
+	
+	/* A quarter of a turn back, below hue 0: half way from magenta to red */
+	LedHueTest_Turn(-(TEST_TURN / 4));
+	LedHueTest_Expect(LED_RATIO_FULL, 0, LED_RATIO_FULL / 2u);
+	
+	/* Whole turns either way wrap back to the same hue */
+	for(turn = 0; turn < 3u; turn++)
+	{
+		LedHueTest_Turn(TEST_TURN);
+		LedHueTest_Expect(LED_RATIO_FULL, 0, LED_RATIO_FULL / 2u);
+	}
+	for(turn = 0; turn < 3u; turn++)
+	{
+		LedHueTest_Turn(-TEST_TURN);
+		LedHueTest_Expect(LED_RATIO_FULL, 0, LED_RATIO_FULL / 2u);
+	}
+	
+	/* The finger off the ring does not turn the hue */
+	radius = INVALID_RADIUS;
+	LedHueTest_Turn(TEST_TURN / 2);
+	LedHueTest_Expect(LED_RATIO_FULL, 0, LED_RATIO_FULL / 2u);
+	
+	return HostTest_Result("LedHueTest");
+}
+
+
+/*******************************************************************************
+* Function Name: LedHueTest_Turn
+********************************************************************************
+* Summary:
+*  Turns the finger in TEST_TURN_FRAMES frames.
+*
+* Parameters:
+*  rotation - rotation in thetaFine counts, positive clockwise
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedHueTest_Turn(int32 rotation)
+{
+	int32 frame, start = accThetaFine;
+	
+	for(frame = 1; frame <= TEST_TURN_FRAMES; frame++)
+	{
+		accThetaFine = start + ((rotation * frame) / TEST_TURN_FRAMES);
+		UpdateLedColor(GESTURE_NONE);
+	}
+}
+
+
+/*******************************************************************************
+* Function Name: LedHueTest_Expect
+********************************************************************************
+* Summary:
+*  Checks the PWM compare values of the dialed hue.
+*
+* Parameters:
+*  red, green, blue - expected duty ratios, LED_RATIO_FULL for a full channel
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedHueTest_Expect(uint32 red, uint32 green, uint32 blue)
+{
+	uint16 compare[LED_CHANNELS];
+	
+	LedControl_GetCompare(COLOR_HUE, BRIGHT_LEVEL_MAX, compare);
+	
+	HOST_TEST_CHECK(compare[LED_RED] == ((fullCompare * red) >> LED_RATIO_SHIFT));
+	HOST_TEST_CHECK(compare[LED_GREEN] == ((fullCompare * green) >> LED_RATIO_SHIFT));
+	HOST_TEST_CHECK(compare[LED_BLUE] == ((fullCompare * blue) >> LED_RATIO_SHIFT));
+}
+
+
+/* [] END OF FILE */
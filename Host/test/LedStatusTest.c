@@ -0,0 +1,147 @@
+/*******************************************************************************
+* File Name: LedStatusTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the status overlays: reports the host stops reading raise
+*               the report stall code, which clears once the reports flow again and
+*               its hold time elapsed.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "LedStatus.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Main loop iterations per ms, and their duration in system clock cycles */
+#define TEST_ITERATIONS_PER_MS			(4u)
+#define TEST_ITERATION_CYCLES			(CYDEV_BCLK__SYSCLK__HZ / 1000u / TEST_ITERATIONS_PER_MS)
+
+/* Poll period of a host that stopped reading the reports, longer than the 
+ * whole test
+ */
+#define TEST_STALLED_POLL_PERIOD		(100000u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void LedStatusTest_Run(uint32 ms, uint32 pollPeriod);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	HostLoop_Init();
+	
+	/* The host reads the reports every frame, nothing is shown */
+	LedStatusTest_Run(200u, 1u);
+	HOST_TEST_CHECK(LedStatus_GetStatus() == LED_STATUS_NONE);
+	
+	/* The host stops reading the reports, the start of frame goes on. The 
+	 * queued reports are stalled once they waited LED_STATUS_REPORT_TIMEOUT_MS
+	 */
+	LedStatusTest_Run(LED_STATUS_REPORT_TIMEOUT_MS / 2u, TEST_STALLED_POLL_PERIOD);
+	HOST_TEST_CHECK(LedStatus_GetStatus() == LED_STATUS_NONE);
+	
+	LedStatusTest_Run(LED_STATUS_REPORT_TIMEOUT_MS, TEST_STALLED_POLL_PERIOD);
+	HOST_TEST_CHECK(LedStatus_GetStatus() == LED_STATUS_REPORT_STALL);
+	
+	/* The host reads the reports again, the code stays for its hold time */
+	LedStatusTest_Run(LED_STATUS_HOLD_MS - 100u, 1u);
+	HOST_TEST_CHECK(LedStatus_GetStatus() == LED_STATUS_REPORT_STALL);
+	
+	LedStatusTest_Run(200u, 1u);
+	HOST_TEST_CHECK(LedStatus_GetStatus() == LED_STATUS_NONE);
+	
+	return HostTest_Result("LedStatusTest");
+}
+
+
+/*******************************************************************************
+* Function Name: LedStatusTest_Run
+********************************************************************************
+* Summary:
+*  Runs the main loop, with a start of frame every ms.
+*
+* Parameters:
+*  ms - run time
+*  pollPeriod - frames between two reads of the reports by the host
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LedStatusTest_Run(uint32 ms, uint32 pollPeriod)
+{
+	uint32 iteration;
+	
+	MockUsbfs_SetPollPeriod(pollPeriod);
+	
+	while(ms != 0)
+	{
+		for(iteration = 0; iteration < TEST_ITERATIONS_PER_MS; iteration++)
+		{
+			MockSysTick_Advance(TEST_ITERATION_CYCLES);
+			if(iteration == 0)
+			{
+				MockUsbfs_Frame();
+			}
+			(void)HostLoop_Iterate();
+		}
+		ms--;
+	}
+}
+
+
+/* [] END OF FILE */
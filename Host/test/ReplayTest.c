@@ -0,0 +1,155 @@
+/*******************************************************************************
+* File Name: ReplayTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the trace replay: frames are only processed once their trace
+*               frame has arrived, damaged frames are dropped and a replayed tap is
+*               reported to the host.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "HidReport.h"
+#include "SensorTrace.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Signal of a finger on a button */
+#define TEST_FINGER_SIGNAL					(240u)
+
+/* Frames of the enumeration, of a button press and of the release after it */
+#define TEST_ENUM_FRAMES					(20u)
+#define TEST_PRESS_FRAMES					(10u)
+#define TEST_RELEASE_FRAMES					(20u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static bool ReplayTest_Send(uint32 sensor);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint8 frame[TRACE_FRAME_SIZE];
+	uint32 i, length, scans;
+	uint8 buttons = 0;
+	
+	HostLoop_Init();
+	
+	/* No frame is processed without a trace frame, and the loop keeps running */
+	scans = MockCapSense_GetScans();
+	HOST_TEST_CHECK(!HostLoop_Frame());
+	HOST_TEST_CHECK(MockCapSense_GetScans() == scans);
+	
+	/* Nor with a partial frame */
+	HostTest_BuildFrame(frame, CapSense_TOTAL_SENSOR_COUNT, 0, TRACE_LABEL_NONE);
+	(void)MockUart_Receive(frame, TRACE_FRAME_SIZE / 2u);
+	HOST_TEST_CHECK(!HostLoop_Frame());
+	(void)MockUart_Receive(&frame[TRACE_FRAME_SIZE / 2u], TRACE_FRAME_SIZE - (TRACE_FRAME_SIZE / 2u));
+	HOST_TEST_CHECK(HostLoop_Frame());
+	
+	/* Noise and a frame with a wrong checksum are dropped */
+	frame[0] = 0x00u;
+	frame[1] = TRACE_SYNC_0;
+	(void)MockUart_Receive(frame, 2u);
+	HostTest_BuildFrame(frame, CapSense_TOTAL_SENSOR_COUNT, 0, TRACE_LABEL_NONE);
+	frame[TRACE_CHECKSUM_POS]++;
+	(void)MockUart_Receive(frame, TRACE_FRAME_SIZE);
+	HOST_TEST_CHECK(!HostLoop_Frame());
+	
+	for(i = 0; i < TEST_ENUM_FRAMES; i++)
+	{
+		HOST_TEST_CHECK(ReplayTest_Send(CapSense_TOTAL_SENSOR_COUNT));
+	}
+	HOST_TEST_CHECK(MockUsbfs_GetInCount(MOUSE_END_POINT) != 0);
+	
+	/* A replayed tap on the left button is a left click */
+	for(i = 0; i < (TEST_PRESS_FRAMES + TEST_RELEASE_FRAMES); i++)
+	{
+		HOST_TEST_CHECK(ReplayTest_Send((i < TEST_PRESS_FRAMES) ? LEFT_BTN_ID : CapSense_TOTAL_SENSOR_COUNT));
+		buttons |= MockUsbfs_GetInData(MOUSE_END_POINT, &length)[MOUSE_RPT_BTN_POS];
+	}
+	HOST_TEST_CHECK(buttons == MOUSE_RPT_LEFT_BTN_MASK);
+	
+	return HostTest_Result("ReplayTest");
+}
+
+
+/*******************************************************************************
+* Function Name: ReplayTest_Send
+********************************************************************************
+* Summary:
+*  Sends a trace frame with a finger on one button and processes it.
+*
+* Parameters:
+*  sensor - touched button, CapSense_TOTAL_SENSOR_COUNT for none
+*
+* Return:
+*  bool - true if the frame was processed
+*
+*******************************************************************************/
+static bool ReplayTest_Send(uint32 sensor)
+{
+	uint8 frame[TRACE_FRAME_SIZE];
+	
+	HostTest_BuildFrame(frame, sensor, TEST_FINGER_SIGNAL, TRACE_LABEL_NONE);
+	HOST_TEST_CHECK(MockUart_Receive(frame, TRACE_FRAME_SIZE) == TRACE_FRAME_SIZE);
+	
+	return HostLoop_Frame();
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,168 @@
+/*******************************************************************************
+* File Name: SensorFilterTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the sensor filter: the step response and the spike rejection
+*               of the button (IIR) and slider (median and IIR) filters.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "Gesture.h"
+#include "SensorFilter.h"
+#include "string.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Input step of the checks */
+#define TEST_STEP_SIGNAL					(250u)
+
+/* Slider segment of the checks */
+#define TEST_SLIDER_SENSOR					(SLIDER_ID + 2u)
+
+
+/*******************************************************************************
+*	Local Data
+********************************************************************************/
+
+/* Response of the IIR filter (SENSOR_FILTER_IIR_SHIFT of 1, rounded) to a 
+ * step from 0 to TEST_STEP_SIGNAL 
+ */
+static const uint8 iirStepResponse[] = {125u, 188u, 219u, 234u, 242u, 246u, 248u, 249u, 250u};
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void SensorFilterTest_Process(uint32 button, uint32 slider);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 frame;
+	
+	HostLoop_Init();
+	SensorFilter_Init();
+	
+	/* Step: the buttons follow through the IIR from the first frame, the 
+	 * slider segments one frame later through the median 
+	 */
+	SensorFilterTest_Process(TEST_STEP_SIGNAL, TEST_STEP_SIGNAL);
+	HOST_TEST_CHECK(CapSense_sensorSignal[LEFT_BTN_ID] == iirStepResponse[0]);
+	HOST_TEST_CHECK(CapSense_sensorSignal[TEST_SLIDER_SENSOR] == 0);
+	
+	for(frame = 1; frame < sizeof(iirStepResponse); frame++)
+	{
+		SensorFilterTest_Process(TEST_STEP_SIGNAL, TEST_STEP_SIGNAL);
+		HOST_TEST_CHECK(CapSense_sensorSignal[LEFT_BTN_ID] == iirStepResponse[frame]);
+		HOST_TEST_CHECK(CapSense_sensorSignal[TEST_SLIDER_SENSOR] == iirStepResponse[frame - 1u]);
+	}
+	
+	/* The other sensors are not affected */
+	HOST_TEST_CHECK(CapSense_sensorSignal[RIGHT_BTN_ID] == 0);
+	HOST_TEST_CHECK(CapSense_sensorSignal[SLIDER_ID] == 0);
+	
+	/* The button is reported 2 frames late against the default finger 
+	 * threshold plus hysteresis, as documented for SENSOR_FILTER_ENABLE 
+	 */
+	HOST_TEST_CHECK(iirStepResponse[1] < (CapSense_fingerThreshold[CapSense_LEFT__BTN] + CapSense_hysteresis[CapSense_LEFT__BTN]));
+	HOST_TEST_CHECK(iirStepResponse[2] >= (CapSense_fingerThreshold[CapSense_LEFT__BTN] + CapSense_hysteresis[CapSense_LEFT__BTN]));
+	
+	/* Settle at 0, then a single scan spike: the median removes it from the
+	 * slider, the IIR halves it on the button 
+	 */
+	for(frame = 0; frame < (2u * sizeof(iirStepResponse)); frame++)
+	{
+		SensorFilterTest_Process(0, 0);
+	}
+	HOST_TEST_CHECK(CapSense_sensorSignal[LEFT_BTN_ID] == 0);
+	HOST_TEST_CHECK(CapSense_sensorSignal[TEST_SLIDER_SENSOR] == 0);
+	
+	SensorFilterTest_Process(TEST_STEP_SIGNAL, TEST_STEP_SIGNAL);
+	HOST_TEST_CHECK(CapSense_sensorSignal[LEFT_BTN_ID] == iirStepResponse[0]);
+	HOST_TEST_CHECK(CapSense_sensorSignal[TEST_SLIDER_SENSOR] == 0);
+	
+	SensorFilterTest_Process(0, 0);
+	HOST_TEST_CHECK(CapSense_sensorSignal[LEFT_BTN_ID] == ((iirStepResponse[0] + 1u) / 2u));
+	HOST_TEST_CHECK(CapSense_sensorSignal[TEST_SLIDER_SENSOR] == 0);
+	
+	return HostTest_Result("SensorFilterTest");
+}
+
+
+/*******************************************************************************
+* Function Name: SensorFilterTest_Process
+********************************************************************************
+* Summary:
+*  Filters a scan with a signal on the left button and on a slider segment.
+*
+* Parameters:
+*  button - signal of the left button
+*  slider - signal of TEST_SLIDER_SENSOR
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void SensorFilterTest_Process(uint32 button, uint32 slider)
+{
+	memset(CapSense_sensorSignal, 0, sizeof(CapSense_sensorSignal));
+	CapSense_sensorSignal[LEFT_BTN_ID] = (uint8)button;
+	CapSense_sensorSignal[TEST_SLIDER_SENSOR] = (uint8)slider;
+	
+	SensorFilter_Process();
+}
+
+
+/* [] END OF FILE */
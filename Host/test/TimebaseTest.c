@@ -0,0 +1,139 @@
+/*******************************************************************************
+* File Name: TimebaseTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the time base: the cycle count stays monotonic across the
+*               SysTick reloads, also while the interrupts are disabled.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "Timebase.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Step between two reads, not a divisor of the SysTick period so that the 
+ * reads fall on every phase of it, and the number of reads.
+ */
+#define TEST_STEP_CYCLES					(997u)
+#define TEST_STEPS							(1000u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void TimebaseTest_Monotonic(bool isInterruptEnabled);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 start;
+	
+	Mock_Reset();
+	Timebase_Init();
+	
+	start = Timebase_GetCycles();
+	MockSysTick_AdvanceMs(3u);
+	HOST_TEST_CHECK(Timebase_GetMs() == 3u);
+	HOST_TEST_CHECK((Timebase_GetCycles() - start) == (3u * (MOCK_SYSTICK_RELOAD + 1u)));
+	
+	TimebaseTest_Monotonic(true);
+	TimebaseTest_Monotonic(false);
+	
+	return HostTest_Result("TimebaseTest");
+}
+
+
+/*******************************************************************************
+* Function Name: TimebaseTest_Monotonic
+********************************************************************************
+* Summary:
+*  Checks that the cycle count advances by the elapsed cycles on every read.
+*  With the interrupts disabled, they are enabled again after each read that
+*  follows a reload, as a critical section shorter than a period would.
+*
+* Parameters:
+*  isInterruptEnabled - false to read with the interrupts disabled
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void TimebaseTest_Monotonic(bool isInterruptEnabled)
+{
+	uint32 step, previous, cycles;
+	
+	MockSysTick_SetInterruptsEnabled(isInterruptEnabled);
+	previous = Timebase_GetCycles();
+	
+	for(step = 0; step < TEST_STEPS; step++)
+	{
+		MockSysTick_Advance(TEST_STEP_CYCLES);
+		
+		cycles = Timebase_GetCycles();
+		HOST_TEST_CHECK((cycles - previous) == TEST_STEP_CYCLES);
+		previous = cycles;
+		
+		if(!isInterruptEnabled)
+		{
+			/* The pending interrupt runs, the count must not move */
+			MockSysTick_SetInterruptsEnabled(true);
+			HOST_TEST_CHECK(Timebase_GetCycles() == previous);
+			MockSysTick_SetInterruptsEnabled(false);
+		}
+	}
+	
+	MockSysTick_SetInterruptsEnabled(true);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,162 @@
+/*******************************************************************************
+* File Name: UsbSofTest.c
+*
+* Version 1.0
+*
+* Description: Host test of the start of frame alignment: a frame is processed every
+*               start of frame, every USB_SOF_TIMEOUT_MS once the frame number stalls,
+*               and the endpoint descriptors are checked against HID_POLL_INTERVAL_MS.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostTest.h"
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "main.h"
+#include "UsbSof.h"
+
+
+/*******************************************************************************
+*	Local Macro Definitions
+********************************************************************************/
+
+/* Main loop iterations per ms, and their duration in system clock cycles */
+#define TEST_ITERATIONS_PER_MS			(4u)
+#define TEST_ITERATION_CYCLES			(CYDEV_BCLK__SYSCLK__HZ / 1000u / TEST_ITERATIONS_PER_MS)
+
+/* Duration of each phase, a multiple of USB_SOF_TIMEOUT_MS */
+#define TEST_RUN_MS						(30u)
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static uint32 UsbSofTest_Run(uint32 ms);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int - EXIT_SUCCESS if all the checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+	uint32 frames;
+	
+	HostLoop_Init();
+	
+	/* The device enumerates and the drivers install on the first frames */
+	(void)UsbSofTest_Run(20u);
+	
+	/* A frame is processed right after each start of frame */
+	frames = UsbSofTest_Run(TEST_RUN_MS);
+	printf("start of frame: %u frames in %u ms\n", (unsigned)frames, (unsigned)TEST_RUN_MS);
+	HOST_TEST_CHECK(frames == TEST_RUN_MS);
+	
+	/* The frame number stalls while the host still reads the reports. The 
+	 * frames go on every USB_SOF_TIMEOUT_MS.
+	 */
+	MockUsbfs_SetSofStall(true);
+	frames = UsbSofTest_Run(TEST_RUN_MS);
+	printf("stalled frame number: %u frames in %u ms\n", (unsigned)frames, (unsigned)TEST_RUN_MS);
+	HOST_TEST_CHECK(frames == (TEST_RUN_MS / USB_SOF_TIMEOUT_MS));
+	
+	/* The frames follow the start of frame again once it resumes */
+	MockUsbfs_SetSofStall(false);
+	(void)UsbSofTest_Run(USB_SOF_TIMEOUT_MS);
+	frames = UsbSofTest_Run(TEST_RUN_MS);
+	HOST_TEST_CHECK(frames == TEST_RUN_MS);
+	
+	/* The endpoint descriptors ask for HID_POLL_INTERVAL_MS, a different 
+	 * bInterval is reported
+	 */
+	HOST_TEST_CHECK(UsbSof_CheckInterval());
+	MockUsbfs_SetInterval(HID_POLL_INTERVAL_MS + 1u);
+	HOST_TEST_CHECK(!UsbSof_CheckInterval());
+	MockUsbfs_SetInterval(HID_POLL_INTERVAL_MS);
+	HOST_TEST_CHECK(UsbSof_CheckInterval());
+	
+	return HostTest_Result("UsbSofTest");
+}
+
+
+/*******************************************************************************
+* Function Name: UsbSofTest_Run
+********************************************************************************
+* Summary:
+*  Runs the main loop, with a USB frame every ms in which the host reads the 
+*  reports.
+*
+* Parameters:
+*  ms - run time
+*
+* Return:
+*  uint32 - number of frames processed
+*
+*******************************************************************************/
+static uint32 UsbSofTest_Run(uint32 ms)
+{
+	uint32 iteration;
+	uint32 frames = 0;
+	
+	while(ms != 0)
+	{
+		for(iteration = 0; iteration < TEST_ITERATIONS_PER_MS; iteration++)
+		{
+			MockSysTick_Advance(TEST_ITERATION_CYCLES);
+			if(iteration == 0)
+			{
+				MockUsbfs_Frame();
+			}
+			if(HostLoop_Iterate())
+			{
+				frames++;
+			}
+		}
+		ms--;
+	}
+	
+	return frames;
+}
+
+
+/* [] END OF FILE */
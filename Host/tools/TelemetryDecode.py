@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Host telemetry decoder.
+
+Renders the UART output of the firmware as text: the binary telemetry records
+of Telemetry.c, one line each, and the text lines sent between them (benchmark
+results, report digest) as they are. The record format, the event ids and the
+enums of the payloads are read from the firmware headers, so that the decoder
+follows them.
+
+    TelemetryDecode.py [--check] [--headers DIR] [FILE]
+
+FILE is the captured UART output, stdin without it. With --check, nothing is
+printed, and the exit status is 1 if no record was decoded, a record was
+corrupted or records were lost (sequence gap or TELEMETRY_EVENT_DROPPED).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+DEFAULT_HEADERS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "..", "CY8CKIT_046_USB_Mouse.cydsn")
+
+
+def read_header(headers, name):
+    with open(os.path.join(headers, name), encoding="utf-8", errors="replace") as f:
+        # Drop the comments, the enums carry them after each entry
+        return re.sub(r"/\*.*?\*/", "", f.read(), flags=re.S)
+
+
+def parse_defines(text, prefix):
+    """Returns {name without prefix: value} of the '#define <prefix>x (n)' lines."""
+    defines = {}
+    for name, value in re.findall(r"#define\s+" + prefix + r"(\w+)\s+\(?\s*(0x[0-9A-Fa-f]+|\d+)u?\s*\)?", text):
+        defines[name] = int(value, 0)
+    return defines
+
+
+def parse_enum(text, type_name):
+    """Returns {value: name} of a 'typedef enum {...} type_name;'. Of the names
+    sharing a value, the last one is kept (e.g. LED_STATUS_NONE)."""
+    match = re.search(r"typedef\s+enum\s*\{([^}]*)\}\s*" + type_name + r"\s*;", text)
+    names = {}
+    if match is None:
+        return names
+    values = {}
+    value = -1
+    for entry in match.group(1).split(","):
+        entry = entry.strip()
+        if not entry:
+            continue
+        if "=" in entry:
+            name, expression = (part.strip() for part in entry.split("=", 1))
+            value = values[expression] if expression in values else int(expression, 0)
+        else:
+            name = entry
+            value += 1
+        values[name] = value
+        names[value] = name
+    return names
+
+
+class Format:
+    """Record format and payload names, from the firmware headers."""
+
+    def __init__(self, headers):
+        telemetry = read_header(headers, "Telemetry.h")
+        self.sync = parse_defines(telemetry, "TELEMETRY_")["SYNC"]
+        self.size = parse_defines(telemetry, "TELEMETRY_")["RECORD_SIZE"]
+        self.events = {value: name for name, value in parse_defines(telemetry, "TELEMETRY_EVENT_").items()}
+        self.ids = {name: value for value, name in self.events.items()}
+        self.gestures = parse_enum(read_header(headers, "Gesture.h"), "tGestureId")
+        self.colors = parse_enum(read_header(headers, "LedControl.h"), "tLedColor")
+        self.statuses = parse_enum(read_header(headers, "LedStatus.h"), "tLedStatus")
+
+    def payload(self, event, payload):
+        """Renders the payload of an event, refer to Telemetry.h."""
+        name = self.events.get(event)
+        if name in ("APP_START", "USB_DISCONNECTED", "DRIVERS_INSTALLED", "TOUCH_UP"):
+            return ""
+        if name == "DROPPED":
+            return "records=%d" % payload
+        if name == "GESTURE":
+            return self.gestures.get(payload, str(payload))
+        if name == "TOUCH_DOWN":
+            return "sector=%d radius=%d" % (payload & 0xFF, payload >> 8)
+        if name == "SECTOR":
+            return "sector=%d" % payload
+        if name == "LED_COLOR":
+            return self.colors.get(payload, str(payload))
+        if name == "THRESHOLD":
+            return "widget=%d finger=%d" % (payload & 0xFF, payload >> 8)
+        if name == "LED_STATUS":
+            return self.statuses.get(payload, str(payload))
+        if name == "POLL_INTERVAL":
+            return "endpoint=0x%02X interval=%d" % (payload & 0xFF, payload >> 8)
+        return "0x%04X" % payload
+
+
+class Decoder:
+    """Splits the UART stream into records and text lines."""
+
+    def __init__(self, fmt, out):
+        self.fmt = fmt
+        self.out = out
+        self.records = 0
+        self.corrupted = 0
+        self.lost = 0
+        self.sequence = None
+
+    def record(self, data):
+        event, timestamp, payload, sequence = data[1], data[2] | (data[3] << 8), data[4] | (data[5] << 8), data[6]
+        if self.sequence is not None and sequence != ((self.sequence + 1) & 0xFF):
+            gap = (sequence - self.sequence - 1) & 0xFF
+            self.lost += gap
+            self.emit("# sequence gap, %d records lost" % gap)
+        self.sequence = sequence
+        if event == self.fmt.ids.get("DROPPED"):
+            self.lost += payload
+        self.records += 1
+        text = self.fmt.payload(event, payload)
+        self.emit("%7d ms  %-18s %s" % (timestamp, self.fmt.events.get(event, "EVENT_%d" % event), text))
+
+    def emit(self, line):
+        if self.out is not None:
+            self.out.write(line.rstrip() + "\n")
+
+    def decode(self, data):
+        size = self.fmt.size
+        text = bytearray()
+        i = 0
+        while i < len(data):
+            if data[i] == self.fmt.sync and i + size <= len(data):
+                if (sum(data[i + 1:i + size - 1]) & 0xFF) == data[i + size - 1]:
+                    if text:
+                        self.emit(text.decode("ascii", "replace"))
+                        text.clear()
+                    self.record(data[i:i + size])
+                    i += size
+                    continue
+                self.corrupted += 1
+            if data[i] == ord("\n"):
+                self.emit(text.decode("ascii", "replace"))
+                text.clear()
+            elif data[i] != ord("\r"):
+                text.append(data[i])
+            i += 1
+        if text:
+            self.emit(text.decode("ascii", "replace"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Renders the telemetry records of the UART output as text.")
+    parser.add_argument("file", nargs="?", help="captured UART output, stdin without it")
+    parser.add_argument("--check", action="store_true", help="only check that all the records were received intact")
+    parser.add_argument("--headers", default=DEFAULT_HEADERS, help="directory of Telemetry.h")
+    args = parser.parse_args()
+
+    if args.file is None:
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.file, "rb") as f:
+            data = f.read()
+
+    decoder = Decoder(Format(args.headers), None if args.check else sys.stdout)
+    try:
+        decoder.decode(data)
+    except BrokenPipeError:
+        # The reader (e.g. head) stopped, drop the rest of the output
+        os.dup2(os.open(os.devnull, os.O_WRONLY), sys.stdout.fileno())
+        return 0
+
+    summary = "records %d, corrupted %d, lost %d" % (decoder.records, decoder.corrupted, decoder.lost)
+    print(summary, file=sys.stderr)
+
+    if args.check and (decoder.records == 0 or decoder.corrupted != 0 or decoder.lost != 0):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
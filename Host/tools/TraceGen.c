@@ -0,0 +1,191 @@
+/*******************************************************************************
+* File Name: TraceGen.c
+*
+* Version 1.0
+*
+* Description: Host trace generator: writes sensor frames synthesized by TouchSynth, as the
+*               firmware built with SENSOR_TRACE_SYNTH generates them, to a trace file that
+*               the trace player or the device in SENSOR_TRACE_REPLAY mode can replay.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostMock.h"
+#include "TouchSynth.h"
+#include "GestureStats.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static void TraceGen_Seal(uint8 frame[]);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Writes a synthesized trace file, and the generation rate to stderr.
+*
+*  Usage: TraceGen <trace file> [frames]
+*   frames - minimum number of frames. Without it, the trace ends with the
+*            dump of the first run of TOUCH_SYNTH_RUN_TOUCHES touches.
+*
+* Parameters:
+*  argc, argv - command line
+*
+* Return:
+*  int - EXIT_SUCCESS if the trace was written
+*
+* Theory:
+*  The frames are the ones the firmware synthesizes in SENSOR_TRACE_SYNTH 
+*  mode, from TOUCH_SYNTH_SEED, plus the sync and checksum bytes of the trace
+*  format. When the minimum number of frames is reached, generation continues
+*  to the next frame without touch, which is labeled GESTURE_STATS_LABEL_DUMP,
+*  so that a replay of the trace always ends with the benchmark results.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+	uint8 frame[TRACE_FRAME_SIZE];
+	uint32 frames = 0, minFrames = 0;
+	FILE *file;
+	clock_t start;
+	double hostMs;
+	bool done = false;
+	char *end;
+	
+	if((argc < 2) || (argc > 3))
+	{
+		fprintf(stderr, "usage: %s <trace file> [frames]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	if(argc == 3)
+	{
+		minFrames = (uint32)strtoul(argv[2], &end, 0);
+		if((*end != '\0') || (minFrames == 0))
+		{
+			fprintf(stderr, "%s: invalid number of frames %s\n", argv[0], argv[2]);
+			return EXIT_FAILURE;
+		}
+	}
+	
+	file = fopen(argv[1], "wb");
+	if(file == NULL)
+	{
+		fprintf(stderr, "%s: cannot write %s\n", argv[0], argv[1]);
+		return EXIT_FAILURE;
+	}
+	
+	/* The sensor on mask follows the thresholds of the CapSense configuration */
+	Mock_Reset();
+	
+	start = clock();
+	
+	while(!done)
+	{
+		TouchSynth_Generate(frame);
+		frames++;
+		
+		if(frame[TRACE_LABEL_POS] == GESTURE_STATS_LABEL_DUMP)
+		{
+			done = true;
+		}
+		else if((minFrames != 0) && (frames >= minFrames) && 
+				(frame[TRACE_MASK_POS] == 0) && (frame[TRACE_LABEL_POS] == TRACE_LABEL_NONE))
+		{
+			frame[TRACE_LABEL_POS] = GESTURE_STATS_LABEL_DUMP;
+			done = true;
+		}
+		
+		TraceGen_Seal(frame);
+		
+		if(fwrite(frame, 1u, TRACE_FRAME_SIZE, file) != TRACE_FRAME_SIZE)
+		{
+			fprintf(stderr, "%s: cannot write %s\n", argv[0], argv[1]);
+			(void)fclose(file);
+			return EXIT_FAILURE;
+		}
+	}
+	
+	hostMs = ((double)(clock() - start) * 1000.0) / CLOCKS_PER_SEC;
+	
+	if(fclose(file) != 0)
+	{
+		fprintf(stderr, "%s: cannot write %s\n", argv[0], argv[1]);
+		return EXIT_FAILURE;
+	}
+	
+	fprintf(stderr, "frames %u, trace time %u ms, host time %.1f ms, %.0f frames/s\n",
+		(unsigned)frames, (unsigned)(frames * TOUCH_SYNTH_FRAME_MS), hostMs, 
+		(hostMs > 0.0) ? ((frames * 1000.0) / hostMs) : 0.0);
+	
+	return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: TraceGen_Seal
+********************************************************************************
+* Summary:
+*  Writes the sync and checksum bytes of a frame, which TouchSynth_Generate()
+*  leaves to the caller.
+*
+* Parameters:
+*  frame - trace frame, TRACE_FRAME_SIZE bytes
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void TraceGen_Seal(uint8 frame[])
+{
+	uint32 i;
+	uint8 sum = 0;
+	
+	frame[0] = TRACE_SYNC_0;
+	frame[1] = TRACE_SYNC_1;
+	
+	for(i = TRACE_TIMESTAMP_POS; i < TRACE_CHECKSUM_POS; i++)
+	{
+		sum += frame[i];
+	}
+	frame[TRACE_CHECKSUM_POS] = sum;
+}
+
+
+/* [] END OF FILE */
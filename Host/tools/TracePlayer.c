@@ -0,0 +1,179 @@
+/*******************************************************************************
+* File Name: TracePlayer.c
+*
+* Version 1.0
+*
+* Description: Host trace player: replays a recorded sensor trace through the firmware
+*               built with SENSOR_TRACE_REPLAY on the mock hardware, as fast as the host
+*               runs, and prints the UART output and the replay rate.
+*
+*******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "HostMock.h"
+#include "HostLoop.h"
+#include "Timebase.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+
+
+/*******************************************************************************
+*	Local Function Prototypes
+********************************************************************************/
+
+static uint8 *TracePlayer_Load(const char8 path[], uint32 *size);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Replays a trace file. The UART output of the firmware (telemetry, digest)
+*  is written to stdout, the replay rate to stderr.
+*
+*  Usage: TracePlayer <trace file> [--quiet]
+*   --quiet - do not write the UART output
+*
+* Parameters:
+*  argc, argv - command line
+*
+* Return:
+*  int - EXIT_SUCCESS if the trace was replayed
+*
+* Theory:
+*  The trace is fed into the mock UART as fast as its receive buffer accepts
+*  it. Each frame of the main loop waits for a complete trace frame, so the
+*  replay only takes the host time of the firmware and the mocks. The device 
+*  time is the SysTick time of the mock, one USB polling interval per frame.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+	uint8 *trace;
+	uint32 size, position = 0, frames = 0, deviceMs;
+	clock_t start;
+	double hostMs;
+	
+	if((argc < 2) || (argc > 3) || ((argc == 3) && (strcmp(argv[2], "--quiet") != 0)))
+	{
+		fprintf(stderr, "usage: %s <trace file> [--quiet]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	
+	trace = TracePlayer_Load(argv[1], &size);
+	if(trace == NULL)
+	{
+		fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[1]);
+		return EXIT_FAILURE;
+	}
+	
+	/* Echo the output of the initialization too */
+	MockUart_SetEcho((argc == 3) ? NULL : stdout);
+	HostLoop_Init();
+	
+	start = clock();
+	
+	for(;;)
+	{
+		position += MockUart_Receive(&trace[position], size - position);
+		
+		if(HostLoop_Frame())
+		{
+			frames++;
+			
+			/* The output is echoed, do not keep it */
+			MockUart_ClearOutput();
+		}
+		else if(position == size)
+		{
+			/* The rest of the trace is not a complete frame */
+			break;
+		}
+	}
+	
+	hostMs = ((double)(clock() - start) * 1000.0) / CLOCKS_PER_SEC;
+	deviceMs = Timebase_GetMs();
+	
+	fprintf(stderr, "frames %u, device time %u ms, host time %.1f ms, %.0fx real time\n",
+		(unsigned)frames, (unsigned)deviceMs, hostMs, (hostMs > 0.0) ? (deviceMs / hostMs) : 0.0);
+	
+	free(trace);
+	
+	return EXIT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: TracePlayer_Load
+********************************************************************************
+* Summary:
+*  Reads a whole file into memory.
+*
+* Parameters:
+*  path - file name
+*  size - returns the size of the file
+*
+* Return:
+*  uint8 * - contents of the file, to be freed by the caller. NULL if the file
+*            cannot be read.
+*
+*******************************************************************************/
+static uint8 *TracePlayer_Load(const char8 path[], uint32 *size)
+{
+	FILE *file = fopen(path, "rb");
+	uint8 *data = NULL;
+	long length;
+	
+	if(file == NULL)
+	{
+		return NULL;
+	}
+	
+	if((fseek(file, 0, SEEK_END) == 0) && ((length = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+	{
+		data = malloc((size_t)length + 1u);
+		if((data != NULL) && (fread(data, 1u, (size_t)length, file) != (size_t)length))
+		{
+			free(data);
+			data = NULL;
+		}
+		*size = (uint32)length;
+	}
+	
+	(void)fclose(file);
+	
+	return data;
+}
+
+
+/* [] END OF FILE */